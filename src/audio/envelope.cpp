@@ -13,7 +13,8 @@ void Envelope::Reactivate()
 	edge        = 0.0f;
 	frames_done = 0;
 
-	process = &Envelope::Apply;
+	process   = &Envelope::Apply;
+	is_active = true;
 }
 
 void Envelope::Update(const int sample_rate_hz, const int peak_amplitude,
@@ -85,7 +86,8 @@ void Envelope::Apply(const bool is_stereo, AudioFrame& frame)
 
 	// Should we deactivate the envelope?
 	if (++frames_done > expire_after_frames || edge >= edge_limit) {
-		process = &Envelope::Skip;
+		process   = &Envelope::Skip;
+		is_active = false;
 		(void)channel_name; // [[maybe_unused]] in release builds
 		LOG_DEBUG("ENVELOPE: %s done after %u frames, peak sample was %.4f",
 		          channel_name.c_str(),
@@ -5,11 +5,14 @@
 #include "mixer.h"
 
 #include <algorithm>
+#include <bit>
 #include <cinttypes>
 #include <cmath>
+#include <condition_variable>
 #include <cstdint>
 #include <cstring>
 #include <optional>
+#include <span>
 #include <sys/types.h>
 
 #include <speex/speex_resampler.h>
@@ -18,6 +21,7 @@
 #include "tal-chorus/ChorusEngine.h"
 
 #include "private/compressor.h"
+#include "private/sample_ops.h"
 
 #include "capture/capture.h"
 #include "channel_names.h"
@@ -42,6 +46,7 @@
 #include "utils/checks.h"
 #include "utils/math_utils.h"
 #include "utils/rwqueue.h"
+#include "utils/spsc_queue.h"
 #include "utils/string_utils.h"
 
 // must be included after dosbox_config.h
@@ -159,7 +164,7 @@ struct ChorusSettings {
 constexpr auto Minus6db = 0.501f;
 
 struct MixerSettings {
-	RWQueue<AudioFrame> final_output{1};
+	SpscQueue<AudioFrame> final_output{1};
 	RWQueue<int16_t> capture_queue{1};
 
 	std::thread thread = {};
@@ -230,6 +235,34 @@ struct MixerSettings {
 
 	std::atomic<bool> fast_forward_mode = false;
 
+	// Optional pool of worker threads that render the channels
+	// concurrently (`parallel_mixing` setting). Only the channels' `Mix()`
+	// calls run in parallel; the rendered frames are still summed on the
+	// mixer thread in channel order, so the output is identical to the
+	// serial mixer's.
+	struct {
+		int num_threads = 0;
+
+		std::vector<std::thread> threads = {};
+
+		// Everything below is protected by this mutex
+		std::mutex mutex = {};
+
+		std::condition_variable work_available = {};
+		std::condition_variable work_done      = {};
+
+		std::vector<MixerChannel*> jobs = {};
+
+		size_t next_job      = 0;
+		size_t num_pending   = 0;
+		int frames_requested = 0;
+
+		// Incremented for every new batch of jobs to wake up the workers
+		uint64_t round = 0;
+
+		bool should_quit = false;
+	} workers = {};
+
 	std::recursive_mutex mutex = {};
 };
 
@@ -1221,6 +1254,8 @@ void MixerChannel::Mix(const int frames_requested)
 
 	frames_needed = frames_requested;
 
+	const auto start_us = GetTicksUs();
+
 	while (frames_needed > audio_frames.size()) {
 		std::unique_lock lock(mutex);
 
@@ -1239,6 +1274,40 @@ void MixerChannel::Mix(const int frames_requested)
 		lock.unlock();
 		handler(frames_remaining);
 	}
+
+	const auto elapsed_us = GetTicksUsSince(start_us);
+
+	render_timings.total_us += elapsed_us;
+	render_timings.num_frames += frames_requested;
+	++render_timings.num_blocks;
+
+	if (elapsed_us > render_timings.peak_us) {
+		render_timings.peak_us = elapsed_us;
+	}
+}
+
+MixerChannel::RenderTimings MixerChannel::GetRenderTimings()
+{
+	RenderTimings timings = {};
+
+	timings.num_blocks = render_timings.num_blocks;
+	if (timings.num_blocks == 0) {
+		return timings;
+	}
+
+	const auto total_us = render_timings.total_us.load();
+
+	timings.average_us = total_us / timings.num_blocks;
+	timings.peak_us    = render_timings.peak_us;
+
+	const auto rendered_us = static_cast<double>(render_timings.num_frames) *
+	                         MillisInSecond * MicrosInMillisecond /
+	                         mixer.sample_rate_hz;
+	if (rendered_us > 0.0) {
+		timings.load_percent = static_cast<float>(
+		        static_cast<double>(total_us) * 100.0 / rendered_us);
+	}
+	return timings;
 }
 
 void MixerChannel::AddSilence()
@@ -1793,106 +1862,56 @@ static constexpr void fill_8to16_lut()
 	}
 }
 
-// clang-format off
+// Converts a block of samples to float frames in the signed 16-bit range. The
+// right channel of mono frames is set to `mono_right`.
 template <class Type, bool stereo, bool signeddata, bool nativeorder>
-AudioFrame MixerChannel::ConvertNextFrame(const Type* data, const int pos)
+static void decode_samples(const Type* data, const int num_frames,
+                           AudioFrame* dest, const float mono_right,
+                           std::vector<float>& mono_buffer)
 {
-	assert(pos >= 0);
+	const auto num_samples = check_cast<size_t>(stereo ? num_frames * 2
+	                                                   : num_frames);
 
-	AudioFrame frame = {};
+	// Stereo samples are decoded straight into the frames; mono samples
+	// are interleaved as the last step.
+	const float* mono_samples = nullptr;
 
-	const auto left_pos  = pos * 2 + 0;
-	const auto right_pos = pos * 2 + 1;
+	auto samples = reinterpret_cast<float*>(dest);
+	if (!stereo && !std::is_same_v<Type, float>) {
+		mono_buffer.resize(num_samples);
+		samples      = mono_buffer.data();
+		mono_samples = samples;
+	}
 
-	if (sizeof(Type) == 1) {
-		// Integer types
-		// unsigned 8-bit
-		if (!signeddata) {
-			if (stereo) {
-				frame.left  = lut_u8to16[static_cast<uint8_t>(data[left_pos])];
-				frame.right = lut_u8to16[static_cast<uint8_t>(data[right_pos])];
-			} else {
-				frame.left  = lut_u8to16[static_cast<uint8_t>(data[pos])];
-			}
-		}
-		// signed 8-bit
-		else {
-			if (stereo) {
-				frame.left  = lut_s8to16[static_cast<int8_t>(data[left_pos])];
-				frame.right = lut_s8to16[static_cast<int8_t>(data[right_pos])];
-			} else {
-				frame.left  = lut_s8to16[static_cast<int8_t>(data[pos])];
-			}
+	if constexpr (std::is_same_v<Type, float>) {
+		if (stereo) {
+			std::copy_n(data, num_samples, samples);
+		} else {
+			mono_samples = data;
 		}
+	} else if constexpr (std::is_same_v<Type, uint8_t>) {
+		static_assert(!signeddata, "Only unsigned 8-bit data is supported");
+		convert_u8_to_float(data, samples, num_samples);
+
 	} else {
-		// 16-bit and 32-bit both contain 16-bit data internally
-		if (signeddata) {
-			if (stereo) {
-				if (nativeorder) {
-					frame.left  = static_cast<float>(data[left_pos]);
-					frame.right = static_cast<float>(data[right_pos]);
-				} else {
-					auto host_pt0 = reinterpret_cast<const uint8_t* const>(data + left_pos);
-					auto host_pt1 = reinterpret_cast<const uint8_t* const>(data + right_pos);
-
-					if (sizeof(Type) == 2) {
-						frame.left  = (int16_t)host_readw(host_pt0);
-						frame.right = (int16_t)host_readw(host_pt1);
-					} else {
-						frame.left  = static_cast<float>((int32_t)host_readd(host_pt0));
-						frame.right = static_cast<float>((int32_t)host_readd(host_pt1));
-					}
-				}
-			} else { // mono
-				if (nativeorder) {
-					frame.left = static_cast<float>(data[pos]);
-				} else {
-					auto host_pt = reinterpret_cast<const uint8_t* const>(data + pos);
-
-					if (sizeof(Type) == 2) {
-						frame.left = (int16_t)host_readw(host_pt);
-					} else {
-						frame.left = static_cast<float>((int32_t)host_readd(host_pt));
-					}
-				}
-			}
-		} else { // unsigned
-			const auto offs = 32768;
-			if (stereo) {
-				if (nativeorder) {
-					frame.left = static_cast<float>(static_cast<int>(data[left_pos]) - offs);
-
-					frame.right = static_cast<float>(static_cast<int>(data[right_pos]) - offs);
-				} else {
-					auto host_pt0 = reinterpret_cast<const uint8_t* const>(data + left_pos);
-					auto host_pt1 = reinterpret_cast<const uint8_t* const>(data + right_pos);
-
-					if (sizeof(Type) == 2) {
-						frame.left  = static_cast<float>(static_cast<int>(host_readw(host_pt0)) - offs);
-						frame.right = static_cast<float>(static_cast<int>(host_readw(host_pt1)) - offs);
-					} else {
-						frame.left  = static_cast<float>(static_cast<int>(host_readd(host_pt0)) - offs);
-						frame.right = static_cast<float>(static_cast<int>(host_readd(host_pt1)) - offs);
-					}
-				}
-			} else { // mono
-				if (nativeorder) {
-					frame.left = static_cast<float>(static_cast<int>(data[pos]) - offs);
-				} else {
-					auto host_pt = reinterpret_cast<const uint8_t* const>(data + pos);
-
-					if (sizeof(Type) == 2) {
-						frame.left = static_cast<float>(static_cast<int>(host_readw(host_pt)) - offs);
-					} else {
-						frame.left = static_cast<float>(static_cast<int>(host_readd(host_pt)) - offs);
-					}
-				}
-			}
+		static_assert(std::is_same_v<Type, int16_t> && signeddata,
+		              "Unsupported sample type");
+
+		// Non-native order data is stored in little-endian byte order
+		if (nativeorder || std::endian::native == std::endian::little) {
+			convert_s16_to_float(data, samples, num_samples);
+		} else {
+			convert_s16_byteswapped_to_float(data, samples, num_samples);
 		}
 	}
-	return frame;
+
+	if (!stereo) {
+		interleave_mono(mono_samples,
+		                dest,
+		                check_cast<size_t>(num_frames),
+		                mono_right);
+	}
 }
-// clang-format on
 
 // Converts sample stream to floats, performs output channel mappings, removes
 // clicks, and optionally performs zero-order-hold-upsampling.
@@ -1903,61 +1922,58 @@ void MixerChannel::ConvertSamplesAndMaybeZohUpsample(const Type* data,
 	assert(num_frames > 0);
 	convert_buffer.clear();
 
-	const auto mapped_output_left  = output_map.left;
-	const auto mapped_output_right = output_map.right;
-
-	const auto mapped_channel_left  = channel_map.left;
-	const auto mapped_channel_right = channel_map.right;
+	// Mono float samples only ever set the left channel of the frame, the
+	// integer conversions zero the right channel
+	const auto mono_right = std::is_same_v<Type, float> ? next_frame.right
+	                                                    : 0.0f;
 
-	auto pos = 0;
+	// The output lags the input by one frame; this is what the previous
+	// frame is kept around for
+	if (do_zoh_upsample) {
+		decode_buffer.resize(check_cast<size_t>(num_frames));
+		decode_samples<Type, stereo, signeddata, nativeorder>(
+		        data, num_frames, decode_buffer.data(), mono_right, mono_buffer);
 
-	while (pos < num_frames) {
-		prev_frame = next_frame;
+		auto pos = 0;
+		while (pos < num_frames) {
+			prev_frame = next_frame;
+			next_frame = decode_buffer[check_cast<size_t>(pos)];
 
-		if (std::is_same<Type, float>::value) {
-			if (stereo) {
-				next_frame.left = static_cast<float>(
-				        data[pos * 2 + 0]);
+			convert_buffer.push_back(prev_frame);
 
-				next_frame.right = static_cast<float>(
-				        data[pos * 2 + 1]);
-			} else {
-				next_frame.left = static_cast<float>(data[pos]);
+			zoh_upsampler.pos += zoh_upsampler.step;
+			if (zoh_upsampler.pos > 1.0f) {
+				zoh_upsampler.pos -= 1.0f;
+				++pos;
 			}
-		} else {
-			next_frame = ConvertNextFrame<Type, stereo, signeddata, nativeorder>(
-			        data, pos);
 		}
+	} else {
+		convert_buffer.resize(check_cast<size_t>(num_frames) + 1);
+		convert_buffer.front() = next_frame;
 
-		AudioFrame frame_with_gain = {};
-		if (stereo) {
-			frame_with_gain = {prev_frame[mapped_channel_left],
-			                   prev_frame[mapped_channel_right]};
-		} else {
-			frame_with_gain = {prev_frame[mapped_channel_left]};
-		}
-		frame_with_gain *= combined_volume_gain;
-
-		// Process initial samples through an expanding envelope to
-		// prevent severe clicks and pops. Becomes a no-op when done.
-		envelope.Process(stereo, frame_with_gain);
+		decode_samples<Type, stereo, signeddata, nativeorder>(
+		        data, num_frames, &convert_buffer[1], mono_right, mono_buffer);
 
-		AudioFrame out_frame = {};
-		out_frame[mapped_output_left] += frame_with_gain.left;
-		out_frame[mapped_output_right] += frame_with_gain.right;
+		next_frame = convert_buffer.back();
+		convert_buffer.pop_back();
+		prev_frame = convert_buffer.back();
+	}
 
-		convert_buffer.push_back(out_frame);
+	// Mono channels only use the mapped left channel
+	apply_channel_map_and_gain(convert_buffer,
+	                           channel_map.left,
+	                           stereo ? channel_map.right : channel_map.left,
+	                           combined_volume_gain);
 
-		if (do_zoh_upsample) {
-			zoh_upsampler.pos += zoh_upsampler.step;
-			if (zoh_upsampler.pos > 1.0f) {
-				zoh_upsampler.pos -= 1.0f;
-				++pos;
-			}
-		} else {
-			++pos;
+	// Process initial samples through an expanding envelope to prevent
+	// severe clicks and pops. Becomes a no-op when done.
+	if (envelope.IsActive()) {
+		for (auto& frame : convert_buffer) {
+			envelope.Process(stereo, frame);
 		}
 	}
+
+	apply_lineout_map(convert_buffer, output_map.left, output_map.right);
 }
 
 static spx_uint32_t estimate_max_out_frames(SpeexResamplerState* resampler_state,
@@ -1974,18 +1990,6 @@ static spx_uint32_t estimate_max_out_frames(SpeexResamplerState* resampler_state
 	return ceil_udivide(in_frames * ratio_den, ratio_num);
 }
 
-AudioFrame MixerChannel::ApplyCrossfeed(const AudioFrame frame)
-{
-	// Pan mono sample using -6dB linear pan law in the stereo field
-	// pan: 0.0 = left, 0.5 = center, 1.0 = right
-	auto pan = [](const float sample, const float pan) -> AudioFrame {
-		return {(1.0f - pan) * sample, pan * sample};
-	};
-	const auto a = pan(frame.left, crossfeed.pan_left);
-	const auto b = pan(frame.right, crossfeed.pan_right);
-	return {a.left + b.left, a.right + b.right};
-}
-
 // Returns true if configuration succeeded and false otherwise
 bool MixerChannel::ConfigureFadeOut(const std::string& prefs)
 {
@@ -2153,6 +2157,22 @@ bool MixerChannel::WakeUp()
 	return sleeper.WakeUp();
 }
 
+// The filters are recursive, so they can't process several frames at once.
+// Running each channel through its filter cascade over the whole buffer keeps
+// the filter state in registers and gives the same results as filtering the
+// frames one by one.
+template <class Filter>
+static void apply_filters(std::array<Filter, 2>& filters,
+                          const std::span<AudioFrame> frames)
+{
+	for (auto& frame : frames) {
+		frame.left = filters[0].filter(frame.left);
+	}
+	for (auto& frame : frames) {
+		frame.right = filters[1].filter(frame.right);
+	}
+}
+
 template <class Type, bool stereo, bool signeddata, bool nativeorder>
 void MixerChannel::AddSamples(const int num_frames, const Type* data)
 {
@@ -2271,29 +2291,25 @@ void MixerChannel::AddSamples(const int num_frames, const Type* data)
 	}
 
 	// Optionally gate, filter, and apply crossfeed.
-	// Runs in-place over newly added frames.
-	for (size_t i = audio_frames_starting_size; i < audio_frames.size(); ++i) {
-		if (do_noise_gate) {
-			audio_frames[i] = noise_gate.processor.Process(
-			        audio_frames[i]);
-		}
-
-		if (filters.highpass.state == FilterState::On) {
-			auto& hpf = filters.highpass.hpf;
+	// Runs in-place over newly added frames, one stage at a time.
+	const auto new_frames = std::span(audio_frames).subspan(
+	        audio_frames_starting_size);
 
-			audio_frames[i] = {hpf[0].filter(audio_frames[i].left),
-			                   hpf[1].filter(audio_frames[i].right)};
+	if (do_noise_gate) {
+		for (auto& frame : new_frames) {
+			frame = noise_gate.processor.Process(frame);
 		}
-		if (filters.lowpass.state == FilterState::On) {
-			auto& lpf = filters.lowpass.lpf;
+	}
 
-			audio_frames[i] = {lpf[0].filter(audio_frames[i].left),
-			                   lpf[1].filter(audio_frames[i].right)};
-		}
+	if (filters.highpass.state == FilterState::On) {
+		apply_filters(filters.highpass.hpf, new_frames);
+	}
+	if (filters.lowpass.state == FilterState::On) {
+		apply_filters(filters.lowpass.lpf, new_frames);
+	}
 
-		if (do_crossfeed) {
-			audio_frames[i] = ApplyCrossfeed(audio_frames[i]);
-		}
+	if (do_crossfeed) {
+		apply_crossfeed(new_frames, crossfeed.pan_left, crossfeed.pan_right);
 	}
 }
 
@@ -2420,6 +2436,142 @@ static float normalize_sample(float sample)
 	return sample / 32768.0f;
 }
 
+// Most channels spend a good chunk of their time waiting on their device, so a
+// few threads are plenty even with many channels active
+constexpr auto MaxMixerWorkerThreads = 3;
+
+// Claims and renders channels from the current batch of jobs until there are
+// none left. Called by both the mixer thread and the worker threads with the
+// workers' mutex held.
+static void render_pending_channels(std::unique_lock<std::mutex>& lock)
+{
+	auto& workers = mixer.workers;
+
+	while (workers.next_job < workers.jobs.size()) {
+		const auto channel = workers.jobs[workers.next_job++];
+		const auto frames_requested = workers.frames_requested;
+
+		lock.unlock();
+		channel->Mix(frames_requested);
+		lock.lock();
+
+		assert(workers.num_pending > 0);
+		if (--workers.num_pending == 0) {
+			workers.work_done.notify_all();
+		}
+	}
+}
+
+static void mixer_worker_thread_loop()
+{
+	auto& workers = mixer.workers;
+
+	std::unique_lock lock(workers.mutex);
+	auto last_round = workers.round;
+
+	while (true) {
+		workers.work_available.wait(lock, [&] {
+			return workers.should_quit || workers.round != last_round;
+		});
+		if (workers.should_quit) {
+			return;
+		}
+		last_round = workers.round;
+
+		render_pending_channels(lock);
+	}
+}
+
+static void shutdown_mixer_worker_threads()
+{
+	auto& workers = mixer.workers;
+	{
+		std::lock_guard lock(workers.mutex);
+		workers.should_quit = true;
+	}
+	workers.work_available.notify_all();
+
+	for (auto& thread : workers.threads) {
+		if (thread.joinable()) {
+			thread.join();
+		}
+	}
+	workers.threads.clear();
+	workers.should_quit = false;
+}
+
+// Must be called with the mixer thread locked
+static void set_parallel_mixing(const bool enabled)
+{
+	shutdown_mixer_worker_threads();
+
+	auto num_threads = 0;
+	if (enabled) {
+		// Leave a core each for the emulation and the mixer threads
+		const auto num_cores = static_cast<int>(
+		        std::thread::hardware_concurrency());
+
+		num_threads = std::clamp(num_cores - 2, 0, MaxMixerWorkerThreads);
+		if (num_threads == 0) {
+			LOG_WARNING(
+			        "MIXER: Not enough CPU cores for parallel mixing, "
+			        "rendering the channels serially");
+		} else {
+			LOG_MSG("MIXER: Rendering the channels on %d worker threads",
+			        num_threads);
+		}
+	}
+	mixer.workers.num_threads = num_threads;
+}
+
+// Renders the audio of all channels into their `audio_frames` buffers, either
+// serially on the mixer thread, or in parallel on the worker threads
+static void mix_channels(const int frames_requested)
+{
+	auto& workers = mixer.workers;
+
+	// The worker threads are only spun up once on first use
+	if (workers.num_threads > 0 && workers.threads.empty()) {
+		workers.threads.resize(static_cast<size_t>(workers.num_threads));
+		for (auto& thread : workers.threads) {
+			thread = std::thread(mixer_worker_thread_loop);
+			set_thread_name(thread, "dosbox:mixwork");
+		}
+	}
+
+	std::unique_lock lock(workers.mutex);
+
+	workers.jobs.clear();
+	for (const auto& [_, channel] : mixer.channels) {
+		if (channel->is_enabled) {
+			workers.jobs.push_back(channel.get());
+		}
+	}
+
+	if (workers.num_threads == 0 || workers.jobs.size() < 2) {
+		// Make sure the worker threads can't claim any of these
+		workers.next_job = workers.jobs.size();
+		lock.unlock();
+
+		for (const auto channel : workers.jobs) {
+			channel->Mix(frames_requested);
+		}
+		return;
+	}
+
+	workers.next_job         = 0;
+	workers.num_pending      = workers.jobs.size();
+	workers.frames_requested = frames_requested;
+	++workers.round;
+
+	workers.work_available.notify_all();
+
+	// The mixer thread renders channels too instead of just waiting
+	render_pending_channels(lock);
+
+	workers.work_done.wait(lock, [&] { return workers.num_pending == 0; });
+}
+
 // Mix a certain amount of new sample frames
 static void mix_samples(const int frames_requested)
 {
@@ -2434,10 +2586,10 @@ static void mix_samples(const int frames_requested)
 	mixer.chorus_aux_buffer.clear();
 	mixer.chorus_aux_buffer.resize(frames_requested);
 
-	// Render all channels and accumulate results in the master mixbuffer
-	for (const auto& [_, channel] : mixer.channels) {
-		channel->Mix(frames_requested);
+	mix_channels(frames_requested);
 
+	// Accumulate the rendered channels in the master mixbuffer
+	for (const auto& [_, channel] : mixer.channels) {
 		std::lock_guard lock(channel->mutex);
 
 		const size_t num_frames = std::min(mixer.output_buffer.size(),
@@ -2513,10 +2665,8 @@ static void mix_samples(const int frames_requested)
 	}
 
 	// Apply master gain
-	const auto gain = mixer.master_gain.load(std::memory_order_relaxed);
-	for (auto& frame : mixer.output_buffer) {
-		frame *= gain;
-	}
+	apply_gain(mixer.output_buffer,
+	           mixer.master_gain.load(std::memory_order_relaxed));
 
 	if (mixer.do_compressor) {
 		// Apply compressor to the master output as the very last step
@@ -3027,6 +3177,8 @@ void MIXER_CloseAudioDevice()
 		mixer.thread.join();
 	}
 
+	shutdown_mixer_worker_threads();
+
 	for (const auto& [_, channel] : mixer.channels) {
 		channel->Enable(false);
 	}
@@ -3250,18 +3402,7 @@ void MIXER_Init()
 		set_no_sound();
 
 	} else {
-		if (init_sdl_sound(sample_rate, blocksize)) {
-
-			mixer.final_output.Start();
-
-			// The stream becomes live (unpaused) during the SDL_BindAudioStream() call.
-			// It will play silence until we start the callback here and start feeding it audio.
-			// We never use SDL's pause feature. Instead we write silence when we mute the audio.
-			SDL_SetAudioStreamGetCallback(mixer.sdl_stream, mixer_callback, nullptr);
-
-			// `mute_state` defaults to Audible and `paused`
-			// defaults to false; nothing more to set here.
-		} else {
+		if (!init_sdl_sound(sample_rate, blocksize)) {
 			set_no_sound();
 		}
 	}
@@ -3272,8 +3413,22 @@ void MIXER_Init()
 	const auto prebuffer_frames = (mixer.sample_rate_hz * mixer.prebuffer_ms) /
 	                              1000;
 
+	// The lock-free queue can only be resized while the SDL callback isn't
+	// consuming it yet
 	mixer.final_output.Resize(mixer.blocksize + prebuffer_frames);
 
+	if (mixer.sdl_stream != nullptr) {
+		mixer.final_output.Start();
+
+		// The stream becomes live (unpaused) during the SDL_BindAudioStream() call.
+		// It will play silence until we start the callback here and start feeding it audio.
+		// We never use SDL's pause feature. Instead we write silence when we mute the audio.
+		SDL_SetAudioStreamGetCallback(mixer.sdl_stream, mixer_callback, nullptr);
+
+		// `mute_state` defaults to Audible and `paused`
+		// defaults to false; nothing more to set here.
+	}
+
 	// One second of audio
 	mixer.capture_queue.Resize(mixer.sample_rate_hz * 2);
 
@@ -3308,6 +3463,8 @@ void MIXER_Init()
 
 	MIXER_SetCrossfeedPreset(new_crossfeed_preset);
 
+	set_parallel_mixing(section->GetBool("parallel_mixing"));
+
 	MIXER_UnlockMixerThread();
 }
 
@@ -3343,6 +3500,9 @@ static void notify_mixer_setting_updated(SectionProp& section,
 	} else if (prop_name == "denoiser") {
 		init_denoiser(section.GetBool("denoiser"));
 
+	} else if (prop_name == "parallel_mixing") {
+		set_parallel_mixing(section.GetBool("parallel_mixing"));
+
 	} else if (prop_name == "reverb") {
 		const auto new_reverb_preset = reverb_pref_to_preset(
 		        section.GetString("reverb"));
@@ -3529,6 +3689,16 @@ static void init_mixer_config_settings(SectionProp& sec_prop)
 	        "        The denoiser does not introduce any sound quality degradation; it only\n"
 	        "        removes the barely audible residual noise in quiet passages.");
 
+	bool_prop = sec_prop.AddBool("parallel_mixing", WhenIdle, false);
+	bool_prop->SetHelp(
+	        "Render the audio of the mixer channels concurrently on a small pool of worker\n"
+	        "threads ('off' by default). This can help with sound stuttering on multi-core\n"
+	        "systems when several demanding audio devices are active at the same time\n"
+	        "(e.g., OPL, Gravis UltraSound, and Roland MT-32). The audio output is the same\n"
+	        "in both modes.\n"
+	        "\n"
+	        "Note: Run 'MIXER /TIMING' to see how long each channel takes to render.");
+
 	MAPPER_AddHandler(handle_toggle_mute, SDL_SCANCODE_F8, PRIMARY_MOD, "mute", "Mute");
 }
 
@@ -244,6 +244,19 @@ public:
 	void SetPeakAmplitude(const int peak);
 	void Mix(const int frames_requested);
 
+	// Time spent in `Mix()` rendering the channel's audio, as shown by the
+	// MIXER command
+	struct RenderTimings {
+		int num_blocks     = 0;
+		int64_t average_us = 0;
+		int64_t peak_us    = 0;
+
+		// The rendering time relative to the duration of the rendered
+		// audio; anything approaching 100% will cause underruns
+		float load_percent = 0.0f;
+	};
+	RenderTimings GetRenderTimings();
+
 	MixerChannelSettings GetSettings();
 	void SetSettings(const MixerChannelSettings& s);
 
@@ -357,9 +370,6 @@ private:
 	MixerChannel()                    = delete;
 	MixerChannel(const MixerChannel&) = delete;
 
-	template <class Type, bool stereo, bool signeddata, bool nativeorder>
-	AudioFrame ConvertNextFrame(const Type* data, const int pos);
-
 	template <class Type, bool stereo, bool signeddata, bool nativeorder>
 	void ConvertSamplesAndMaybeZohUpsample(const Type* data, const int frames);
 
@@ -373,19 +383,30 @@ private:
 	void InitZohUpsamplerState();
 	void InitLerpUpsamplerState();
 
-	AudioFrame ApplyCrossfeed(const AudioFrame frame);
-
 	std::string name = {};
 	Envelope envelope;
 	MIXER_Handler handler = nullptr;
 
 	std::vector<AudioFrame> convert_buffer = {};
 
+	// Scratch buffers for decoding the samples passed to AddSamples()
+	std::vector<AudioFrame> decode_buffer = {};
+	std::vector<float> mono_buffer        = {};
+
 	std::set<ChannelFeature> features = {};
 
 	// Timing on how many samples were needed by the mixer
 	size_t frames_needed = 0;
 
+	// Updated by `Mix()` on the mixer or the mixer worker threads, read by
+	// the MIXER command on the main thread
+	struct {
+		std::atomic<int64_t> total_us   = 0;
+		std::atomic<int64_t> peak_us    = 0;
+		std::atomic<int64_t> num_frames = 0;
+		std::atomic<int> num_blocks     = 0;
+	} render_timings = {};
+
 	// Previous and next sample fames
 	AudioFrame prev_frame = {};
 	AudioFrame next_frame = {};
@@ -56,6 +56,13 @@ public:
 
 	void Reactivate();
 
+	// False once the envelope has gone dormant; callers processing whole
+	// buffers can skip calling Process() for every frame
+	bool IsActive() const
+	{
+		return is_active;
+	}
+
 	// prevent copying
 	Envelope(const Envelope&) = delete;
 
@@ -91,6 +98,8 @@ private:
 
 	// Stop enveloping when the current edge is hits or exceeds this limit.
 	float edge_limit = 0.0f;
+
+	bool is_active = true;
 };
 
 #endif
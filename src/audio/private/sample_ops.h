@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef DOSBOX_SAMPLE_OPS_H
+#define DOSBOX_SAMPLE_OPS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "audio/audio_frame.h"
+
+// Block-based sample conversion and processing kernels used by the mixer
+// channels. They're vectorised with SIMDe, so they use SSE2 on x86 and NEON
+// on ARM, and fall back to portable scalar code elsewhere.
+//
+// The results are identical to processing the samples one frame at a time
+// with the equivalent scalar code.
+
+// The integer conversions output floats in the signed 16-bit range.
+//
+// Unsigned 8-bit samples are scaled so 0 maps to -32768 and 255 to 32767.
+void convert_u8_to_float(const uint8_t* src, float* dest, size_t num_samples);
+
+void convert_s16_to_float(const int16_t* src, float* dest, size_t num_samples);
+
+// Signed 16-bit samples stored in the opposite byte order of the host's
+void convert_s16_byteswapped_to_float(const int16_t* src, float* dest,
+                                      size_t num_samples);
+
+// Mono samples to frames; the right channel of every frame gets set to
+// `right`
+void interleave_mono(const float* src, AudioFrame* dest, size_t num_frames,
+                     float right);
+
+// Picks the left and right channels of every frame from the given source
+// channels (0 = left, 1 = right), then applies the gain
+void apply_channel_map_and_gain(std::span<AudioFrame> frames,
+                                size_t left_source, size_t right_source,
+                                AudioFrame gain);
+
+// Sends the left and right channels of every frame to the given output
+// lines (0 = left, 1 = right); channels sent to the same line are summed
+void apply_lineout_map(std::span<AudioFrame> frames, size_t left_dest,
+                       size_t right_dest);
+
+void apply_gain(std::span<AudioFrame> frames, AudioFrame gain);
+
+// Pans the left and right channels in the stereo field using the -6dB linear
+// pan law (0.0 = left, 0.5 = center, 1.0 = right)
+void apply_crossfeed(std::span<AudioFrame> frames, float pan_left,
+                     float pan_right);
+
+#endif // DOSBOX_SAMPLE_OPS_H
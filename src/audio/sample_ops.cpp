@@ -0,0 +1,270 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "private/sample_ops.h"
+
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+#include "simde/x86/sse2.h"
+
+#include "utils/checks.h"
+
+CHECK_NARROWING();
+
+static simde__m128i load_si128(const void* p)
+{
+	return simde_mm_loadu_si128(static_cast<const simde__m128i*>(p));
+}
+
+static simde__m128 load_ps(const AudioFrame* frames)
+{
+	return simde_mm_loadu_ps(&frames->left);
+}
+
+static void store_ps(AudioFrame* frames, const simde__m128 v)
+{
+	simde_mm_storeu_ps(&frames->left, v);
+}
+
+// Two frames' worth of the same left/right pair
+static simde__m128 set_frame_pair(const float left, const float right)
+{
+	return simde_mm_setr_ps(left, right, left, right);
+}
+
+// Sign-extends and converts eight signed 16-bit samples
+static void store_s16x8_as_float(const simde__m128i v, float* dest)
+{
+	const auto lo = simde_mm_srai_epi32(simde_mm_unpacklo_epi16(v, v), 16);
+	const auto hi = simde_mm_srai_epi32(simde_mm_unpackhi_epi16(v, v), 16);
+
+	simde_mm_storeu_ps(dest, simde_mm_cvtepi32_ps(lo));
+	simde_mm_storeu_ps(dest + 4, simde_mm_cvtepi32_ps(hi));
+}
+
+static float u8_to_float(const uint8_t u_val)
+{
+	const auto s_val = u_val - 128;
+	if (s_val > 0) {
+		constexpr auto Scalar = INT16_MAX / 127.0;
+		return static_cast<float>(std::round(s_val * Scalar));
+	}
+	return static_cast<float>(s_val * 256);
+}
+
+// Positive samples are scaled by 32767 / 127 and rounded; as the result is
+// never exactly halfway between two integers, rounding in single precision
+// gives the same results as the scalar double-precision formula.
+static simde__m128 u8x4_to_float(const simde__m128i s32)
+{
+	const auto f = simde_mm_cvtepi32_ps(s32);
+
+	const auto positive = simde_mm_cvtepi32_ps(simde_mm_cvtps_epi32(
+	        simde_mm_mul_ps(f, simde_mm_set1_ps(INT16_MAX / 127.0f))));
+
+	const auto negative = simde_mm_mul_ps(f, simde_mm_set1_ps(256.0f));
+
+	const auto is_positive = simde_mm_cmpgt_ps(f, simde_mm_setzero_ps());
+
+	return simde_mm_or_ps(simde_mm_and_ps(is_positive, positive),
+	                      simde_mm_andnot_ps(is_positive, negative));
+}
+
+void convert_u8_to_float(const uint8_t* src, float* dest, const size_t num_samples)
+{
+	const auto zero = simde_mm_setzero_si128();
+	const auto bias = simde_mm_set1_epi16(128);
+
+	size_t i = 0;
+	for (; i + 16 <= num_samples; i += 16) {
+		const auto v = load_si128(src + i);
+
+		for (auto half = 0; half < 2; ++half) {
+			const auto u16 = (half == 0) ? simde_mm_unpacklo_epi8(v, zero)
+			                             : simde_mm_unpackhi_epi8(v, zero);
+
+			const auto s16 = simde_mm_sub_epi16(u16, bias);
+
+			const auto lo = simde_mm_srai_epi32(
+			        simde_mm_unpacklo_epi16(s16, s16), 16);
+			const auto hi = simde_mm_srai_epi32(
+			        simde_mm_unpackhi_epi16(s16, s16), 16);
+
+			auto out = dest + i + static_cast<size_t>(half) * 8;
+			simde_mm_storeu_ps(out, u8x4_to_float(lo));
+			simde_mm_storeu_ps(out + 4, u8x4_to_float(hi));
+		}
+	}
+	for (; i < num_samples; ++i) {
+		dest[i] = u8_to_float(src[i]);
+	}
+}
+
+void convert_s16_to_float(const int16_t* src, float* dest, const size_t num_samples)
+{
+	size_t i = 0;
+	for (; i + 8 <= num_samples; i += 8) {
+		store_s16x8_as_float(load_si128(src + i), dest + i);
+	}
+	for (; i < num_samples; ++i) {
+		dest[i] = static_cast<float>(src[i]);
+	}
+}
+
+void convert_s16_byteswapped_to_float(const int16_t* src, float* dest,
+                                      const size_t num_samples)
+{
+	size_t i = 0;
+	for (; i + 8 <= num_samples; i += 8) {
+		const auto v = load_si128(src + i);
+
+		const auto swapped = simde_mm_or_si128(simde_mm_slli_epi16(v, 8),
+		                                       simde_mm_srli_epi16(v, 8));
+
+		store_s16x8_as_float(swapped, dest + i);
+	}
+	for (; i < num_samples; ++i) {
+		const auto u_val = static_cast<uint16_t>(src[i]);
+		const auto swapped = static_cast<uint16_t>((u_val << 8) | (u_val >> 8));
+
+		dest[i] = static_cast<float>(static_cast<int16_t>(swapped));
+	}
+}
+
+void interleave_mono(const float* src, AudioFrame* dest,
+                     const size_t num_frames, const float right)
+{
+	const auto r = simde_mm_set1_ps(right);
+
+	size_t i = 0;
+	for (; i + 4 <= num_frames; i += 4) {
+		const auto v = simde_mm_loadu_ps(src + i);
+
+		store_ps(dest + i, simde_mm_unpacklo_ps(v, r));
+		store_ps(dest + i + 2, simde_mm_unpackhi_ps(v, r));
+	}
+	for (; i < num_frames; ++i) {
+		dest[i] = {src[i], right};
+	}
+}
+
+// `Shuffle` picks the channels of both frames in a vector
+template <int Shuffle>
+static void map_and_scale(std::span<AudioFrame> frames, const size_t left_source,
+                          const size_t right_source, const AudioFrame gain)
+{
+	const auto g = set_frame_pair(gain.left, gain.right);
+
+	size_t i = 0;
+	for (; i + 2 <= frames.size(); i += 2) {
+		const auto v = load_ps(&frames[i]);
+		store_ps(&frames[i],
+		         simde_mm_mul_ps(simde_mm_shuffle_ps(v, v, Shuffle), g));
+	}
+	for (; i < frames.size(); ++i) {
+		const auto frame = frames[i];
+		frames[i] = {frame[left_source] * gain.left,
+		             frame[right_source] * gain.right};
+	}
+}
+
+void apply_channel_map_and_gain(std::span<AudioFrame> frames,
+                                const size_t left_source,
+                                const size_t right_source, const AudioFrame gain)
+{
+	assert(left_source < 2 && right_source < 2);
+
+	// clang-format off
+	switch (left_source * 2 + right_source) {
+	case 0: map_and_scale<SIMDE_MM_SHUFFLE(2, 2, 0, 0)>(frames, 0, 0, gain); break;
+	case 1: map_and_scale<SIMDE_MM_SHUFFLE(3, 2, 1, 0)>(frames, 0, 1, gain); break;
+	case 2: map_and_scale<SIMDE_MM_SHUFFLE(2, 3, 0, 1)>(frames, 1, 0, gain); break;
+	case 3: map_and_scale<SIMDE_MM_SHUFFLE(3, 3, 1, 1)>(frames, 1, 1, gain); break;
+	}
+	// clang-format on
+}
+
+void apply_lineout_map(std::span<AudioFrame> frames, const size_t left_dest,
+                       const size_t right_dest)
+{
+	assert(left_dest < 2 && right_dest < 2);
+
+	if (left_dest == 0 && right_dest == 1) {
+		return;
+	}
+
+	size_t i = 0;
+
+	if (left_dest == 1 && right_dest == 0) {
+		for (; i + 2 <= frames.size(); i += 2) {
+			const auto v = load_ps(&frames[i]);
+			store_ps(&frames[i],
+			         simde_mm_shuffle_ps(v, v, SIMDE_MM_SHUFFLE(2, 3, 0, 1)));
+		}
+	} else {
+		// Both channels go to the same line
+		const auto keep = simde_mm_castsi128_ps(
+		        (left_dest == 0) ? simde_mm_setr_epi32(-1, 0, -1, 0)
+		                         : simde_mm_setr_epi32(0, -1, 0, -1));
+
+		for (; i + 2 <= frames.size(); i += 2) {
+			const auto v = load_ps(&frames[i]);
+			const auto swapped = simde_mm_shuffle_ps(
+			        v, v, SIMDE_MM_SHUFFLE(2, 3, 0, 1));
+
+			store_ps(&frames[i],
+			         simde_mm_and_ps(simde_mm_add_ps(v, swapped), keep));
+		}
+	}
+
+	for (; i < frames.size(); ++i) {
+		const auto frame = frames[i];
+
+		AudioFrame out_frame = {};
+		out_frame[left_dest] += frame.left;
+		out_frame[right_dest] += frame.right;
+
+		frames[i] = out_frame;
+	}
+}
+
+void apply_gain(std::span<AudioFrame> frames, const AudioFrame gain)
+{
+	const auto g = set_frame_pair(gain.left, gain.right);
+
+	size_t i = 0;
+	for (; i + 2 <= frames.size(); i += 2) {
+		store_ps(&frames[i], simde_mm_mul_ps(load_ps(&frames[i]), g));
+	}
+	for (; i < frames.size(); ++i) {
+		frames[i] *= gain;
+	}
+}
+
+void apply_crossfeed(std::span<AudioFrame> frames, const float pan_left,
+                     const float pan_right)
+{
+	const auto left_gains  = set_frame_pair(1.0f - pan_left, pan_left);
+	const auto right_gains = set_frame_pair(1.0f - pan_right, pan_right);
+
+	size_t i = 0;
+	for (; i + 2 <= frames.size(); i += 2) {
+		const auto v = load_ps(&frames[i]);
+
+		const auto lefts = simde_mm_shuffle_ps(v, v, SIMDE_MM_SHUFFLE(2, 2, 0, 0));
+		const auto rights = simde_mm_shuffle_ps(v, v, SIMDE_MM_SHUFFLE(3, 3, 1, 1));
+
+		store_ps(&frames[i],
+		         simde_mm_add_ps(simde_mm_mul_ps(lefts, left_gains),
+		                         simde_mm_mul_ps(rights, right_gains)));
+	}
+	for (; i < frames.size(); ++i) {
+		const auto frame = frames[i];
+
+		frames[i] = {(1.0f - pan_left) * frame.left +
+		                     (1.0f - pan_right) * frame.right,
+		             pan_left * frame.left + pan_right * frame.right};
+	}
+}
@@ -6,6 +6,7 @@
 
 #include "private/capture_video.h"
 #include "video/zmbv.h"
+#include "video/zmbv_encoder.h"
 
 #include <cassert>
 #include <cmath>
@@ -67,16 +68,22 @@ static constexpr auto AviHeaderSize = 500;
 static struct {
 	FILE* handle = nullptr;
 
-	uint32_t frames          = 0;
-	VideoCodec* codec        = nullptr;
+	// Compressed frames written to the file (only updated by the encoder
+	// thread while capturing)
+	uint32_t frames = 0;
+
+	// Frames handed off to the encoder
+	uint32_t frames_queued = 0;
+
+	ZmbvEncoder encoder      = {};
 	int width                = 0;
 	int height               = 0;
 	PixelFormat pixel_format = {};
 	float frames_per_second  = 0.0f;
 
+	// The AVI chunk bookkeeping is only touched by the encoder thread while
+	// capturing, and by the emulation thread after the encoder was closed.
 	uint32_t written           = 0;
-	uint32_t buf_size          = 0;
-	std::vector<uint8_t> buf   = {};
 	std::vector<uint8_t> index = {};
 	uint32_t index_used        = 0;
 
@@ -180,22 +187,34 @@ static void add_avi_chunk(const char* tag, const uint32_t size,
 	host_writed(index + 12, size);
 }
 
-// Writes the first `num_sample_frames` sample frames from the audio buffer as
-// a single `01wb` AVI chunk, then shifts any remaining frames down to the
-// front of the buffer. A no-op when `num_sample_frames` is zero.
-static void write_audio_chunk(const int num_sample_frames)
+// Called by the encoder thread for each chunk, in stream order
+static void write_encoded_chunk(const char* tag, const uint32_t size,
+                                const void* data, const uint32_t flags)
+{
+	add_avi_chunk(tag, size, data, flags);
+
+	if (memcmp(tag, "00dc", 4) == 0) {
+		++video.frames;
+	}
+}
+
+// Moves the first `num_sample_frames` sample frames from the audio buffer
+// into `out` (to be written as a single `01wb` AVI chunk), then shifts any
+// remaining frames down to the front of the buffer. Leaves `out` empty when
+// `num_sample_frames` is zero.
+static void take_audio_chunk(const int num_sample_frames, std::vector<int16_t>& out)
 {
 	assert(num_sample_frames <=
 	       static_cast<int>(video.audio.num_buffered_frames));
 
+	out.clear();
+
 	if (num_sample_frames == 0) {
 		return;
 	}
 
-	add_avi_chunk("01wb",
-	              num_sample_frames * SampleFrameSizeBytes,
-	              video.audio.buf,
-	              0);
+	const auto first_sample = &video.audio.buf[0][0];
+	out.assign(first_sample, first_sample + num_sample_frames * NumAudioChannels);
 
 	video.audio.bytes_written += num_sample_frames * SampleFrameSizeBytes;
 
@@ -277,14 +296,24 @@ void capture_video_finalise()
 	if (!video.handle) {
 		return;
 	}
-	if (video.codec) {
-		video.codec->FinishVideo();
-	}
+
+	// Wait for the encoder to write all pending frames; from here on we
+	// have exclusive access to the file again.
+	video.encoder.Close();
 
 	// Flush all audio still held back by the per-frame prebuffer so the
 	// stream contains every produced sample. Must run before the header is
 	// built below, which reads `bytes_written` as the audio stream length.
-	write_audio_chunk(video.audio.num_buffered_frames);
+	std::vector<int16_t> audio_samples = {};
+	take_audio_chunk(video.audio.num_buffered_frames, audio_samples);
+
+	if (!audio_samples.empty()) {
+		add_avi_chunk("01wb",
+		              check_cast<uint32_t>(audio_samples.size() *
+		                                   sizeof(int16_t)),
+		              audio_samples.data(),
+		              0);
+	}
 
 	uint8_t avi_header[AviHeaderSize];
 	uint32_t header_pos = 0;
@@ -438,7 +467,6 @@ void capture_video_finalise()
 	fwrite(&avi_header, 1, AviHeaderSize, video.handle);
 
 	fclose(video.handle);
-	delete video.codec;
 	video.handle = nullptr;
 }
 
@@ -478,14 +506,6 @@ static void create_avi_file(const uint16_t width, const uint16_t height,
 	if (!video.handle) {
 		return;
 	}
-	video.codec = new VideoCodec();
-	if (!video.codec->SetupCompress(width, height)) {
-		return;
-	}
-
-	video.buf_size = video.codec->NeededSize(width, height, format);
-	video.buf.resize(video.buf_size);
-
 	video.index.resize(16 * 4096);
 	video.index_used = 8;
 
@@ -498,21 +518,29 @@ static void create_avi_file(const uint16_t width, const uint16_t height,
 		fputc(0, video.handle);
 	}
 
-	video.frames  = 0;
-	video.written = 0;
+	video.frames        = 0;
+	video.frames_queued = 0;
+	video.written       = 0;
 
 	video.audio.num_buffered_frames           = 0;
 	video.audio.bytes_written                 = 0;
 	video.audio.frame_credit                  = 0.0;
 	video.audio.is_primed                     = false;
 	video.audio.num_video_frames_since_resync = 0;
+
+	// Start the encoder thread last; it writes to the file from now on
+	if (!video.encoder.Open(width, height, format, write_encoded_chunk)) {
+		LOG_WARNING("CAPTURE: Failed to initialise the ZMBV video encoder");
+		fclose(video.handle);
+		video.handle = nullptr;
+	}
 }
 
 // Performs some transforms on the passed down rendered image to make sure
-// we're capturing the raw output, then passes the result in the same
-// byte-order to the encoder. Endianness varies per pixel format (see
-// PixelFormat in video.h for details); the ZMBV encoder handles all that
-// detail.
+// we're capturing the raw output, then copies the result in the same
+// byte-order into the tightly packed `dest` frame buffer of the encoder.
+// Endianness varies per pixel format (see PixelFormat in video.h for
+// details); the ZMBV encoder handles all that detail.
 //
 // We always write non-double-scanned and non-pixel-doubled frames in raw
 // video capture mode :
@@ -532,7 +560,7 @@ static void create_avi_file(const uint16_t width, const uint16_t height,
 // artifacts (so 320x200 is rendered as 640x200, and 640x200 as 1280x200).
 // These are written as-is, otherwise we'd be losing information.
 //
-static void compress_raw_frame(const RenderedImage& image)
+static void copy_raw_frame(const RenderedImage& image, std::vector<uint8_t>& dest)
 {
 	const auto& src = image.params;
 	auto src_row    = image.image_data;
@@ -548,22 +576,24 @@ static void compress_raw_frame(const RenderedImage& image)
 
 	const auto pixel_skip_count = (src.rendered_pixel_doubling ? 1 : 0);
 
-	auto compress_row = [&](const uint8_t* row_buffer) {
-		video.codec->CompressLines(1, &row_buffer);
-	};
-
 	const auto src_bpp = to_bytes_per_pixel(src.pixel_format);
 	const auto dest_bpp = to_bytes_per_pixel(to_zmbv_format(src.pixel_format));
 
-	// Maybe compress the source rows straight away without copying. Note
-	// that this is a shortcut scenario; hard-code it to false to exercise
-	// the rote version below.
+	const auto dest_row_bytes = static_cast<size_t>(raw_width * dest_bpp);
+	assert(dest.size() >= dest_row_bytes * raw_height);
+
+	auto dest_row = dest.data();
+
+	// Maybe copy the source rows straight away without rearranging the
+	// pixels. Note that this is a shortcut scenario; hard-code it to false
+	// to exercise the rote version below.
 
 	const auto can_use_src_directly = (src_bpp == dest_bpp &&
 	                                   pixel_skip_count == 0);
 	if (can_use_src_directly) {
 		for (auto i = 0; i < raw_height; ++i, src_row += src_pitch) {
-			compress_row(src_row);
+			std::memcpy(dest_row, src_row, dest_row_bytes);
+			dest_row += dest_row_bytes;
 		}
 		return;
 	}
@@ -571,97 +601,29 @@ static void compress_raw_frame(const RenderedImage& image)
 	// Otherwise we need to arrange the source bytes before compressing
 	assert(!can_use_src_directly);
 
-	// Grow the target row buffer if needed
-	const auto dest_row_bytes = check_cast<uint16_t>(src.width * dest_bpp);
-	static std::vector<uint8_t> dest_row = {};
-	if (dest_row.size() < dest_row_bytes) {
-		dest_row.resize(dest_row_bytes, 0);
-	}
-
+	// When expanding 24-bit to 32-bit pixels, the padding bytes of the
+	// pooled buffers are never written, so they stay zeroed.
 	const auto src_advance = src_bpp * (pixel_skip_count + 1);
 
 	for (auto i = 0; i < raw_height; ++i, src_row += src_pitch) {
 		auto src_pixel  = src_row;
-		auto dest_pixel = dest_row.data();
+		auto dest_pixel = dest_row;
 
 		for (auto j = 0; j < raw_width; ++j, src_pixel += src_advance) {
 			std::memcpy(dest_pixel, src_pixel, src_bpp);
 			dest_pixel += dest_bpp;
 		}
-		compress_row(dest_row.data());
+		dest_row += dest_row_bytes;
 	}
 }
 
-void capture_video_add_frame(const RenderedImage& image, const float frames_per_second)
+// Meters audio out evenly across video frames instead of dumping every sample
+// that arrived since the last frame into one `01wb` chunk. We hold back a
+// reserve (`AudioPrebufferFrames`) and emit a fixed per-frame target, so bursty
+// producer output is smoothed into uniform chunks. The samples to be written
+// after the current video frame are moved into `out`.
+static void meter_audio_for_frame(std::vector<int16_t>& out)
 {
-	const auto& src = image.params;
-	assert(src.width <= ScalerMaxWidth);
-
-	// To reconstruct the raw image, we must skip every second row when
-	// dealing with "baked-in" double scanning.
-	const auto raw_width = check_cast<uint16_t>(
-	        src.width / (src.rendered_pixel_doubling ? 2 : 1));
-
-	// To reconstruct the raw image, we must skip every second pixel
-	// when dealing with "baked-in" pixel doubling.
-	const auto raw_height = check_cast<uint16_t>(
-	        src.height / (src.rendered_double_scan ? 2 : 1));
-
-	// Disable capturing if any of the test fails
-	if (video.handle && (video.width != raw_width || video.height != raw_height ||
-	                     video.pixel_format != src.pixel_format ||
-	                     video.frames_per_second != frames_per_second)) {
-		capture_video_finalise();
-	}
-
-	const auto zmbv_format = to_zmbv_format(src.pixel_format);
-
-	if (!video.handle) {
-		create_avi_file(raw_width,
-		                raw_height,
-		                src.pixel_format,
-		                frames_per_second,
-		                zmbv_format);
-	}
-	if (!video.handle) {
-		return;
-	}
-
-	const auto codec_flags = (video.frames % 300 == 0) ? 1 : 0;
-
-	static uint8_t palette_data[NumVgaColors * 4] = {};
-
-	for (auto i = 0; i < NumVgaColors; ++i) {
-		const auto color = image.palette[i];
-
-		palette_data[i * 4]     = color.red;
-		palette_data[i * 4 + 1] = color.green;
-		palette_data[i * 4 + 2] = color.blue;
-	}
-
-	if (!video.codec->PrepareCompressFrame(codec_flags,
-	                                       zmbv_format,
-	                                       palette_data,
-	                                       video.buf.data(),
-	                                       video.buf_size)) {
-		return;
-	}
-
-	compress_raw_frame(image);
-
-	const auto written = video.codec->FinishCompressFrame();
-	if (written < 0) {
-		return;
-	}
-
-	add_avi_chunk("00dc", written, video.buf.data(), codec_flags & 1 ? 0x10 : 0x0);
-	video.frames++;
-
-	// Meter audio out evenly across video frames instead of dumping every
-	// sample that arrived since the last frame into one `01wb` chunk. We
-	// hold back a reserve (`AudioPrebufferFrames`) and emit a fixed
-	// per-frame target, so bursty producer output is smoothed into uniform
-	// chunks.
 	if (!video.audio.is_primed) {
 		if (video.audio.num_buffered_frames < AudioPrebufferFrames) {
 			// Still building the reserve; nothing to emit yet.
@@ -690,7 +652,7 @@ void capture_video_add_frame(const RenderedImage& image, const float frames_per_
 	}
 
 	video.audio.frame_credit -= num_audio_frames_to_write;
-	write_audio_chunk(num_audio_frames_to_write);
+	take_audio_chunk(num_audio_frames_to_write, out);
 
 	// Shed accumulated surplus to keep the captured audio locked to the
 	// (emulated-time) video timeline. See the `AudioResync*` constants.
@@ -730,3 +692,61 @@ void capture_video_add_frame(const RenderedImage& image, const float frames_per_
 		          AudioPrebufferFrames);
 	}
 }
+
+void capture_video_add_frame(const RenderedImage& image, const float frames_per_second)
+{
+	const auto& src = image.params;
+	assert(src.width <= ScalerMaxWidth);
+
+	// To reconstruct the raw image, we must skip every second row when
+	// dealing with "baked-in" double scanning.
+	const auto raw_width = check_cast<uint16_t>(
+	        src.width / (src.rendered_pixel_doubling ? 2 : 1));
+
+	// To reconstruct the raw image, we must skip every second pixel
+	// when dealing with "baked-in" pixel doubling.
+	const auto raw_height = check_cast<uint16_t>(
+	        src.height / (src.rendered_double_scan ? 2 : 1));
+
+	// Disable capturing if any of the test fails
+	if (video.handle && (video.width != raw_width || video.height != raw_height ||
+	                     video.pixel_format != src.pixel_format ||
+	                     video.frames_per_second != frames_per_second)) {
+		capture_video_finalise();
+	}
+
+	const auto zmbv_format = to_zmbv_format(src.pixel_format);
+
+	if (!video.handle) {
+		create_avi_file(raw_width,
+		                raw_height,
+		                src.pixel_format,
+		                frames_per_second,
+		                zmbv_format);
+	}
+	if (!video.handle) {
+		return;
+	}
+
+	// The emulation thread only copies the raw frame and meters out the
+	// audio; compression and writing happen on the encoder thread.
+	ZmbvEncodeTask task = {};
+
+	task.is_keyframe = (video.frames_queued % 300 == 0);
+
+	for (auto i = 0; i < NumVgaColors; ++i) {
+		const auto color = image.palette[i];
+
+		task.palette[i * 4]     = color.red;
+		task.palette[i * 4 + 1] = color.green;
+		task.palette[i * 4 + 2] = color.blue;
+	}
+
+	task.frame_data = video.encoder.GetFrameBuffer();
+	copy_raw_frame(image, task.frame_data);
+
+	meter_audio_for_frame(task.audio_samples);
+
+	video.encoder.QueueFrame(std::move(task));
+	++video.frames_queued;
+}
@@ -3,12 +3,15 @@
 
 #include "zmbv.h"
 
+#include <bit>
 #include <cassert>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 
+#include "simde/x86/sse2.h"
+
 #include "utils/math_utils.h"
 #include "utils/mem_unaligned.h"
 #include "misc/support.h"
@@ -21,6 +24,9 @@ constexpr uint8_t DBZV_VERSION_LOW  = 1;
 
 constexpr uint8_t MAX_VECTOR = 16;
 
+// Don't wake up the search threads for tiny frames
+constexpr int MIN_BLOCKS_FOR_PARALLEL_SEARCH = 64;
+
 constexpr uint8_t Mask_KeyFrame     = 0x01;
 constexpr uint8_t Mask_DeltaPalette = 0x02;
 
@@ -102,6 +108,7 @@ bool VideoCodec::SetupBuffers(const ZMBV_FORMAT _format, const int blockwidth, c
 
 	const auto blocks_needed = check_cast<uint32_t>(xblocks * yblocks);
 	blocks.resize(blocks_needed);
+	block_matches.resize(blocks_needed);
 
 	size_t i = 0;
 	for (auto y = 0; y < yblocks; ++y) {
@@ -163,6 +170,76 @@ int VideoCodec::PossibleBlock(const int vx, const int vy, const FrameBlock & blo
 	return ret;
 }
 
+// Returns the number of pixels that differ in the lowest 24 bits (i.e., the
+// colour bits) between two rows of `num_pixels` pixels. Compares 16 bytes at a
+// time and finishes the remainder with scalar code.
+static int count_changed_pixels(const uint8_t* pold, const uint8_t* pnew,
+                                const int num_pixels)
+{
+	int diff_count = 0;
+	int x          = 0;
+	for (; x + 16 <= num_pixels; x += 16) {
+		const auto eq = simde_mm_cmpeq_epi8(
+		        simde_mm_loadu_si128(reinterpret_cast<const simde__m128i*>(pold + x)),
+		        simde_mm_loadu_si128(reinterpret_cast<const simde__m128i*>(pnew + x)));
+
+		const auto eq_mask = static_cast<uint32_t>(simde_mm_movemask_epi8(eq));
+		diff_count += 16 - std::popcount(eq_mask);
+	}
+	for (; x < num_pixels; ++x) {
+		diff_count += (pold[x] != pnew[x]);
+	}
+	return diff_count;
+}
+
+static int count_changed_pixels(const uint16_t* pold, const uint16_t* pnew,
+                                const int num_pixels)
+{
+	int diff_count = 0;
+	int x          = 0;
+	for (; x + 8 <= num_pixels; x += 8) {
+		const auto eq = simde_mm_cmpeq_epi16(
+		        simde_mm_loadu_si128(reinterpret_cast<const simde__m128i*>(pold + x)),
+		        simde_mm_loadu_si128(reinterpret_cast<const simde__m128i*>(pnew + x)));
+
+		// Two mask bits per 16-bit lane
+		const auto eq_mask = static_cast<uint32_t>(simde_mm_movemask_epi8(eq));
+		diff_count += 8 - std::popcount(eq_mask) / 2;
+	}
+	for (; x < num_pixels; ++x) {
+		diff_count += (pold[x] != pnew[x]);
+	}
+	return diff_count;
+}
+
+static int count_changed_pixels(const uint32_t* pold, const uint32_t* pnew,
+                                const int num_pixels)
+{
+	const auto colour_mask = simde_mm_set1_epi32(0x00ffffff);
+
+	int diff_count = 0;
+	int x          = 0;
+	for (; x + 4 <= num_pixels; x += 4) {
+		const auto eq = simde_mm_cmpeq_epi32(
+		        simde_mm_and_si128(simde_mm_loadu_si128(
+		                                   reinterpret_cast<const simde__m128i*>(
+		                                           pold + x)),
+		                           colour_mask),
+		        simde_mm_and_si128(simde_mm_loadu_si128(
+		                                   reinterpret_cast<const simde__m128i*>(
+		                                           pnew + x)),
+		                           colour_mask));
+
+		// Four mask bits per 32-bit lane
+		const auto eq_mask = static_cast<uint32_t>(simde_mm_movemask_epi8(eq));
+		diff_count += 4 - std::popcount(eq_mask) / 4;
+	}
+	for (; x < num_pixels; ++x) {
+		diff_count += ((pold[x] ^ pnew[x]) & 0x00ffffff) != 0;
+	}
+	return diff_count;
+}
+
 template <class P>
 int VideoCodec::CompareBlock(const int vx, const int vy, const FrameBlock & block)
 {
@@ -171,9 +248,7 @@ int VideoCodec::CompareBlock(const int vx, const int vy, const FrameBlock & bloc
 	P *pnew = reinterpret_cast<P *>(newframe) + block.start;
 
 	for (auto y = 0; y < block.dy; y++) {
-		for (auto x = 0; x < block.dx; x++) {
-			diff_count += ((pold[x] ^ pnew[x]) & 0x00ffffff) != 0;
-		}
+		diff_count += count_changed_pixels(pold, pnew, block.dx);
 		pold += pitch;
 		pnew += pitch;
 	}
@@ -185,11 +260,28 @@ void VideoCodec::AddXorBlock(const int vx, const int vy, const FrameBlock & bloc
 {
 	P *pold = reinterpret_cast<P *>(oldframe) + block.start + (vy * pitch) + vx;
 	P *pnew = reinterpret_cast<P *>(newframe) + block.start;
+
+	const auto row_bytes = block.dx * static_cast<int>(sizeof(P));
+
 	for (auto y = 0; y < block.dy; ++y) {
-		for (auto x = 0; x < block.dx; ++x) {
-			*reinterpret_cast<P *>(&work[workUsed]) = pnew[x] ^ pold[x];
-			workUsed += sizeof(P);
+		const auto src_old = reinterpret_cast<const uint8_t *>(pold);
+		const auto src_new = reinterpret_cast<const uint8_t *>(pnew);
+		auto dest          = &work[workUsed];
+
+		// XOR 16 bytes at a time, then the remainder pixel by pixel
+		int i = 0;
+		for (; i + 16 <= row_bytes; i += 16) {
+			simde_mm_storeu_si128(
+			        reinterpret_cast<simde__m128i *>(dest + i),
+			        simde_mm_xor_si128(
+			                simde_mm_loadu_si128(reinterpret_cast<const simde__m128i *>(src_new + i)),
+			                simde_mm_loadu_si128(reinterpret_cast<const simde__m128i *>(src_old + i))));
 		}
+		for (auto x = i / static_cast<int>(sizeof(P)); x < block.dx; ++x) {
+			*reinterpret_cast<P *>(dest + x * sizeof(P)) = pnew[x] ^ pold[x];
+		}
+		workUsed += static_cast<size_t>(row_bytes);
+
 		pold += pitch;
 		pnew += pitch;
 	}
@@ -200,6 +292,152 @@ void VideoCodec::AlignWork(size_t & offset) {
 	offset = (offset + blocks.size() * 2u + 3u) & ~3u;
 }
 
+template <class P>
+void VideoCodec::FindBlockMatch(const FrameBlock& block, BlockMatch& match)
+{
+	int8_t bestvx   = 0;
+	int8_t bestvy   = 0;
+	auto bestchange = CompareBlock<P>(0, 0, block);
+	auto possibles  = 64;
+
+	for (auto v = 0; v < VectorCount && possibles; v++) {
+		if (bestchange < 4)
+			break;
+		auto vx = VectorTable[v].x;
+		auto vy = VectorTable[v].y;
+		if (PossibleBlock<P>(vx, vy, block) < 4) {
+			possibles--;
+			// if (!possibles) Msg("Ran out of possibles, at
+			// %d of %d best%d\n",v,VectorCount,bestchange);
+			auto testchange = CompareBlock<P>(vx, vy, block);
+			if (testchange < bestchange) {
+				bestchange = testchange;
+				bestvx     = check_cast<int8_t>(vx);
+				bestvy     = check_cast<int8_t>(vy);
+			}
+		}
+	}
+	match.vx         = bestvx;
+	match.vy         = bestvy;
+	match.has_change = (bestchange != 0);
+}
+
+template <class P>
+void VideoCodec::SearchTile(const int tile)
+{
+	const auto num_blocks = static_cast<int>(blocks.size());
+
+	const auto from = num_blocks * tile / search.num_tiles;
+	const auto to   = num_blocks * (tile + 1) / search.num_tiles;
+
+	for (auto b = from; b < to; ++b) {
+		FindBlockMatch<P>(blocks[b], block_matches[b]);
+	}
+}
+
+// Returns true if there are more tiles left to be picked up
+bool VideoCodec::DoSearchWork()
+{
+	// Extra load to ensure we don't overflow the index with the fetch_add
+	// below in case of spurious wake-ups.
+	auto i = search.tile_index.load(std::memory_order_acquire);
+	if (i >= search.num_tiles) {
+		return false;
+	}
+
+	i = search.tile_index.fetch_add(1, std::memory_order_acq_rel);
+	if (i < search.num_tiles) {
+		(this->*search.search_tile)(i);
+
+		const auto done = search.done_count.fetch_add(1, std::memory_order_acq_rel) + 1;
+		if (done >= search.num_tiles) {
+			search.done_count.notify_all();
+		}
+	}
+	return (i + 1) < search.num_tiles;
+}
+
+void VideoCodec::SearchThreadLoop()
+{
+	while (search.threads_active.load(std::memory_order_acquire)) {
+		if (!DoSearchWork()) {
+			const auto i = search.tile_index.load(std::memory_order_acquire);
+			if (i >= search.num_tiles) {
+				search.tile_index.wait(i, std::memory_order_acquire);
+			}
+		}
+	}
+}
+
+void VideoCodec::ShutdownSearchThreads()
+{
+	if (!search.threads_active.load(std::memory_order_acquire)) {
+		return;
+	}
+	search.threads_active.store(false, std::memory_order_release);
+	search.tile_index.store(INT_MAX, std::memory_order_release);
+	search.tile_index.notify_all();
+
+	for (auto& thread : search.threads) {
+		if (thread.joinable()) {
+			thread.join();
+		}
+	}
+	search.threads.clear();
+}
+
+void VideoCodec::SetNumSearchThreads(const int num_threads)
+{
+	assert(num_threads >= 0);
+	ShutdownSearchThreads();
+
+	search.num_threads = num_threads;
+
+	// Use more tiles than threads so the faster threads can pick up the
+	// slack when some tiles need a longer search than others.
+	search.num_tiles = (num_threads + 1) * 4;
+}
+
+template <class P>
+void VideoCodec::SearchBlocks()
+{
+	const auto num_blocks = static_cast<int>(blocks.size());
+
+	if (search.num_threads == 0 || num_blocks < MIN_BLOCKS_FOR_PARALLEL_SEARCH) {
+		for (auto b = 0; b < num_blocks; ++b) {
+			FindBlockMatch<P>(blocks[b], block_matches[b]);
+		}
+		return;
+	}
+
+	// The search threads are only spun up once on first use
+	if (!search.threads_active.load(std::memory_order_acquire)) {
+		search.threads_active.store(true, std::memory_order_release);
+
+		search.threads.resize(static_cast<size_t>(search.num_threads));
+		for (auto& thread : search.threads) {
+			thread = std::thread(&VideoCodec::SearchThreadLoop, this);
+		}
+	}
+
+	search.search_tile = &VideoCodec::SearchTile<P>;
+	search.done_count.store(0, std::memory_order_release);
+
+	// Resetting this index triggers the search threads to start working
+	search.tile_index.store(0, std::memory_order_release);
+	search.tile_index.notify_all();
+
+	// The calling thread also does the same work as the search threads
+	while (DoSearchWork()) {
+	}
+
+	// Wait until all tiles have been searched
+	int done = 0;
+	while ((done = search.done_count.load(std::memory_order_acquire)) < search.num_tiles) {
+		search.done_count.wait(done, std::memory_order_acquire);
+	}
+}
+
 template <class P>
 void VideoCodec::AddXorFrame()
 {
@@ -207,36 +445,19 @@ void VideoCodec::AddXorFrame()
 
 	AlignWork(workUsed);
 
+	// Find the best motion vector for every block first (potentially in
+	// parallel), then emit the vectors and XOR data in block order.
+	SearchBlocks<P>();
+
 	size_t b = 0;
 	for (const auto & block : blocks) {
+		const auto& match = block_matches[b];
 
-		int8_t bestvx   = 0;
-		int8_t bestvy   = 0;
-		auto bestchange = CompareBlock<P>(0, 0, block);
-		auto possibles  = 64;
-
-		for (auto v = 0; v < VectorCount && possibles; v++) {
-			if (bestchange < 4)
-				break;
-			auto vx = VectorTable[v].x;
-			auto vy = VectorTable[v].y;
-			if (PossibleBlock<P>(vx, vy, block) < 4) {
-				possibles--;
-				// if (!possibles) Msg("Ran out of possibles, at
-				// %d of %d best%d\n",v,VectorCount,bestchange);
-				auto testchange = CompareBlock<P>(vx, vy, block);
-				if (testchange < bestchange) {
-					bestchange = testchange;
-					bestvx     = check_cast<int8_t>(vx);
-					bestvy     = check_cast<int8_t>(vy);
-				}
-			}
-		}
-		vectors[b * 2 + 0] = static_cast<uint8_t>(left_shift_signed(bestvx, 1));
-		vectors[b * 2 + 1] = static_cast<uint8_t>(left_shift_signed(bestvy, 1));
-		if (bestchange) {
+		vectors[b * 2 + 0] = static_cast<uint8_t>(left_shift_signed(match.vx, 1));
+		vectors[b * 2 + 1] = static_cast<uint8_t>(left_shift_signed(match.vy, 1));
+		if (match.has_change) {
 			vectors[b * 2 + 0] |= 1;
-			AddXorBlock<P>(bestvx, bestvy, block);
+			AddXorBlock<P>(match.vx, match.vy, block);
 		}
 		++b;
 	}
@@ -592,3 +813,8 @@ VideoCodec::VideoCodec()
 	CreateVectorTable();
 	memset(&zstream, 0, sizeof(zstream));
 }
+
+VideoCodec::~VideoCodec()
+{
+	ShutdownSearchThreads();
+}
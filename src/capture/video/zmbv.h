@@ -4,7 +4,10 @@
 #ifndef DOSBOX_ZMBV_H
 #define DOSBOX_ZMBV_H
 
+#include <atomic>
+#include <climits>
 #include <cstdint>
+#include <thread>
 #include <vector>
 
 #include "dosbox_config.h"
@@ -18,6 +21,7 @@
 #define inflateInit zng_inflateInit
 #define inflateReset zng_inflateReset
 #define inflate zng_inflate
+#define inflateEnd zng_inflateEnd
 #define z_stream zng_stream
 #else
 #include <zlib.h>
@@ -60,6 +64,13 @@ private:
 		uint8_t blockheight = 0;
 	};
 
+	// Result of the motion search for a single block
+	struct BlockMatch {
+		int8_t vx       = 0;
+		int8_t vy       = 0;
+		bool has_change = false;
+	};
+
 	struct Compress {
 		int linesDone = 0;
 		uint32_t writeSize = 0;
@@ -81,6 +92,7 @@ private:
 	uint32_t bufsize = 0;
 
 	std::vector<FrameBlock> blocks = {};
+	std::vector<BlockMatch> block_matches = {};
 	size_t workUsed = 0;
 	size_t workPos = 0;
 
@@ -95,6 +107,28 @@ private:
 	Compress compress = {};
 	z_stream zstream = {};
 
+	// Tile-parallel motion search. The blocks are split into `num_tiles`
+	// contiguous tiles that the search threads and the calling thread
+	// process concurrently. Only the search is parallel; the XOR data is
+	// emitted sequentially in block order so the bitstream is identical
+	// to the single-threaded encoder's.
+	struct SearchWorkers {
+		int num_threads = 0;
+		int num_tiles   = 0;
+
+		std::atomic_bool threads_active = {};
+
+		std::vector<std::thread> threads = {};
+
+		// Search threads start working when this gets reset to 0
+		std::atomic<int> tile_index = INT_MAX;
+
+		std::atomic<int> done_count = 0;
+
+		void (VideoCodec::*search_tile)(int tile) = nullptr;
+	};
+	SearchWorkers search = {};
+
 	// methods
 	void CreateVectorTable();
 	bool SetupBuffers(ZMBV_FORMAT format, int blockwidth, int blockheight);
@@ -102,6 +136,15 @@ private:
 	template <class P>
 	void AddXorFrame();
 	template <class P>
+	void FindBlockMatch(const FrameBlock& block, BlockMatch& match);
+	template <class P>
+	void SearchTile(int tile);
+	template <class P>
+	void SearchBlocks();
+	bool DoSearchWork();
+	void SearchThreadLoop();
+	void ShutdownSearchThreads();
+	template <class P>
 	void UnXorFrame();
 	template <class P>
 	int PossibleBlock(int vx, int vy, const FrameBlock & block);
@@ -118,11 +161,17 @@ private:
 
 public:
 	VideoCodec();
+	~VideoCodec();
 
 	VideoCodec(const VideoCodec &) = delete;            // prevent copy
 	VideoCodec &operator=(const VideoCodec &) = delete; // prevent assignment
 
 	bool SetupCompress(int _width, int _height);
+
+	// Number of extra threads used for the motion search when compressing
+	// delta frames (0 = search on the calling thread only). The output is
+	// byte-identical regardless of the thread count.
+	void SetNumSearchThreads(int num_threads);
 	bool SetupDecompress(int _width, int _height);
 	ZMBV_FORMAT BPPFormat(int bpp);
 	int NeededSize(int _width, int _height, ZMBV_FORMAT _format);
@@ -0,0 +1,210 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "zmbv_encoder.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "misc/logging.h"
+#include "misc/support.h"
+#include "utils/checks.h"
+
+CHECK_NARROWING();
+
+ZmbvEncoder::~ZmbvEncoder()
+{
+	Close();
+}
+
+bool ZmbvEncoder::Open(const int _width, const int _height,
+                       const ZMBV_FORMAT _format, WriteChunkCallback _write_chunk)
+{
+	if (is_open) {
+		Close();
+	}
+
+	codec = std::make_unique<VideoCodec>();
+	if (!codec->SetupCompress(_width, _height)) {
+		codec = {};
+		return false;
+	}
+
+	// Leave a core each for the emulation and the encoder threads
+	const auto num_cores = static_cast<int>(std::thread::hardware_concurrency());
+	codec->SetNumSearchThreads(std::clamp(num_cores - 2, 0, MaxSearchThreads));
+
+	width       = _width;
+	height      = _height;
+	format      = _format;
+	write_chunk = std::move(_write_chunk);
+
+	frame_row_bytes = static_cast<size_t>(width) * ZMBV_ToBytesPerPixel(format);
+
+	output.resize(check_cast<size_t>(codec->NeededSize(width, height, format)));
+
+	{
+		std::lock_guard<std::mutex> lock(pool_mutex);
+		pool.clear();
+	}
+
+	stats = {};
+
+	frame_fifo.Start();
+
+	encoder = std::thread(&ZmbvEncoder::EncodeQueuedFrames, this);
+	set_thread_name(encoder, "dosbox:vidcap");
+
+	is_open = true;
+	return true;
+}
+
+void ZmbvEncoder::Close()
+{
+	if (!is_open) {
+		return;
+	}
+
+	// Stop queuing new frames
+	frame_fifo.Stop();
+
+	// Let the encoder finish compressing and writing the pending frames
+	if (encoder.joinable()) {
+		encoder.join();
+	}
+
+	codec->FinishVideo();
+	codec = {};
+
+	LogStats();
+
+	{
+		std::lock_guard<std::mutex> lock(pool_mutex);
+		pool.clear();
+	}
+	output.clear();
+
+	is_open = false;
+}
+
+std::vector<uint8_t> ZmbvEncoder::GetFrameBuffer()
+{
+	std::vector<uint8_t> buffer = {};
+	{
+		std::lock_guard<std::mutex> lock(pool_mutex);
+		if (!pool.empty()) {
+			buffer = std::move(pool.back());
+			pool.pop_back();
+		}
+	}
+	// Only the first few frames need to allocate; the pool size is bounded
+	// by the queue capacity plus the frames in flight.
+	buffer.resize(frame_row_bytes * static_cast<size_t>(height), 0);
+	return buffer;
+}
+
+void ZmbvEncoder::ReturnFrameBuffer(std::vector<uint8_t>&& buffer)
+{
+	std::lock_guard<std::mutex> lock(pool_mutex);
+	pool.emplace_back(std::move(buffer));
+}
+
+void ZmbvEncoder::QueueFrame(ZmbvEncodeTask&& task)
+{
+	assert(is_open);
+	assert(task.frame_data.size() == frame_row_bytes * static_cast<size_t>(height));
+
+	++stats.num_frames_queued;
+
+	// Try the fast path first so we can tell how often the encoder falls
+	// behind and the emulation thread has to wait for it.
+	if (!frame_fifo.NonblockingEnqueue(std::move(task))) {
+		if (!frame_fifo.IsRunning()) {
+			return;
+		}
+		++stats.num_stalls;
+		frame_fifo.Enqueue(std::move(task));
+	}
+
+	const auto queue_depth = frame_fifo.Size();
+	if (queue_depth > stats.max_queue_depth) {
+		stats.max_queue_depth = queue_depth;
+	}
+}
+
+void ZmbvEncoder::EncodeQueuedFrames()
+{
+	while (auto task = frame_fifo.Dequeue()) {
+		EncodeFrame(*task);
+		ReturnFrameBuffer(std::move(task->frame_data));
+	}
+}
+
+void ZmbvEncoder::EncodeFrame(ZmbvEncodeTask& task)
+{
+	if (CompressFrame(task)) {
+		++stats.num_frames_encoded;
+	} else {
+		++stats.num_frames_failed;
+	}
+
+	// The audio has already been metered out for this frame, so we write it
+	// even if the frame itself couldn't be compressed.
+	if (!task.audio_samples.empty()) {
+		const auto num_bytes = task.audio_samples.size() * sizeof(int16_t);
+		write_chunk("01wb",
+		            check_cast<uint32_t>(num_bytes),
+		            task.audio_samples.data(),
+		            0);
+	}
+}
+
+bool ZmbvEncoder::CompressFrame(const ZmbvEncodeTask& task)
+{
+	const auto codec_flags = task.is_keyframe ? 1 : 0;
+
+	const auto output_size = check_cast<uint32_t>(output.size());
+
+	if (!codec->PrepareCompressFrame(codec_flags,
+	                                 format,
+	                                 task.palette.data(),
+	                                 output.data(),
+	                                 output_size)) {
+		return false;
+	}
+
+	auto row = task.frame_data.data();
+	for (auto y = 0; y < height; ++y, row += frame_row_bytes) {
+		codec->CompressLines(1, &row);
+	}
+
+	const auto written = codec->FinishCompressFrame();
+	if (written < 0) {
+		return false;
+	}
+
+	write_chunk("00dc",
+	            static_cast<uint32_t>(written),
+	            output.data(),
+	            task.is_keyframe ? 0x10 : 0x0);
+	return true;
+}
+
+void ZmbvEncoder::LogStats() const
+{
+	LOG_DEBUG("CAPTURE: Video encoder queued %u frames, encoded %u, failed %u; "
+	          "emulation waited on the encoder %u times, max queue depth %zu of %d",
+	          stats.num_frames_queued,
+	          stats.num_frames_encoded,
+	          stats.num_frames_failed,
+	          stats.num_stalls,
+	          stats.max_queue_depth,
+	          MaxQueuedFrames);
+
+	if (stats.num_stalls > 0) {
+		LOG_WARNING("CAPTURE: Video encoder could not keep up; emulation "
+		            "was stalled on %u of %u frames",
+		            stats.num_stalls,
+		            stats.num_frames_queued);
+	}
+}
@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef DOSBOX_ZMBV_ENCODER_H
+#define DOSBOX_ZMBV_ENCODER_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "zmbv.h"
+
+#include "hardware/video/vga.h"
+#include "utils/rwqueue.h"
+
+// A single raw video frame waiting to be compressed, plus the captured audio
+// that must be interleaved right after it in the AVI stream.
+struct ZmbvEncodeTask {
+	// Tightly packed raw rows in the ZMBV pixel format (`width *
+	// bytes_per_pixel` bytes per row, no padding). Taken from, and returned
+	// to, the encoder's buffer pool.
+	std::vector<uint8_t> frame_data = {};
+
+	std::array<uint8_t, NumVgaColors * 4> palette = {};
+
+	bool is_keyframe = false;
+
+	// Interleaved 16-bit stereo sample frames to write as a `01wb` chunk
+	// after the frame's `00dc` chunk; can be empty.
+	std::vector<int16_t> audio_samples = {};
+};
+
+// Asynchronous ZMBV video encoder.
+//
+// The emulation thread only copies the raw frame into a pooled buffer and
+// hands it off via a bounded FIFO queue; the block matching, XOR-ing and
+// deflate compression of the ZMBV codec happen on a dedicated worker thread
+// that also writes the resulting AVI chunks to the output file in order.
+//
+// ZMBV is a delta codec with a single deflate stream spanning all frames, so
+// frames must be compressed strictly in sequence. That's why there's only a
+// single worker; the parallelism we gain is between the emulation thread and
+// the encoder.
+//
+// If the encoder can't keep up, the queue fills up and `QueueFrame()` blocks
+// until there's room again (back-pressure). We never drop frames because
+// that would break the emulated-time-based audio/video sync of the capture.
+//
+class ZmbvEncoder {
+public:
+	// Called on the worker thread for every AVI chunk to be written (in
+	// stream order).
+	using WriteChunkCallback = std::function<void(const char* tag,
+	                                              const uint32_t size,
+	                                              const void* data,
+	                                              const uint32_t flags)>;
+
+	ZmbvEncoder() = default;
+	~ZmbvEncoder();
+
+	bool Open(const int width, const int height, const ZMBV_FORMAT format,
+	          WriteChunkCallback write_chunk);
+
+	// Blocks until all queued frames have been compressed and written.
+	void Close();
+
+	// Returns a zeroed or previously used frame buffer of the right size
+	// from the pool. The caller is expected to fill it and pass it back via
+	// `QueueFrame()`.
+	std::vector<uint8_t> GetFrameBuffer();
+
+	// Potentially blocks if the encoder queue is full.
+	void QueueFrame(ZmbvEncodeTask&& task);
+
+	// prevent copying
+	ZmbvEncoder(const ZmbvEncoder&) = delete;
+	// prevent assignment
+	ZmbvEncoder& operator=(const ZmbvEncoder&) = delete;
+
+private:
+	static constexpr auto MaxQueuedFrames = 8;
+
+	// Motion search threads used in addition to the encoder thread
+	static constexpr auto MaxSearchThreads = 7;
+
+	void EncodeQueuedFrames();
+	void EncodeFrame(ZmbvEncodeTask& task);
+	bool CompressFrame(const ZmbvEncodeTask& task);
+	void ReturnFrameBuffer(std::vector<uint8_t>&& buffer);
+	void LogStats() const;
+
+	RWQueue<ZmbvEncodeTask> frame_fifo{MaxQueuedFrames};
+	std::thread encoder = {};
+	bool is_open        = false;
+
+	std::unique_ptr<VideoCodec> codec = {};
+	ZMBV_FORMAT format                = ZMBV_FORMAT::NONE;
+	std::vector<uint8_t> output       = {};
+
+	int width              = 0;
+	int height             = 0;
+	size_t frame_row_bytes = 0;
+
+	WriteChunkCallback write_chunk = {};
+
+	std::mutex pool_mutex                  = {};
+	std::vector<std::vector<uint8_t>> pool = {};
+
+	struct {
+		// Only updated on the emulation thread
+		uint32_t num_frames_queued = 0;
+		uint32_t num_stalls        = 0;
+		size_t max_queue_depth     = 0;
+
+		// Only updated on the encoder thread
+		uint32_t num_frames_encoded = 0;
+		uint32_t num_frames_failed  = 0;
+	} stats = {};
+};
+
+#endif // DOSBOX_ZMBV_ENCODER_H
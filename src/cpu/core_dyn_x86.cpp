@@ -308,11 +308,19 @@ restart_core:
 	if (!chandler) {
 		return sync_dh_fpu_and_run_normal_core();
 	}
+	/* Translate the blocks recorded for this page in earlier sessions */
+	if (!chandler->is_profile_checked) {
+		chandler->Pretranslate(ip_point);
+	}
 	/* Find correct Dynamic Block to run */
 	CacheBlock * block=chandler->FindCacheBlock(ip_point&4095);
-	if (!block) {
+	if (block) {
+		++cache_stats.blocks_found;
+		cache_touch_block(block);
+	} else {
 		if (!chandler->invalidation_map || (chandler->invalidation_map[ip_point&4095]<4)) {
 			block=CreateCacheBlock(chandler,ip_point,32);
+			++cache_stats.blocks_translated;
 		} else {
 			int32_t old_cycles=CPU_Cycles;
 			CPU_Cycles=1;
@@ -388,6 +396,8 @@ run_block:
 				block=temp_handler->FindCacheBlock(temp_ip & 4095);
 				if (!block || !cache.block.running) goto restart_core;
 				cache.block.running->LinkTo(ret==BR_Link2,block);
+				++cache_stats.blocks_linked;
+				cache_touch_block(block);
 				goto run_block;
 			}
 		}
@@ -482,6 +492,16 @@ void CPU_Core_Dyn_X86_Cache_Init(bool enable_cache) {
 	cache_init(enable_cache);
 }
 
+void CPU_Core_Dyn_X86_Cache_SetSize(const size_t num_megabytes)
+{
+	cache_set_size(num_megabytes * 1024 * 1024);
+}
+
+void CPU_Core_Dyn_X86_Cache_EnableProfile(const bool enable)
+{
+	cache_enable_profile(enable);
+}
+
 void CPU_Core_Dyn_X86_Cache_Close(void) {
 	cache_close();
 }
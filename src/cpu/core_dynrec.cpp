@@ -181,6 +181,8 @@ CacheBlock *LinkBlocks(BlockReturn ret)
 
 	// found it, link the current block to
 	cache.block.running->LinkTo(ret == BR_Link2, cache_block);
+	++cache_stats.blocks_linked;
+	cache_touch_block(cache_block);
 	return cache_block;
 }
 
@@ -219,14 +221,23 @@ Bits CPU_Core_Dynrec_Run() noexcept
 			return CPU_Core_Normal_Run();
 		}
 
+		// translate the blocks recorded for this page in earlier sessions
+		if (!chandler->is_profile_checked) {
+			chandler->Pretranslate(ip_point);
+		}
+
 		// find correct Dynamic Block to run
 		CacheBlock *block = chandler->FindCacheBlock(ip_point & 4095);
-		if (!block) {
+		if (block) {
+			++cache_stats.blocks_found;
+			cache_touch_block(block);
+		} else {
 			// no block found, thus translate the instruction stream
 			// unless the instruction is known to be modified
 			if (!chandler->invalidation_map || (chandler->invalidation_map[ip_point&4095]<4)) {
 				// translate up to 32 instructions
 				block=CreateCacheBlock(chandler,ip_point,32);
+				++cache_stats.blocks_translated;
 			} else {
 				// let the normal core handle this instruction to avoid zero-sized blocks
 				Bitu old_cycles=CPU_Cycles;
@@ -351,6 +362,16 @@ void CPU_Core_Dynrec_Cache_Init(bool enable_cache) {
 	cache_init(enable_cache);
 }
 
+void CPU_Core_Dynrec_Cache_SetSize(const size_t num_megabytes)
+{
+	cache_set_size(num_megabytes * 1024 * 1024);
+}
+
+void CPU_Core_Dynrec_Cache_EnableProfile(const bool enable)
+{
+	cache_enable_profile(enable);
+}
+
 void CPU_Core_Dynrec_Cache_Close(void) {
 	cache_close();
 }
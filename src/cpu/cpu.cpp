@@ -83,6 +83,7 @@ static int cpu_cycle_up   = 0;
 static int cpu_cycle_down = 0;
 
 static bool should_hlt_on_idle = false;
+static bool should_skip_polling_loops = false;
 
 int64_t CPU_IODelayRemoved = 0;
 
@@ -107,12 +108,16 @@ void CPU_Core_Simple_Init();
 #if C_DYNAMIC_X86
 void CPU_Core_Dyn_X86_Init();
 void CPU_Core_Dyn_X86_Cache_Init(bool enable_cache);
+void CPU_Core_Dyn_X86_Cache_SetSize(size_t num_megabytes);
+void CPU_Core_Dyn_X86_Cache_EnableProfile(bool enable);
 void CPU_Core_Dyn_X86_Cache_Close();
 void CPU_Core_Dyn_X86_SetFPUMode(bool dh_fpu);
 
 #elif C_DYNREC
 void CPU_Core_Dynrec_Init();
 void CPU_Core_Dynrec_Cache_Init(bool enable_cache);
+void CPU_Core_Dynrec_Cache_SetSize(size_t num_megabytes);
+void CPU_Core_Dynrec_Cache_EnableProfile(bool enable);
 void CPU_Core_Dynrec_Cache_Close();
 #endif
 
@@ -2774,6 +2779,14 @@ static Bits hlt_decode()
 	return 0;
 }
 
+bool CPU_IsHaltedWaitingForInterrupt()
+{
+	// An interrupt moves CS:EIP away from the HLT before the decoder gets
+	// restored
+	return cpudecoder == &hlt_decode && (reg_flags & FLAG_IF) &&
+	       reg_eip == cpu.hlt.eip && SegValue(cs) == cpu.hlt.cs;
+}
+
 void CPU_HLT(Bitu oldeip)
 {
 	reg_eip = oldeip;
@@ -3683,6 +3696,17 @@ public:
 		const std::string cpu_core = secprop->GetString("core");
 		const std::string cpu_type = secprop->GetString("cputype");
 
+#if C_DYNAMIC_X86
+		CPU_Core_Dyn_X86_Cache_SetSize(check_cast<size_t>(
+		        secprop->GetInt("dynamic_core_cache_size")));
+		CPU_Core_Dyn_X86_Cache_EnableProfile(
+		        secprop->GetBool("dynamic_core_translation_profile"));
+#elif C_DYNREC
+		CPU_Core_Dynrec_Cache_SetSize(check_cast<size_t>(
+		        secprop->GetInt("dynamic_core_cache_size")));
+		CPU_Core_Dynrec_Cache_EnableProfile(
+		        secprop->GetBool("dynamic_core_translation_profile"));
+#endif
 		ConfigureCpuCore(cpu_core);
 		ConfigureCpuType(cpu_core, cpu_type);
 
@@ -3719,6 +3743,8 @@ public:
 
 		should_hlt_on_idle = secprop->GetBool("cpu_idle");
 
+		should_skip_polling_loops = secprop->GetBool("cpu_skip_polling");
+
 		TITLEBAR_NotifyCyclesChanged();
 
 		return true;
@@ -3856,6 +3882,25 @@ void init_cpu_config_settings(SectionProp& secprop)
 	        "            Programs that self-modify their code might misbehave or crash on\n"
 	        "            the 'dynamic' core; use the 'normal' core for such programs.");
 
+#if C_DYNAMIC_X86 || C_DYNREC
+	auto cache_size = secprop.AddInt("dynamic_core_cache_size", OnlyAtStart, 8);
+	cache_size->SetMinMax(4, 64);
+	cache_size->SetHelp(
+	        "Size of the translated code cache of the 'dynamic' core in megabytes, 4 to 64\n"
+	        "(8 by default). Large protected mode programs that keep retranslating their\n"
+	        "code may run faster with a larger cache; the 'DYNCACHE' debug log lines at\n"
+	        "exit show how much of the cache was in use and how often it filled up.");
+
+	auto translation_profile = secprop.AddBool("dynamic_core_translation_profile",
+	                                           OnlyAtStart,
+	                                           false);
+	translation_profile->SetHelp(
+	        "Remember which code the 'dynamic' core runs most and translate it in one go\n"
+	        "when the same code is run again in a later session ('off' by default).\n"
+	        "This shortens the warm-up of programs that run a lot of code. The profile is\n"
+	        "stored in the configuration directory as 'dynamic-core-profile.bin'.");
+#endif
+
 	pstring = secprop.AddString("cputype", Always, "auto");
 	pstring->SetValues(
 	        {"auto", "386", "386_fast", "386_prefetch", "486", "pentium", "pentium_mmx"});
@@ -3996,6 +4041,15 @@ void init_cpu_config_settings(SectionProp& secprop)
 	        "idle ('on' by default). This is done by emulating the HLT CPU instruction, so\n"
 	        "it might interfere with other power management tools such as DOSidle and FDAPM\n"
 	        "when enabled.");
+
+	pbool = secprop.AddBool("cpu_skip_polling", Always, false);
+	pbool->SetHelp(
+	        "Reduce the CPU usage of programs busy-waiting on hardware status ports, such as\n"
+	        "the VGA retrace polling many games do ('off' by default). Tight loops reading\n"
+	        "the same unchanging value are fast-forwarded to the point where the value can\n"
+	        "change, so the emulated timing stays the same, but the program executes fewer\n"
+	        "loop iterations. This can confuse the rare programs that measure the speed of\n"
+	        "the CPU by counting the iterations of such loops.");
 }
 
 bool CPU_ShouldHltOnIdle()
@@ -4005,6 +4059,11 @@ bool CPU_ShouldHltOnIdle()
 	return should_hlt_on_idle && (reg_flags & FLAG_IF);
 }
 
+bool CPU_ShouldSkipPollingLoops()
+{
+	return should_skip_polling_loops;
+}
+
 void CPU_AddConfigSection(const ConfigPtr& conf)
 {
 	assert(conf);
@@ -585,4 +585,11 @@ void CPU_SetFlagsw(const uint32_t word);
 // program is idle
 bool CPU_ShouldHltOnIdle();
 
+// Whether tight loops polling a port for a change are fast-forwarded to the
+// time the port's value can change
+bool CPU_ShouldSkipPollingLoops();
+
+// True while the CPU is waiting in HLT for the next interrupt
+bool CPU_IsHaltedWaitingForInterrupt();
+
 #endif
@@ -2,13 +2,19 @@
 // SPDX-FileCopyrightText:  2002-2021 The DOSBox Team
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <cassert>
 #include <cerrno>
+#include <fstream>
 #include <new>
 #include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 #include "utils/mem_unaligned.h"
 #include "cpu/paging.h"
+#include "misc/cross.h"
+#include "misc/std_filesystem.h"
 #include "misc/types.h"
 
 #if defined(HAVE_MMAP)
@@ -99,6 +105,10 @@ public:
 	} link[2] = {};                // maximum two links (conditional jumps)
 
 	CacheBlock* crossblock = {};
+
+	// Saturating count of how often the block was dispatched to; used to
+	// keep hot blocks alive when the cache wraps around
+	uint8_t use_count = 0;
 };
 
 static_assert(std::is_standard_layout_v<CacheBlock::Page>, "standard-layout is required for offsetof");
@@ -129,14 +139,100 @@ static struct {
 	CodePageHandler* last_page  = {}; // the last used page
 } cache = {};
 
+// Translation statistics, reported when the cache is closed
+static struct {
+	uint64_t blocks_found       = 0; // lookups served by an existing block
+	uint64_t blocks_translated  = 0; // lookups that had to translate
+	uint64_t blocks_linked      = 0; // direct links made between blocks
+	uint64_t blocks_invalidated = 0; // cleared by self-modifying code
+	uint64_t blocks_evicted     = 0; // overwritten to make room
+	uint64_t hot_blocks_kept    = 0; // passed over instead of evicted
+	uint64_t cache_wraps        = 0; // times the cache filled up
+
+	uint64_t pages_pretranslated  = 0; // pages found in the profile
+	uint64_t blocks_pretranslated = 0; // blocks translated ahead of use
+} cache_stats = {};
+
+// A block dispatched at least this often since the allocation point last
+// passed it gets a second chance instead of being overwritten
+constexpr uint8_t HotBlockUses = 4;
+
+// Bound the search for cold blocks so allocation stays cheap when most of
+// the cache is hot
+constexpr int MaxHotBlocksSkipped = 16;
+
+static inline void cache_touch_block(CacheBlock* block)
+{
+	if (block->use_count < UINT8_MAX) {
+		++block->use_count;
+	}
+}
+
 // cache memory pointers, to be malloc'd later
 static uint8_t* cache_code_start_ptr   = {};
 static uint8_t* cache_code             = {};
 static uint8_t* cache_code_link_blocks = {};
 
-static std::vector<CacheBlock> cache_blocks(CACHE_BLOCKS);
+// The code cache size can be configured until the cache is first set up;
+// the number of block descriptors scales with it
+static size_t cache_total_size = CACHE_TOTAL;
+static size_t cache_num_blocks = CACHE_BLOCKS;
+
+static std::vector<CacheBlock> cache_blocks = {};
 static CacheBlock link_blocks[2] = {}; // default linking (specially marked)
 
+// The opt-in translation profile carries the hot blocks over to later
+// sessions. The translated code itself can't be stored, as it refers to the
+// emulator's state and helpers by their host addresses, which differ from run
+// to run. Instead, the profile holds the start offsets of the hot blocks of
+// each code page, keyed by a hash of the page's contents and code size. When a
+// page with the same contents is first run again, its recorded blocks are
+// translated in one go instead of one at a time as execution reaches them.
+//
+// Only blocks that end in their own page are recorded, so translating them
+// again never reads past the bytes the page's hash covers. Correctness doesn't
+// depend on the hash: the blocks are always translated from the current code.
+static struct {
+	bool is_enabled = false;
+	bool is_changed = false;
+
+	// Sorted start offsets of the hot blocks, by page key
+	std::unordered_map<uint64_t, std::vector<uint16_t>> pages = {};
+} translation_profile = {};
+
+constexpr char TranslationProfileName[]       = "dynamic-core-profile.bin";
+constexpr char TranslationProfileMagic[8]     = {'D', 'B', 'D', 'Y', 'N', 'P', 'F', '1'};
+constexpr uint32_t TranslationProfileByteOrder = 0x01020304;
+
+// Keep the profile bounded when running many different programs
+constexpr size_t MaxProfilePages = 64 * 1024;
+
+struct translation_profile_header_t {
+	char magic[8]            = {};
+	uint32_t byte_order_mark = 0;
+	uint32_t num_pages       = 0;
+};
+
+// Each page is stored as its key, the number of offsets, and the offsets
+struct translation_profile_page_t {
+	uint64_t key         = 0;
+	uint32_t num_offsets = 0;
+	uint32_t reserved    = 0;
+};
+
+static uint64_t cache_get_page_key(const uint8_t* page_bytes, const bool is_code32)
+{
+	// 64-bit FNV-1a
+	uint64_t hash = 0xcbf29ce484222325;
+	for (auto i = 0; i < 4096; ++i) {
+		hash = (hash ^ page_bytes[i]) * 0x100000001b3;
+	}
+	return is_code32 ? ~hash : hash;
+}
+
+static CacheBlock* CreateCacheBlock(CodePageHandler* codepage, PhysPt start,
+                                    Bitu max_opcodes);
+
 // the CodePageHandler class provides access to the contained
 // cache blocks and intercepts writes to the code for special treatment
 class CodePageHandler final : public PageHandler {
@@ -159,6 +255,7 @@ public:
 
 		active_blocks=0;
 		active_count=16;
+		is_profile_checked = false;
 
 		// initialize the maps with zero (no cache blocks as well as
 		// code present)
@@ -198,6 +295,7 @@ public:
 					block->Clear(); // clear the block,
 					                // decrements the
 					                // write_map accordingly
+					++cache_stats.blocks_invalidated;
 				}
 				block=nextblock;
 			}
@@ -487,6 +585,8 @@ public:
 
 	void ClearRelease()
 	{
+		RecordProfile();
+
 		// clear out all cache blocks in this page
 		Bitu count=active_blocks;
 		CacheBlock **map=hash_map;
@@ -513,6 +613,13 @@ public:
 		return nullptr; // none found
 	}
 
+	// note the hot blocks of this page in the translation profile
+	void RecordProfile() const;
+
+	// translate the blocks recorded in the translation profile for the
+	// current contents of this page, given the address being run
+	void Pretranslate(PhysPt lin_addr);
+
 	HostPt GetHostReadPt(Bitu phys_page) override
 	{
 		hostmem = old_pagehandler->GetHostReadPt(phys_page);
@@ -533,6 +640,9 @@ public:
 	CodePageHandler *prev = nullptr;
 	CodePageHandler *next = nullptr;
 
+	// the translation profile has been checked for this page
+	bool is_profile_checked = false;
+
 private:
 	PageHandler *old_pagehandler = nullptr;
 
@@ -641,6 +751,78 @@ inline void CacheBlock::Cache::AddDwordToWriteMaskAt(const size_t page_index)
 	add_to_unaligned_uint32(wmapmask + map_offset, 0x01010101);
 }
 
+void CodePageHandler::RecordProfile() const
+{
+	if (!translation_profile.is_enabled) {
+		return;
+	}
+	// skip index 0, which holds the blocks continued from the previous page
+	std::vector<uint16_t> offsets = {};
+	for (auto index = 1; index <= DYN_PAGE_HASH; ++index) {
+		for (auto block = hash_map[index]; block; block = block->hash.next) {
+			if (!block->crossblock && block->use_count >= HotBlockUses) {
+				offsets.push_back(block->page.start);
+			}
+		}
+	}
+	if (offsets.empty()) {
+		return;
+	}
+	const auto page_bytes = old_pagehandler->GetHostReadPt(phys_page);
+	if (!page_bytes) {
+		return;
+	}
+	const auto key = cache_get_page_key(page_bytes, flags & PFLAG_HASCODE32);
+
+	auto& pages = translation_profile.pages;
+	if (!pages.contains(key) && pages.size() >= MaxProfilePages) {
+		return;
+	}
+	auto& recorded = pages[key];
+	const auto num_recorded = recorded.size();
+
+	recorded.insert(recorded.end(), offsets.begin(), offsets.end());
+	std::sort(recorded.begin(), recorded.end());
+	recorded.erase(std::unique(recorded.begin(), recorded.end()),
+	               recorded.end());
+
+	if (recorded.size() != num_recorded) {
+		translation_profile.is_changed = true;
+	}
+}
+
+void CodePageHandler::Pretranslate(const PhysPt lin_addr)
+{
+	is_profile_checked = true;
+
+	if (translation_profile.pages.empty()) {
+		return;
+	}
+	// the page might have been set up for the other code size
+	const bool is_code32 = flags & PFLAG_HASCODE32;
+	if (is_code32 != cpu.code.big) {
+		return;
+	}
+	const auto page_bytes = old_pagehandler->GetHostReadPt(phys_page);
+	if (!page_bytes) {
+		return;
+	}
+	const auto page = translation_profile.pages.find(
+	        cache_get_page_key(page_bytes, is_code32));
+	if (page == translation_profile.pages.end()) {
+		return;
+	}
+
+	const auto page_start = lin_addr & ~static_cast<PhysPt>(4095);
+	for (const auto offset : page->second) {
+		if (!FindCacheBlock(offset)) {
+			CreateCacheBlock(this, page_start + offset, 32);
+			++cache_stats.blocks_pretranslated;
+		}
+	}
+	++cache_stats.pages_pretranslated;
+}
+
 void CacheBlock::Clear()
 {
 	Bitu ind;
@@ -687,14 +869,64 @@ void CacheBlock::Clear()
 	cache.DeleteWriteMask();
 }
 
+// True if no new block may start at the given block, so allocation has to
+// wrap around to the start of the cache
+static bool cache_is_past_end(const CacheBlock* block)
+{
+#if (C_DYNAMIC_X86)
+	return !block;
+#elif (C_DYNREC)
+	const uint8_t* limit = (cache_code_start_ptr + cache_total_size - CACHE_MAXSIZE);
+	return !block || block->cache.start > limit;
+#endif
+}
+
+// Second-chance eviction: move the allocation point past hot blocks that
+// the next block would overwrite, halving their use counts so they age out
+// once they go cold.
+static void cache_skip_hot_blocks()
+{
+	CacheBlock* start = cache.block.active;
+	CacheBlock* block = start;
+	Bitu size         = 0;
+
+	auto num_skipped = 0;
+	while (block && size < CACHE_MAXSIZE) {
+		const auto is_hot = block->page.handler &&
+		                    block->use_count >= HotBlockUses;
+
+		if (is_hot && num_skipped < MaxHotBlocksSkipped) {
+			block->use_count /= 2;
+			++num_skipped;
+			++cache_stats.hot_blocks_kept;
+
+			start = block->cache.next;
+			if (cache_is_past_end(start)) {
+				start = cache.block.first;
+				++cache_stats.cache_wraps;
+			}
+			block = start;
+			size  = 0;
+			continue;
+		}
+		size += block->cache.size;
+		block = block->cache.next;
+	}
+	cache.block.active = start;
+}
+
 static CacheBlock *cache_openblock()
 {
+	cache_skip_hot_blocks();
+
 	CacheBlock *block = cache.block.active;
 	// check for enough space in this block
 	Bitu size=block->cache.size;
 	CacheBlock *nextblock = block->cache.next;
-	if (block->page.handler)
+	if (block->page.handler) {
 		block->Clear();
+		++cache_stats.blocks_evicted;
+	}
 	// block size must be at least CACHE_MAXSIZE
 	while (size<CACHE_MAXSIZE) {
 		if (!nextblock)
@@ -702,8 +934,10 @@ static CacheBlock *cache_openblock()
 		// merge blocks
 		size+=nextblock->cache.size;
 		CacheBlock *tempblock = nextblock->cache.next;
-		if (nextblock->page.handler)
+		if (nextblock->page.handler) {
 			nextblock->Clear();
+			++cache_stats.blocks_evicted;
+		}
 		// block is free now
 		cache_add_unused_block(nextblock);
 		nextblock=tempblock;
@@ -752,17 +986,13 @@ static void cache_closeblock()
 			block->cache.size=new_size;
 		}
 	}
+	block->use_count = 0;
+
 	// advance the active block pointer
-#if (C_DYNAMIC_X86)
-	const bool cache_is_full = !block->cache.next;
-#elif (C_DYNREC)
-	const uint8_t *limit = (cache_code_start_ptr + CACHE_TOTAL - CACHE_MAXSIZE);
-	const bool cache_is_full = (!block->cache.next ||
-	                            (block->cache.next->cache.start > limit));
-#endif
-	if (cache_is_full) {
+	if (cache_is_past_end(block->cache.next)) {
 		// LOG_DEBUG("Cache full; restarting");
 		cache.block.active=cache.block.first;
+		++cache_stats.cache_wraps;
 	} else {
 		cache.block.active=block->cache.next;
 	}
@@ -841,7 +1071,10 @@ static void cache_block_before_close();
 static void cache_block_closing(const uint8_t *block_start, Bitu block_size);
 #endif
 
-static constexpr size_t cache_code_size = CACHE_TOTAL + CACHE_MAXSIZE + HostPageSize - 1 + HostPageSize;
+static size_t cache_code_size()
+{
+	return cache_total_size + CACHE_MAXSIZE + HostPageSize - 1 + HostPageSize;
+}
 constexpr bool is_64bit_platform = sizeof(void *) == 8;
 
 static inline void dyn_mem_adjust(void *&ptr, size_t &size)
@@ -950,6 +1183,130 @@ static inline void dyn_cache_invalidate([[maybe_unused]] void *ptr,
 
 static bool cache_initialized = false;
 
+static void cache_set_size(const size_t num_bytes)
+{
+	// The cache memory is allocated only once
+	if (cache_initialized) {
+		return;
+	}
+	assert(num_bytes >= CACHE_MAXSIZE * 2);
+
+	cache_total_size = num_bytes;
+	cache_num_blocks = static_cast<size_t>(CACHE_BLOCKS) * num_bytes / CACHE_TOTAL;
+}
+
+static std_fs::path cache_get_profile_path()
+{
+	return get_config_dir() / TranslationProfileName;
+}
+
+static void cache_load_profile()
+{
+	std::ifstream profile_file(cache_get_profile_path(), std::ios::binary);
+	if (!profile_file) {
+		return;
+	}
+
+	translation_profile_header_t header = {};
+	if (!profile_file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+		return;
+	}
+	if (!std::equal(std::begin(header.magic),
+	                std::end(header.magic),
+	                std::begin(TranslationProfileMagic)) ||
+	    header.byte_order_mark != TranslationProfileByteOrder ||
+	    header.num_pages > MaxProfilePages) {
+		LOG_WARNING("DYNCACHE: Ignoring invalid translation profile");
+		return;
+	}
+
+	auto& pages = translation_profile.pages;
+	for (uint32_t i = 0; i < header.num_pages; ++i) {
+		translation_profile_page_t page = {};
+		if (!profile_file.read(reinterpret_cast<char*>(&page), sizeof(page)) ||
+		    page.num_offsets == 0 || page.num_offsets > 4096) {
+			break;
+		}
+		std::vector<uint16_t> offsets(page.num_offsets);
+		const auto num_bytes = static_cast<std::streamsize>(
+		        offsets.size() * sizeof(uint16_t));
+		if (!profile_file.read(reinterpret_cast<char*>(offsets.data()),
+		                       num_bytes)) {
+			break;
+		}
+		// The offsets have to be in order and inside the page
+		const auto is_valid = std::adjacent_find(offsets.begin(),
+		                                         offsets.end(),
+		                                         std::greater_equal<>()) ==
+		                              offsets.end() &&
+		                      offsets.back() < 4096;
+		if (!is_valid) {
+			break;
+		}
+		pages[page.key] = std::move(offsets);
+	}
+	if (pages.size() != header.num_pages) {
+		LOG_WARNING("DYNCACHE: Ignoring invalid translation profile");
+		pages.clear();
+		return;
+	}
+	LOG_MSG("DYNCACHE: Loaded the translation profile of %zu code pages",
+	        pages.size());
+}
+
+// Writing the profile is best effort, as the configuration directory might be
+// read-only
+static void cache_save_profile()
+{
+	for (auto page = cache.used_pages; page; page = page->next) {
+		page->RecordProfile();
+	}
+	if (!translation_profile.is_changed) {
+		return;
+	}
+	translation_profile.is_changed = false;
+
+	const auto profile_path = cache_get_profile_path();
+
+	std::ofstream profile_file(profile_path, std::ios::binary | std::ios::trunc);
+	if (!profile_file) {
+		return;
+	}
+
+	translation_profile_header_t header = {};
+	std::copy(std::begin(TranslationProfileMagic),
+	          std::end(TranslationProfileMagic),
+	          header.magic);
+	header.byte_order_mark = TranslationProfileByteOrder;
+	header.num_pages = static_cast<uint32_t>(translation_profile.pages.size());
+	profile_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	for (const auto& [key, offsets] : translation_profile.pages) {
+		translation_profile_page_t page = {};
+		page.key         = key;
+		page.num_offsets = static_cast<uint32_t>(offsets.size());
+		profile_file.write(reinterpret_cast<const char*>(&page), sizeof(page));
+		profile_file.write(reinterpret_cast<const char*>(offsets.data()),
+		                   static_cast<std::streamsize>(
+		                           offsets.size() * sizeof(uint16_t)));
+	}
+	profile_file.close();
+
+	// Don't leave a truncated profile behind
+	if (profile_file.fail()) {
+		std::error_code ec = {};
+		std_fs::remove(profile_path, ec);
+	}
+}
+
+// The translation profile can be enabled until the cache is first set up
+static void cache_enable_profile(const bool enable)
+{
+	if (!cache_initialized) {
+		translation_profile.is_enabled = enable;
+	}
+}
+
 static void cache_init(bool enable) {
 	if (enable) {
 		// see if cache is already initialized
@@ -957,9 +1314,13 @@ static void cache_init(bool enable) {
 			return;
 		}
 		cache_initialized = true;
+		if (translation_profile.is_enabled) {
+			cache_load_profile();
+		}
+		cache_blocks = std::vector<CacheBlock>(cache_num_blocks);
 		cache.block.free = &cache_blocks[0];
 		// initialize the cache blocks
-		for (int i=0;i<CACHE_BLOCKS-1;i++) {
+		for (size_t i = 0; i < cache_num_blocks - 1; i++) {
 			cache_blocks[i].link[0].to = (CacheBlock *)1;
 			cache_blocks[i].link[1].to = (CacheBlock *)1;
 			cache_blocks[i].cache.next = &cache_blocks[i + 1];
@@ -969,11 +1330,11 @@ static void cache_init(bool enable) {
 #if defined (WIN32)
 			LPVOID lp_vmem = nullptr;
 			if (CPU_UseRwxMemProtect) {
-				lp_vmem = VirtualAlloc(nullptr, cache_code_size,
+				lp_vmem = VirtualAlloc(nullptr, cache_code_size(),
 				                       MEM_COMMIT,
 				                       PAGE_EXECUTE_READWRITE); // all operations allowed
 			} else {
-				lp_vmem = VirtualAlloc(nullptr, cache_code_size,
+				lp_vmem = VirtualAlloc(nullptr, cache_code_size(),
 				                       MEM_COMMIT | MEM_RESERVE,
 				                       PAGE_READWRITE); // needs on-going management
 			}
@@ -985,12 +1346,12 @@ static void cache_init(bool enable) {
 #if defined(HAVE_MAP_JIT)
 			map_flags |= MAP_JIT;
 #endif
-			cache_code_start_ptr=static_cast<uint8_t *>(mmap(nullptr, cache_code_size, prot_flags, map_flags, -1, 0));
+			cache_code_start_ptr=static_cast<uint8_t *>(mmap(nullptr, cache_code_size(), prot_flags, map_flags, -1, 0));
 			if (cache_code_start_ptr == MAP_FAILED) {
 				E_Exit("DYNCACHE: Failed memory-mapping cache memory because: %s", strerror(errno));
 			}
 #else
-			cache_code_start_ptr=static_cast<uint8_t *>(malloc(cache_code_size));
+			cache_code_start_ptr=static_cast<uint8_t *>(malloc(cache_code_size()));
 			if (!cache_code_start_ptr) {
 				E_Exit("DYNCACHE: Failed allocating cache memory because: %s", strerror(errno));
 			}
@@ -1006,7 +1367,7 @@ static void cache_init(bool enable) {
 			cache.block.first=block;
 			cache.block.active=block;
 			block->cache.start=&cache_code[0];
-			block->cache.size=CACHE_TOTAL;
+			block->cache.size = cache_total_size;
 			block->cache.next = nullptr; // last block in the list
 		}
 
@@ -1067,7 +1428,56 @@ static void cache_init(bool enable) {
 	}
 }
 
+static size_t cache_get_bytes_in_use()
+{
+	size_t num_bytes = 0;
+	for (auto block = cache.block.first; block; block = block->cache.next) {
+		if (block->page.handler) {
+			num_bytes += block->cache.size;
+		}
+	}
+	return num_bytes;
+}
+
+static void cache_log_stats()
+{
+	const auto num_lookups = cache_stats.blocks_found +
+	                         cache_stats.blocks_translated;
+	if (num_lookups == 0) {
+		return;
+	}
+	LOG_DEBUG("DYNCACHE: %zu of %zu KB in use; %llu block lookups, %.1f%% hits",
+	          cache_get_bytes_in_use() / 1024,
+	          cache_total_size / 1024,
+	          static_cast<unsigned long long>(num_lookups),
+	          100.0 * static_cast<double>(cache_stats.blocks_found) /
+	                  static_cast<double>(num_lookups));
+
+	LOG_DEBUG("DYNCACHE: Translated %llu, linked %llu, invalidated %llu, "
+	          "evicted %llu, kept %llu hot blocks; cache filled up %llu times",
+	          static_cast<unsigned long long>(cache_stats.blocks_translated),
+	          static_cast<unsigned long long>(cache_stats.blocks_linked),
+	          static_cast<unsigned long long>(cache_stats.blocks_invalidated),
+	          static_cast<unsigned long long>(cache_stats.blocks_evicted),
+	          static_cast<unsigned long long>(cache_stats.hot_blocks_kept),
+	          static_cast<unsigned long long>(cache_stats.cache_wraps));
+
+	if (translation_profile.is_enabled) {
+		LOG_DEBUG("DYNCACHE: Translated %llu blocks ahead of use in %llu "
+		          "pages from the translation profile",
+		          static_cast<unsigned long long>(cache_stats.blocks_pretranslated),
+		          static_cast<unsigned long long>(cache_stats.pages_pretranslated));
+	}
+}
+
 static void cache_close(void) {
+	cache_log_stats();
+	cache_stats = {};
+
+	if (translation_profile.is_enabled) {
+		cache_save_profile();
+	}
+
 /*	for (;;) {
 		if (cache.used_pages) {
 			CodePageHandler * cpage=cache.used_pages;
@@ -7,18 +7,26 @@
 
 #include "dosbox.h"
 
+#include <compare>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "audio/mixer.h"
 #include "hardware/memory.h"
 #include "misc/support.h"
+#include "utils/mapped_file.h"
 #include "utils/rwqueue.h"
 
 #include "decoders/SDL_sound.h"
@@ -198,8 +206,12 @@ private:
 		virtual bool read(uint8_t* buffer, const uint32_t offset,
 		                  const uint32_t requested_bytes) = 0;
 		virtual bool seek(const uint32_t offset)          = 0;
+		// Returns the number of frames decoded from the track. Frames
+		// that aren't available yet are filled with silence and
+		// counted in `silent_frames`; they don't advance the position.
 		virtual uint32_t decode(int16_t* buffer,
-		                        const uint32_t desired_track_frames) = 0;
+		                        const uint32_t desired_track_frames,
+		                        uint32_t& silent_frames) = 0;
 		virtual uint16_t getEndian()                = 0;
 		virtual uint32_t getRate()                  = 0;
 		virtual uint8_t getChannels()               = 0;
@@ -222,7 +234,8 @@ private:
 		          const uint32_t requested_bytes) override;
 		bool seek(const uint32_t offset) override;
 		uint32_t decode(int16_t* buffer,
-		                const uint32_t desired_track_frames) override;
+		                const uint32_t desired_track_frames,
+		                uint32_t& silent_frames) override;
 		uint16_t getEndian() override;
 		uint32_t getRate() override
 		{
@@ -239,12 +252,94 @@ private:
 		}
 
 	private:
+		// The image is read through a memory mapping when possible,
+		// otherwise through the file stream
+		std::unique_ptr<MappedFile> mapping = {};
 		std::ifstream* file;
 	};
 
+	class AudioFile;
+
+	// Decodes the compressed audio tracks of the image in the background,
+	// so seeking and starting playback don't stall the caller while the
+	// codec seeks and decodes. A single thread, started when audio is
+	// first requested, decodes the track being played into blocks of one
+	// second of PCM frames, in the track's own format, starting with the
+	// block being played and then the blocks after it. The first block of
+	// every track is decoded when the thread starts and kept, so starting
+	// or restarting a track plays from memory.
+	class AudioDecoder {
+	public:
+		AudioDecoder() = default;
+		~AudioDecoder();
+
+		AudioDecoder(const AudioDecoder&)            = delete;
+		AudioDecoder& operator=(const AudioDecoder&) = delete;
+
+		// Copies decoded PCM frames of the file and returns the
+		// number of frames copied, which is less than requested at
+		// the end of the track, or if a block isn't decoded yet and
+		// `should_wait` is false; the blocks after the last copied
+		// one are requested to be decoded ahead
+		uint32_t CopyFrames(AudioFile* file, uint64_t first_frame,
+		                    uint8_t* buffer, uint32_t num_frames,
+		                    bool should_wait, bool& is_track_end);
+
+		// Makes the file the one being decoded, starting with the
+		// given block
+		void RequestBlock(AudioFile* file, uint32_t index);
+
+		// Keeps the block holding the start of a track decoded, once
+		// it has been, instead of evicting it
+		void AddTrackStart(AudioFile* file, uint32_t redbook_pos);
+
+		// Drops the decoded blocks of the file, after waiting for
+		// the block being decoded, if it's from the file
+		void RemoveFile(AudioFile* file);
+
+	private:
+		// Not counting the blocks with the starts of the tracks
+		static constexpr size_t MaxDecodedBlocks  = 8;
+		static constexpr uint32_t ReadAheadBlocks = 2;
+
+		// Audio files can hold several tracks, so the blocks are
+		// counted from the start of the file
+		struct BlockKey {
+			AudioFile* file = nullptr;
+			uint32_t index  = 0;
+
+			auto operator<=>(const BlockKey&) const = default;
+		};
+
+		struct DecodedBlock {
+			std::vector<uint8_t> pcm = {};
+			uint64_t last_use        = 0;
+		};
+
+		void QueueBlock(AudioFile* file, uint32_t index, bool is_urgent);
+		void DecoderLoop();
+
+		std::thread thread                              = {};
+		std::mutex mutex                                = {};
+		std::condition_variable request_waiter          = {};
+		std::condition_variable block_ready_waiter      = {};
+		std::map<BlockKey, DecodedBlock> decoded_blocks = {};
+
+		std::set<BlockKey> track_start_blocks = {};
+
+		// Blocks to decode of the file being played, and the starts
+		// of the tracks
+		AudioFile* active_file                = nullptr;
+		std::deque<BlockKey> requested_blocks = {};
+
+		AudioFile* decoding_file = nullptr;
+		uint64_t use_counter     = 0;
+		bool should_exit         = false;
+	};
+
 	class AudioFile final : public TrackFile {
 	public:
-		AudioFile(const char* filename, bool& error);
+		AudioFile(const char* filename, bool& error, AudioDecoder& decoder);
 		~AudioFile() override;
 
 		AudioFile()                 = delete;
@@ -256,7 +351,8 @@ private:
 		          const uint32_t requested_bytes) override;
 		bool seek(const uint32_t offset) override;
 		uint32_t decode(int16_t* buffer,
-		                const uint32_t desired_track_frames) override;
+		                const uint32_t desired_track_frames,
+		                uint32_t& silent_frames) override;
 		uint16_t getEndian() override;
 		uint32_t getRate() override;
 		uint8_t getChannels() override;
@@ -266,7 +362,20 @@ private:
 		void setAudioPosition([[maybe_unused]] uint32_t pos) override {}
 
 	private:
-		Sound_Sample* sample = nullptr;
+		friend class AudioDecoder;
+
+		uint64_t RedbookPosToFrame(uint32_t redbook_pos) const;
+		std::vector<uint8_t> DecodeBlock(uint32_t index);
+
+		Sound_Sample* sample  = nullptr;
+		AudioDecoder& decoder;
+
+		// Only used by the decoder thread
+		uint32_t next_decoder_block = 0;
+
+		uint64_t play_frame       = 0;
+		uint32_t frames_per_block = 0;
+		uint32_t bytes_per_frame  = 0;
 	};
 
 public:
@@ -365,6 +474,9 @@ private:
 	               uint32_t      &totalPregap,
 	               uint32_t      currPregap);
 	// member variables
+
+	// Declared before the tracks, as their audio files use it
+	AudioDecoder         audio_decoder = {};
 	std::vector<Track>   tracks;
 	std::vector<uint8_t> readBuffer;
 	std::string          mcn;
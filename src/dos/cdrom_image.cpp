@@ -27,6 +27,7 @@
 
 #include "audio/channel_names.h"
 #include "config/setup.h"
+#include "decoders/mp3_seek_table.h"
 #include "dos/drives.h"
 #include "utils/fs_utils.h"
 #include "utils/math_utils.h"
@@ -85,6 +86,11 @@ CDROM_Interface_Image::BinaryFile::BinaryFile(const std_fs::path &filename, bool
         : TrackFile(BYTES_PER_RAW_REDBOOK_FRAME),
           file(nullptr)
 {
+	mapping = MappedFile::Map(filename);
+	if (mapping) {
+		error = false;
+		return;
+	}
 	file = new std::ifstream(filename, std::ios::in | std::ios::binary);
 	// If new fails, an exception is generated and scope leaves this constructor
 	error = file->fail();
@@ -105,7 +111,8 @@ bool CDROM_Interface_Image::BinaryFile::read(uint8_t *buffer,
                                              const uint32_t requested_bytes)
 {
 	// Check for logic bugs and illegal values
-	assertm(file && buffer, "The file and/or buffer pointer is invalid");
+	assertm((mapping || file) && buffer,
+	        "The file and/or buffer pointer is invalid");
 	assertm(offset <= MAX_REDBOOK_BYTES, "Requested offset exceeds CDROM size");
 	assertm(requested_bytes <= MAX_REDBOOK_BYTES, "Requested bytes exceeds CDROM size");
 
@@ -113,6 +120,12 @@ bool CDROM_Interface_Image::BinaryFile::read(uint8_t *buffer,
 	if (adjusted_bytes == 0) // no work to do!
 		return true;
 
+	// The adjusted read is inside the mapped track
+	if (mapping) {
+		memcpy(buffer, mapping->GetData().data() + offset, adjusted_bytes);
+		return true;
+	}
+
 	// Reposition if needed
 	if (!seek(offset))
 		return false;
@@ -124,6 +137,12 @@ bool CDROM_Interface_Image::BinaryFile::read(uint8_t *buffer,
 int CDROM_Interface_Image::BinaryFile::getLength()
 {
 	// Return our cached result if we've already been asked before
+	if (length_redbook_bytes < 0 && mapping) {
+		length_redbook_bytes = check_cast<int>(mapping->GetSize());
+
+		assertm(static_cast<uint32_t>(length_redbook_bytes) <= MAX_REDBOOK_BYTES,
+		        "Track length exceeds the maximum CDROM size");
+	}
 	if (length_redbook_bytes < 0 && file) {
 		file->seekg(0, std::ios::end);
 		/**
@@ -153,12 +172,17 @@ uint16_t CDROM_Interface_Image::BinaryFile::getEndian()
 bool CDROM_Interface_Image::BinaryFile::seek(const uint32_t offset)
 {
 	// Check for logic bugs and illegal values
-	assertm(file, "The file pointer needs to be valid, but is the nullptr");
+	assertm(mapping || file, "The file pointer needs to be valid, but is the nullptr");
 	assertm(offset <= MAX_REDBOOK_BYTES, "Requested offset exceeds CDROM size");
 
 	if (!offsetInsideTrack(offset))
 		return false;
 
+	// Reads from the mapping are always absolute
+	if (mapping) {
+		return true;
+	}
+
 	if (static_cast<uint32_t>(file->tellg()) == offset)
 		return true;
 
@@ -174,15 +198,34 @@ bool CDROM_Interface_Image::BinaryFile::seek(const uint32_t offset)
 }
 
 uint32_t CDROM_Interface_Image::BinaryFile::decode(int16_t *buffer,
-                                                   const uint32_t desired_track_frames)
+                                                   const uint32_t desired_track_frames,
+                                                   uint32_t& silent_frames)
 {
 	// Guard against logic bugs and illegal values
-	assertm(buffer && file, "The file pointer or buffer are invalid");
+	assertm(buffer && (mapping || file), "The file pointer or buffer are invalid");
 	assertm(desired_track_frames <= MAX_REDBOOK_FRAMES,
 	        "Requested number of frames exceeds the maximum for a CDROM");
 	assertm(audio_pos < MAX_REDBOOK_BYTES,
 	        "Tried to decode audio before the playback position was set");
 
+	// The image is read synchronously, so there's never a gap to fill
+	silent_frames = 0;
+
+	if (mapping) {
+		const auto image = mapping->GetData();
+		if (audio_pos >= image.size()) {
+			return 0;
+		}
+		const auto bytes_read = std::min(
+		        static_cast<uint32_t>(image.size() - audio_pos),
+		        desired_track_frames * BYTES_PER_REDBOOK_PCM_FRAME);
+
+		memcpy(buffer, image.data() + audio_pos, bytes_read);
+
+		audio_pos += bytes_read;
+		return ceil_udivide(bytes_read, BYTES_PER_REDBOOK_PCM_FRAME);
+	}
+
 	// Reposition against our last audio position if needed
 	if (static_cast<uint32_t>(file->tellg()) != audio_pos)
 		if (!seek(audio_pos))
@@ -203,8 +246,227 @@ uint32_t CDROM_Interface_Image::BinaryFile::decode(int16_t *buffer,
 	return ceil_udivide(bytes_read, BYTES_PER_REDBOOK_PCM_FRAME);
 }
 
-CDROM_Interface_Image::AudioFile::AudioFile(const char *filename, bool &error)
-	: TrackFile(4096)
+CDROM_Interface_Image::AudioDecoder::~AudioDecoder()
+{
+	if (thread.joinable()) {
+		{
+			std::lock_guard lock(mutex);
+			should_exit = true;
+		}
+		request_waiter.notify_all();
+		block_ready_waiter.notify_all();
+		thread.join();
+	}
+}
+
+// Queues a block of the file for decoding; urgent requests are decoded next.
+// Requesting a block of another file makes it the one being decoded and drops
+// the requests of the previous one, except for the starts of the tracks.
+// Must be called with the mutex held.
+void CDROM_Interface_Image::AudioDecoder::QueueBlock(AudioFile* file,
+                                                     const uint32_t index,
+                                                     const bool is_urgent)
+{
+	if (file != active_file) {
+		active_file = file;
+		std::erase_if(requested_blocks, [this](const BlockKey& key) {
+			return !track_start_blocks.contains(key);
+		});
+	}
+	if (!thread.joinable()) {
+		thread = std::thread(&AudioDecoder::DecoderLoop, this);
+		set_thread_name(thread, "dosbox:cdaudio");
+
+		// Decode the starts of the tracks after the requested block
+		requested_blocks.insert(requested_blocks.end(),
+		                        track_start_blocks.begin(),
+		                        track_start_blocks.end());
+	}
+
+	const BlockKey key = {file, index};
+	if (decoded_blocks.contains(key)) {
+		return;
+	}
+	const auto it = std::find(requested_blocks.begin(),
+	                          requested_blocks.end(),
+	                          key);
+	if (it != requested_blocks.end()) {
+		if (!is_urgent) {
+			return;
+		}
+		requested_blocks.erase(it);
+	}
+	if (is_urgent) {
+		requested_blocks.push_front(key);
+	} else {
+		requested_blocks.push_back(key);
+	}
+	request_waiter.notify_one();
+}
+
+void CDROM_Interface_Image::AudioDecoder::RequestBlock(AudioFile* file,
+                                                       const uint32_t index)
+{
+	std::lock_guard lock(mutex);
+	QueueBlock(file, index, true);
+}
+
+void CDROM_Interface_Image::AudioDecoder::AddTrackStart(AudioFile* file,
+                                                        const uint32_t redbook_pos)
+{
+	std::lock_guard lock(mutex);
+
+	const auto index = static_cast<uint32_t>(file->RedbookPosToFrame(redbook_pos) /
+	                                         file->frames_per_block);
+	const BlockKey key = {file, index};
+	if (track_start_blocks.insert(key).second && thread.joinable() &&
+	    !decoded_blocks.contains(key)) {
+		requested_blocks.push_back(key);
+		request_waiter.notify_one();
+	}
+}
+
+void CDROM_Interface_Image::AudioDecoder::RemoveFile(AudioFile* file)
+{
+	std::unique_lock lock(mutex);
+
+	if (active_file == file) {
+		active_file = nullptr;
+	}
+	const auto is_from_file = [file](const BlockKey& key) {
+		return key.file == file;
+	};
+	std::erase_if(requested_blocks, is_from_file);
+	std::erase_if(track_start_blocks, is_from_file);
+
+	block_ready_waiter.wait(lock, [this, file] { return decoding_file != file; });
+
+	std::erase_if(decoded_blocks, [&](const auto& block) {
+		return is_from_file(block.first);
+	});
+}
+
+void CDROM_Interface_Image::AudioDecoder::DecoderLoop()
+{
+	std::unique_lock lock(mutex);
+
+	while (true) {
+		request_waiter.wait(lock, [this] {
+			return should_exit || !requested_blocks.empty();
+		});
+		if (should_exit) {
+			return;
+		}
+
+		const auto key = requested_blocks.front();
+		requested_blocks.pop_front();
+		if (decoded_blocks.contains(key)) {
+			continue;
+		}
+
+		// Decode without holding the lock, so the decoded blocks can be
+		// played meanwhile; the file is kept until the block is done
+		decoding_file = key.file;
+		lock.unlock();
+		auto pcm = key.file->DecodeBlock(key.index);
+		lock.lock();
+		decoding_file = nullptr;
+
+		decoded_blocks[key] = {std::move(pcm), ++use_counter};
+
+		// Evict the least recently used blocks, keeping the starts of
+		// the tracks
+		while (true) {
+			auto lru             = decoded_blocks.end();
+			size_t num_evictable = 0;
+			for (auto it = decoded_blocks.begin();
+			     it != decoded_blocks.end();
+			     ++it) {
+				if (track_start_blocks.contains(it->first)) {
+					continue;
+				}
+				++num_evictable;
+				if (lru == decoded_blocks.end() ||
+				    it->second.last_use < lru->second.last_use) {
+					lru = it;
+				}
+			}
+			if (num_evictable <= MaxDecodedBlocks) {
+				break;
+			}
+			decoded_blocks.erase(lru);
+		}
+
+		block_ready_waiter.notify_all();
+	}
+}
+
+uint32_t CDROM_Interface_Image::AudioDecoder::CopyFrames(
+        AudioFile* file, const uint64_t first_frame, uint8_t* buffer,
+        const uint32_t num_frames, const bool should_wait, bool& is_track_end)
+{
+	std::unique_lock lock(mutex);
+
+	const auto frames_per_block = file->frames_per_block;
+	const auto bytes_per_frame  = file->bytes_per_frame;
+
+	is_track_end = false;
+
+	uint32_t copied_frames = 0;
+	uint32_t index         = 0;
+	while (copied_frames < num_frames && !should_exit) {
+		const auto frame  = first_frame + copied_frames;
+		index             = static_cast<uint32_t>(frame / frames_per_block);
+		const auto offset = static_cast<uint32_t>(frame % frames_per_block);
+
+		const BlockKey key = {file, index};
+
+		auto it = decoded_blocks.find(key);
+		if (it == decoded_blocks.end()) {
+			QueueBlock(file, index, true);
+			if (!should_wait) {
+				break;
+			}
+			// Another file being played drops the request, so
+			// request it again then
+			block_ready_waiter.wait(lock, [this, file, key] {
+				return should_exit || active_file != file ||
+				       decoded_blocks.contains(key);
+			});
+			continue;
+		}
+		it->second.last_use = ++use_counter;
+
+		const auto& pcm = it->second.pcm;
+		const auto block_frames = static_cast<uint32_t>(pcm.size() /
+		                                                bytes_per_frame);
+		if (offset >= block_frames) {
+			is_track_end = true;
+			break;
+		}
+		const auto frames = std::min(block_frames - offset,
+		                             num_frames - copied_frames);
+		memcpy(buffer + copied_frames * bytes_per_frame,
+		       pcm.data() + offset * bytes_per_frame,
+		       frames * bytes_per_frame);
+		copied_frames += frames;
+	}
+
+	const auto track_frames = file->RedbookPosToFrame(
+	        check_cast<uint32_t>(file->getLength()));
+	for (uint32_t i = 1; i <= ReadAheadBlocks; ++i) {
+		if (static_cast<uint64_t>(index + i) * frames_per_block >= track_frames) {
+			break;
+		}
+		QueueBlock(file, index + i, false);
+	}
+	return copied_frames;
+}
+
+CDROM_Interface_Image::AudioFile::AudioFile(const char* filename, bool& error,
+                                            AudioDecoder& _decoder)
+        : TrackFile(4096),
+          decoder(_decoder)
 {
 	// Use the audio file's sample rate and number of channels as-is
 	Sound_AudioInfo desired = {SDL_AUDIO_S16LE, 0, 0};
@@ -215,6 +477,10 @@ CDROM_Interface_Image::AudioFile::AudioFile(const char *filename, bool &error)
 		LOG_MSG("CDROM: Loaded %s [%d Hz, %d-channel, %2.1f minutes]",
 		        filename_only.c_str(), getRate(), getChannels(),
 		        getLength() / static_cast<double>(REDBOOK_PCM_BYTES_PER_MIN));
+
+		// Decoded blocks are one second long
+		frames_per_block = getRate();
+		bytes_per_frame  = getChannels() * REDBOOK_BPS;
 	} else {
 		LOG_MSG("CDROM: Failed adding '%s' as CDDA track!", filename_only.c_str());
 		error = true;
@@ -227,10 +493,76 @@ CDROM_Interface_Image::AudioFile::~AudioFile()
 	if (sample == nullptr)
 		return;
 
+	// The decoder thread might be decoding the file
+	decoder.RemoveFile(this);
+
 	Sound_FreeSample(sample);
 	sample = nullptr;
 }
 
+// Converts a Redbook CD-DA byte offset to a PCM frame in the track's rate
+uint64_t CDROM_Interface_Image::AudioFile::RedbookPosToFrame(
+        const uint32_t redbook_pos) const
+{
+	const uint64_t redbook_frame = redbook_pos / BYTES_PER_REDBOOK_PCM_FRAME;
+	return redbook_frame * frames_per_block / REDBOOK_PCM_FRAMES_PER_SECOND;
+}
+
+// Decodes a block of PCM frames; the block is shorter than a whole block at
+// the end of the track, and empty past the end or if the codec failed
+std::vector<uint8_t> CDROM_Interface_Image::AudioFile::DecodeBlock(
+        const uint32_t index)
+{
+	// Consecutive blocks are decoded without seeking
+	if (index != next_decoder_block) {
+		// Blocks are one second long
+		constexpr uint32_t ms_per_block = 1000;
+
+#ifdef DEBUG
+		/**
+		 *  In DEBUG mode, we additionally measure the seek latency,
+		 *  which can be an issue for some codecs.
+		 */
+		using namespace std::chrono;
+		using clock = std::chrono::steady_clock;
+		clock::time_point begin = clock::now(); // start the timer
+#endif
+		const bool result = Sound_Seek(sample, index * ms_per_block);
+
+#ifdef DEBUG
+		clock::time_point end = clock::now(); // stop the timer
+		const auto elapsed_ms = static_cast<int32_t>(
+		        duration_cast<milliseconds>(end - begin).count());
+		LOG_MSG("CDROM: seeked to block %u in the background, and took %d ms",
+		        index, elapsed_ms);
+#endif
+		if (!result) {
+			next_decoder_block = std::numeric_limits<uint32_t>::max();
+			return {};
+		}
+	}
+
+	std::vector<uint8_t> pcm(static_cast<size_t>(frames_per_block) *
+	                         bytes_per_frame);
+
+	uint32_t decoded_frames = 0;
+	while (decoded_frames < frames_per_block) {
+		const uint32_t decoded = Sound_Decode_Direct(
+		        sample,
+		        pcm.data() + decoded_frames * bytes_per_frame,
+		        frames_per_block - decoded_frames);
+		if (sample->flags & (SOUND_SAMPLEFLAG_ERROR | SOUND_SAMPLEFLAG_EOF) || !decoded)
+			break;
+		decoded_frames += decoded;
+	}
+	pcm.resize(static_cast<size_t>(decoded_frames) * bytes_per_frame);
+
+	next_decoder_block = (decoded_frames == frames_per_block)
+	                           ? index + 1
+	                           : std::numeric_limits<uint32_t>::max();
+	return pcm;
+}
+
 /**
  *  Seek takes in a Redbook CD-DA byte offset relative to the track's start
  *  time and returns true if the seek succeeded.
@@ -241,7 +573,8 @@ CDROM_Interface_Image::AudioFile::~AudioFile()
  *  tracks, we need the codec's help to seek to the equivalent redbook position
  *  within the track, regardless of the track's sampling rate, bit-depth,
  *  or number of channels.  To do this, we convert the byte offset to a
- *  time-offset, and use the Sound_Seek() function to move the read position.
+ *  PCM frame offset in the track's rate, and the decoder thread seeks to
+ *  the block holding that frame with the Sound_Seek() function.
  */
 bool CDROM_Interface_Image::AudioFile::seek(const uint32_t requested_pos)
 {
@@ -259,48 +592,12 @@ bool CDROM_Interface_Image::AudioFile::seek(const uint32_t requested_pos)
 		return true;
 	}
 
-	// Convert the position from a byte offset to time offset, in milliseconds.
-	const uint32_t ms_per_s = 1000;
-	const uint32_t pos_in_frames = ceil_udivide(requested_pos, BYTES_PER_RAW_REDBOOK_FRAME);
-	const uint32_t pos_in_ms = ceil_udivide(pos_in_frames * ms_per_s, REDBOOK_FRAMES_PER_SECOND);
-
-#ifdef DEBUG
-	/**
-	 *  In DEBUG mode, we additionally measure the seek latency, which can
-	 *  be an issue for some codecs. 
-	 */
-	using namespace std::chrono;
-	using clock = std::chrono::steady_clock;
-	clock::time_point begin = clock::now(); // start the timer
-#endif
-
-	// Perform the seek and update our position
-	const bool result = Sound_Seek(sample, pos_in_ms);
-	audio_pos = result ? requested_pos : std::numeric_limits<uint32_t>::max();
-
-#ifdef DEBUG
-	clock::time_point end = clock::now(); // stop the timer
-	const auto elapsed_ms = static_cast<int32_t>
-	    (duration_cast<milliseconds>(end - begin).count());
-
-	// Report general seek diagnostics
-	const double pos_in_min = static_cast<double>(pos_in_ms) / 60000.0;
-	LOG_MSG("CDROM: seeked to byte %u (frame %u at %.2f min), and took %u ms",
-	        requested_pos, pos_in_frames, pos_in_min, elapsed_ms);
-
-	/**
-	 *  Inform the user if the seek took longer than that of a physical
-	 *  CDROM drive, which might have caused in-game symptoms like pauses
-	 *  or stuttering.
-	 */
-	const int32_t average_cdrom_seek_ms = 200;
-	if (elapsed_ms > average_cdrom_seek_ms)
-		LOG_MSG("CDROM: seek took %d ms, which is slower than an average "
-		        "physical CDROM drive's seek time of %d ms.",
-		        elapsed_ms, average_cdrom_seek_ms);
-#endif
-
-	return result;
+	// The codec seeks in the background, so only ask the decoder thread to
+	// start decoding from the new position
+	play_frame = RedbookPosToFrame(requested_pos);
+	audio_pos  = requested_pos;
+	decoder.RequestBlock(this, static_cast<uint32_t>(play_frame / frames_per_block));
+	return true;
 }
 
 bool CDROM_Interface_Image::AudioFile::read(uint8_t *buffer,
@@ -341,21 +638,16 @@ bool CDROM_Interface_Image::AudioFile::read(uint8_t *buffer,
 
 	// Setup characteristics about our track and the request
 	const uint8_t channels = getChannels();
-	const uint8_t bytes_per_frame = channels * REDBOOK_BPS;
 	const uint32_t requested_frames = ceil_udivide(adjusted_bytes,
 	                                               BYTES_PER_REDBOOK_PCM_FRAME);
 
-	uint32_t decoded_bytes = 0;
-	uint32_t decoded_frames = 0;
-	while (decoded_frames < requested_frames) {
-		const uint32_t decoded = Sound_Decode_Direct(sample,
-		                                             buffer + decoded_bytes,
-		                                             requested_frames - decoded_frames);
-		if (sample->flags & (SOUND_SAMPLEFLAG_ERROR | SOUND_SAMPLEFLAG_EOF) || !decoded)
-			break;
-		decoded_frames += decoded;
-		decoded_bytes = decoded_frames * bytes_per_frame;
-	}
+	// The guest reads the audio data, so wait for it to be decoded
+	bool is_track_end = false;
+	const uint32_t decoded_frames = decoder.CopyFrames(
+	        this, play_frame, buffer, requested_frames, true, is_track_end);
+	uint32_t decoded_bytes = decoded_frames * bytes_per_frame;
+	play_frame += decoded_frames;
+
 	// Zero out any remainining frames that we didn't fill
 	if (decoded_frames < requested_frames)
 		memset(buffer + decoded_bytes, 0, adjusted_bytes - decoded_bytes);
@@ -406,24 +698,50 @@ bool CDROM_Interface_Image::AudioFile::read(uint8_t *buffer,
 	}
 	// reading DAE is an audio-task, so update our audio position
 	audio_pos += decoded_bytes;
-	return !(sample->flags & SOUND_SAMPLEFLAG_ERROR);
+
+	// The requested range is inside the track, so it's an error if
+	// nothing could be decoded
+	return decoded_frames > 0;
 }
 
 uint32_t CDROM_Interface_Image::AudioFile::decode(int16_t *buffer,
-                                                  const uint32_t desired_track_frames)
+                                                  const uint32_t desired_track_frames,
+                                                  uint32_t& silent_frames)
 {
 	assertm(audio_pos < MAX_REDBOOK_BYTES,
 	        "Tried to decode audio before the playback position was set");
 
-	// Sound_Decode_Direct returns frames (agnostic of bitrate and channels)
-	const uint32_t frames_decoded =
-	    Sound_Decode_Direct(sample, (void*)buffer, desired_track_frames);
+	// Frames are agnostic of bitrate and channels
+	bool is_track_end = false;
+	const uint32_t frames_decoded = decoder.CopyFrames(
+	        this,
+	        play_frame,
+	        reinterpret_cast<uint8_t*>(buffer),
+	        desired_track_frames,
+	        false,
+	        is_track_end);
+	play_frame += frames_decoded;
 
 	// decoding is an audio-task, so update our audio position
 	// in terms of Redbook-equivalent bytes
 	const uint32_t redbook_bytes = frames_decoded * BYTES_PER_REDBOOK_PCM_FRAME;
 	audio_pos += redbook_bytes;
 
+	silent_frames = 0;
+	if (frames_decoded == desired_track_frames || is_track_end) {
+		return frames_decoded;
+	}
+
+	// The mixer thread mustn't wait for the decoder, so play silence
+	// until the decoder catches up; the position stays where the decoded
+	// frames end, so nothing of the track is skipped
+	silent_frames = desired_track_frames - frames_decoded;
+
+	auto pcm_buffer = reinterpret_cast<uint8_t*>(buffer);
+	memset(pcm_buffer + frames_decoded * bytes_per_frame,
+	       0,
+	       silent_frames * bytes_per_frame);
+
 	return frames_decoded;
 }
 
@@ -511,13 +829,28 @@ CDROM_Interface_Image::~CDROM_Interface_Image()
 		player.cd = nullptr;
 	}
 	MIXER_UnlockMixerThread();
+
+	// The audio files use the decoder, so release them before it's
+	// destroyed, and while the mixer thread isn't playing them
+	std::lock_guard lock(player.mutex);
+	tracks.clear();
 }
 
 bool CDROM_Interface_Image::SetDevice(const char* path)
 {
 	std::lock_guard lock(player.mutex);
 	const bool result = LoadMdsFile(path) || LoadCueSheet(path) || LoadIsoFile(path);
-	if (!result) {
+	if (result) {
+		// Keep the start of every compressed audio track decoded, so
+		// track changes don't wait for the codec
+		for (const auto& track : tracks) {
+			const auto audio_file = std::dynamic_pointer_cast<AudioFile>(
+			        track.file);
+			if (audio_file && track.attr != 0x40) {
+				audio_decoder.AddTrackStart(audio_file.get(), track.skip);
+			}
+		}
+	} else {
 		// print error message on dosbox console
 		char buf[MAX_LINE_LENGTH];
 		snprintf(buf, MAX_LINE_LENGTH, "Could not load image file: %s\r\n", path);
@@ -1043,10 +1376,11 @@ void CDROM_Interface_Image::CDAudioCallback(const int desired_track_frames)
 		return;
 	}
 
+	uint32_t silent_frames = 0;
 	const auto decoded_track_frames = check_cast<uint16_t>(
-	        track_file->decode(player.buffer, desired_track_frames));
+	        track_file->decode(player.buffer, desired_track_frames, silent_frames));
 
-	if (!decoded_track_frames) {
+	if (!decoded_track_frames && !silent_frames) {
 		// This particular CDDA track has come to an end, but the
 		// program has requested we continue playing for a longer
 		// period. So keep going!
@@ -1071,8 +1405,12 @@ void CDROM_Interface_Image::CDAudioCallback(const int desired_track_frames)
 
 	// Use the stereo or mono and native or nonnative AddSamples call
 	// assigned during construction
-	(player.channel.get()->*player.addFrames)(decoded_track_frames, player.buffer);
+	const auto mixed_frames = check_cast<uint16_t>(decoded_track_frames +
+	                                               silent_frames);
+	(player.channel.get()->*player.addFrames)(mixed_frames, player.buffer);
 
+	// The silence played while waiting for the decoder isn't part of the
+	// track, so only the decoded frames count towards the requested range
 	player.playedTrackFrames += decoded_track_frames;
 	if (player.playedTrackFrames >= player.totalTrackFrames) {
 #ifdef DEBUG
@@ -1522,7 +1860,7 @@ bool CDROM_Interface_Image::LoadCueSheet(const char *cuefile)
 				        filename, error);
 			} else {
 				track.file = std::make_shared<AudioFile>(
-				        filename.c_str(), error);
+				        filename.c_str(), error, audio_decoder);
 				/**
 				 *  SDL_Sound first tries using a decoder having a matching
 				 *  registered extension as the filename, and then falls back to
@@ -1736,3 +2074,8 @@ void CDROM_Image_Init()
 void CDROM_Image_Destroy() {
 	Sound_Quit();
 }
+
+void CDROM_Image_SetMp3SeekTableSaving(const bool enabled)
+{
+	set_seek_table_saving(enabled);
+}
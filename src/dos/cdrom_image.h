@@ -7,4 +7,8 @@
 void CDROM_Image_Init();
 void CDROM_Image_Destroy();
 
+// Enables writing the seek points of MP3 CD audio tracks to '.seek' files
+// next to them, so they don't have to be generated again next time
+void CDROM_Image_SetMp3SeekTableSaving(bool enabled);
+
 #endif // DOSBOX_CDROM_IMAGE_H
@@ -26,6 +26,7 @@
 #include "hardware/pic.h"
 #include "hardware/serialport/serialport.h"
 #include "ints/bios.h"
+#include "ints/bios_disk.h"
 #include "ints/ems.h"
 #include "ints/xms.h"
 #include "misc/support.h"
@@ -300,6 +301,15 @@ static void DOS_PerformDiskIoDelayByHandle(uint16_t data_transferred_bytes,
 	}
 }
 
+static bool is_device_handle(const uint16_t reg_handle)
+{
+	const auto handle = RealHandle(reg_handle);
+	if (handle == 0xff || !Files[handle]) {
+		return false;
+	}
+	return Files[handle]->GetInformation() & 0x8000;
+}
+
 void DOS_PerformHardDiskIoDelay(uint16_t data_transferred_bytes)
 {
 	constexpr auto HardDiskSpeedFastKbPerSec   = 15000;
@@ -651,8 +661,9 @@ static Bitu DOS_21Handler(void) {
 //TODO Find out the values for when reg_al!=0
 //TODO Hope this doesn't do anything special
 	case 0x0d:		/* Disk Reset */
-//Sure let's reset a virtual disk
-		break;	
+		// Flushes all file buffers to disk
+		BIOS_FlushDiskImages();
+		break;
 	case 0x0e:		/* Select Default Drive */
 		DOS_SetDefaultDrive(reg_dl);
 		reg_al=DOS_DRIVES;
@@ -1051,9 +1062,22 @@ static Bitu DOS_21Handler(void) {
 		{ 
 			uint16_t toread=DOS_GetAmount();
 			dos.echo=true;
-			if (DOS_ReadFile(reg_bx,dos_copybuf,&toread)) {
+			const PhysPt buffer = SegPhys(ds) + reg_dx;
+
+			// Read files straight into the guest's buffer if it's in
+			// plain RAM; devices can run guest code while reading, which
+			// could turn the buffer into translated code
+			const auto direct_buffer = is_device_handle(reg_bx)
+			                                 ? nullptr
+			                                 : MEM_GetWritableHostPointer(buffer, toread);
+
+			if (DOS_ReadFile(reg_bx,
+			                 direct_buffer ? direct_buffer : dos_copybuf,
+			                 &toread)) {
 			        DOS_PerformDiskIoDelayByHandle(toread, reg_bx);
-			        MEM_BlockWrite(SegPhys(ds)+reg_dx,dos_copybuf,toread);
+				if (!direct_buffer) {
+					MEM_BlockWrite(buffer, dos_copybuf, toread);
+				}
 				reg_ax=toread;
 				CALLBACK_SCF(false);
 			} else {
@@ -1880,13 +1904,20 @@ void DOS_Init()
 	DOS_Files_Init(*section);
 	DOS_Locale_Init(*section);
 
+	BIOS_SetDiskCacheSize(section->GetInt("disk_cache_size"));
+
 	MSCDEX_Init();
 	DRIVES_Init();
 	CDROM_Image_Init();
+	CDROM_Image_SetMp3SeekTableSaving(section->GetBool("mp3_seek_tables"));
 }
 
 void DOS_Destroy()
 {
+	// Write back the cached sectors of the disk images while their drives
+	// are still mounted
+	BIOS_FlushDiskImages();
+
 	CDROM_Image_Destroy();
 	MSCDEX_Destroy();
 
@@ -1906,6 +1937,9 @@ static void notify_dos_setting_updated(SectionProp& section,
 
 	DOS_Files_Init(section);
 
+	BIOS_SetDiskCacheSize(section.GetInt("disk_cache_size"));
+	CDROM_Image_SetMp3SeekTableSaving(section.GetBool("mp3_seek_tables"));
+
 	EMS_Destroy();
 	EMS_Init(section);
 
@@ -2050,6 +2084,26 @@ static void init_dos_settings(SectionProp& section)
 	        "tab-separated format, used by SETVER.EXE as a persistent storage (empty by\n"
 	        "default).");
 
+	auto pint = section.AddInt("disk_cache_size", WhenIdle, 8);
+	pint->SetMinMax(0, 512);
+	pint->SetHelp(
+	        "Size of the sector cache of each mounted disk image in megabytes, 0 to 512\n"
+	        "(8 by default). Sequentially read sectors are read ahead in larger chunks, and\n"
+	        "written sectors are kept in the cache and written back to the image file in\n"
+	        "larger runs on disk resets and when the image is unmounted. The new size only\n"
+	        "applies to disk images mounted afterwards. Set to 0 to read and write every\n"
+	        "sector directly from and to the image file.\n"
+	        "\n"
+	        "Note: Disk images are memory-mapped when the host supports it; the cache is\n"
+	        "      only used for the images that can't be mapped.");
+
+	pbool = section.AddBool("mp3_seek_tables", WhenIdle, false);
+	pbool->SetHelp(
+	        "Write the seek points of the MP3 audio tracks of CD images to '.seek' files\n"
+	        "next to the tracks ('off' by default). Finding the seek points scans the whole\n"
+	        "track, which can take a while for long tracks; with the files, this is only\n"
+	        "done the first time a track is loaded. Existing '.seek' files are always used.");
+
 	pstring = section.AddString("file_locking", WhenIdle, "auto");
 	pstring->SetValues({"auto", "on", "off"});
 	pstring->SetHelp(
@@ -1837,6 +1837,9 @@ bool DOS_LockFile(const uint16_t entry, const uint32_t pos, const uint32_t len)
 	lock.pos = pos;
 	lock.len = len;
 	Files[handle]->region_locks.push_back(lock);
+
+	// Locked regions are shared with other programs that may change them
+	Files[handle]->DiscardReadAhead();
 	return true;
 }
 
@@ -1862,6 +1865,7 @@ bool DOS_UnlockFile(const uint16_t entry, const uint32_t pos, const uint32_t len
 	for (auto it = region_locks.begin(); it != last; ++it) {
 		if (it->pos == pos && it->len == len) {
 			region_locks.erase(it);
+			Files[handle]->DiscardReadAhead();
 			return true;
 		}
 	}
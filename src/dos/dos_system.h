@@ -7,7 +7,12 @@
 
 #include "dosbox.h"
 
+#include <functional>
+#include <set>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "utils/bit_view.h"
@@ -119,6 +124,10 @@ public:
 	virtual uint16_t	GetInformation(void)=0;
 	virtual bool IsOnReadOnlyMedium() const = 0;
 
+	// Drops the data buffered ahead of the reads, if any, so the next
+	// read sees changes made to the file through other means
+	virtual void DiscardReadAhead() {}
+
 	virtual void AddRef() { refCtr++; }
 	virtual Bits RemoveRef() { return --refCtr; }
 
@@ -199,9 +208,35 @@ public:
 	void  DeleteEntry          (const char* path, bool ignoreLastDir = false);
 	void  EmptyCache           (void);
 
+	// Apply changes made to the host directories; the paths are host paths
+	// with long names. Changes to directories that aren't cached in are
+	// ignored, as they will be read when cached in.
+	void AddHostEntry(const char* path, const bool is_directory);
+	void RemoveHostEntry(const char* path);
+
+	// Called with the host path of every directory about to be read into
+	// the cache
+	void SetCachedInCallback(std::function<void(const char* dir_path)> callback)
+	{
+		cached_in_callback = std::move(callback);
+	}
+
 	void SetLabel(const char *name, bool cdrom, bool allowupdate);
 	const char *GetLabel() const { return label; }
 
+	class CFileInfo;
+
+	// Allows looking up names without copying them into a std::string
+	struct NameHash {
+		using is_transparent = void;
+		size_t operator()(const std::string_view name) const
+		{
+			return std::hash<std::string_view>{}(name);
+		}
+	};
+	using NameIndex =
+	        std::unordered_map<std::string, CFileInfo*, NameHash, std::equal_to<>>;
+
 	class CFileInfo final {
 	public:
 		CFileInfo(void)
@@ -212,7 +247,10 @@ public:
 		          id(MAX_OPENDIRS),
 		          nextEntry(0),
 		          shortNr(0),
-		          fileList(0)
+		          fileList(0),
+		          shortNameIndex(),
+		          longNameIndex(),
+		          shortNrs()
 		{}
 
 		~CFileInfo()
@@ -230,8 +268,21 @@ public:
 		uint16_t      id;
 		Bitu        nextEntry;
 		unsigned    shortNr;
-		// contents
+		// contents, sorted by short name
 		std::vector<CFileInfo*> fileList;
+
+		// The contents by short name and by host name
+		NameIndex shortNameIndex;
+		NameIndex longNameIndex;
+
+		// The numbers of the generated short names, per name prefix:
+		// the highest one given out, and the ones freed by removed
+		// entries, which are given out again first
+		struct ShortNumbers {
+			unsigned last               = 0;
+			std::set<unsigned> released = {};
+		};
+		std::unordered_map<std::string, ShortNumbers> shortNrs;
 	};
 
 private:
@@ -239,16 +290,17 @@ private:
 	void DeleteFileInfo(CFileInfo *dir);
 
 	bool		RemoveTrailingDot	(char* shortname);
-	Bits		GetLongName		(CFileInfo* info, char* shortname, const size_t shortname_len);
+	CFileInfo*	GetLongName		(CFileInfo* info, char* shortname, const size_t shortname_len);
 	void		CreateShortName		(CFileInfo* dir, CFileInfo* info);
 	unsigned        CreateShortNameID       (CFileInfo* dir, const char* name);
-	int		CompareShortname	(const char* compareName, const char* shortName);
+	void            ReleaseShortNameID      (CFileInfo* dir, const CFileInfo* info);
 	bool		SetResult		(CFileInfo* dir, char * &result, Bitu entryNr);
 	bool		IsCachedIn		(CFileInfo* dir);
 	CFileInfo*	FindDirInfo		(const char* path, char* expandedPath);
-	bool		RemoveSpaces		(char* str);
+	CFileInfo*	FindCachedHostDir	(const std::string_view dir_path);
+	void		AdjustSearches		(CFileInfo* dir, size_t index, bool is_added);
 	bool		OpenDir			(CFileInfo* dir, const char* path, uint16_t& id);
-	void		CreateEntry		(CFileInfo* dir, const char* name, bool is_directory);
+	size_t		CreateEntry		(CFileInfo* dir, const char* name, bool is_directory);
 	void		CopyEntry		(CFileInfo* dir, CFileInfo* from);
 	uint16_t		GetFreeID		(CFileInfo* dir);
 	void		Clear			(void);
@@ -268,6 +320,8 @@ private:
 
 	char		label				[CROSS_LEN];
 	bool		updatelabel;
+
+	std::function<void(const char* dir_path)> cached_in_callback = {};
 };
 
 enum class DosDriveType : uint16_t {
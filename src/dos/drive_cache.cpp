@@ -6,7 +6,6 @@
 #include <algorithm>
 #include <cassert>
 #include <iterator>
-#include <numeric>
 #include <vector>
 
 #include "dos.h"
@@ -46,6 +45,16 @@ bool SortByDirNameRev(DOS_Drive_Cache::CFileInfo* const a,
 	return strcmp(a->shortname,b->shortname)>0;
 }
 
+// Host file names are case-insensitive on Windows
+static std::string get_host_name_key(const std::string_view name)
+{
+#if defined(WIN32)
+	return lowcase(name);
+#else
+	return std::string(name);
+#endif
+}
+
 DOS_Drive_Cache::DOS_Drive_Cache(void)
 	: dirBase(new CFileInfo),
 	  dirPath{0},
@@ -211,25 +220,12 @@ void DOS_Drive_Cache::AddEntry(const char* path, bool checkExists) {
 		safe_strcpy(file, pos+1);
 		// Check if file already exists, then don't add new entry...
 		if (checkExists) {
-			if (GetLongName(dir, file, sizeof(file))>=0) return;
+			if (GetLongName(dir, file, sizeof(file))) return;
 		}
 
-		CreateEntry(dir,file,false);
-
-		if (const auto rcode = GetLongName(dir, file, sizeof(file));
-		    rcode >= 0) {
-			// if the function succeeded, the return value is the index
-			const auto index = static_cast<size_t>(rcode);
+		const auto index = CreateEntry(dir, file, false);
 
-			uint32_t i;
-			// Check if there are any open search dir that are affected by this...
-			for (i=0; i<MAX_OPENDIRS; i++) {
-				if ((dirSearch[i] == dir) &&
-				    (index <= dirSearch[i]->nextEntry)) {
-					dirSearch[i]->nextEntry++;
-				}
-			}
-		}
+		AdjustSearches(dir, index, true);
 		//		LOG_DEBUG("DIR: Added Entry %s",path);
 	} else {
 //		LOG_DEBUG("DIR: Error: Failed to add %s",path);	
@@ -264,10 +260,9 @@ void DOS_Drive_Cache::AddEntryDirOverlay(const char* path, bool checkExists) {
 		safe_strcpy(file, pos + 1);
 		// Check if directory already exists, then don't add new entry...
 		if (checkExists) {
-			Bits index = GetLongName(dir, file, sizeof(file));
-			if (index >= 0) {
+			if (CFileInfo* existing = GetLongName(dir, file, sizeof(file))) {
 				//directory already exists, but most likely empty. 
-				dir = dir->fileList[index];
+				dir = existing;
 				if (dir->isOverlayDir && dir->fileList.empty()) {
 					//maybe care about searches ? but this function should only run on cache inits/refreshes.
 					//add dot entries
@@ -278,33 +273,124 @@ void DOS_Drive_Cache::AddEntryDirOverlay(const char* path, bool checkExists) {
 			}
 		}
 
-		CreateEntry(dir,file,true);
+		const auto index = CreateEntry(dir, file, true);
 
-		if (const auto rcode = GetLongName(dir, file, sizeof(file));
-		    rcode >= 0) {
-			// if the function succeeded, the return value is the index
-			const auto index = static_cast<size_t>(rcode);
+		AdjustSearches(dir, index, true);
 
-			uint32_t i;
-			// Check if there are any open search dir that are affected by this...
-			for (i=0; i<MAX_OPENDIRS; i++) {
-				if ((dirSearch[i] == dir) &&
-				    (index <= dirSearch[i]->nextEntry)) {
-					dirSearch[i]->nextEntry++;
-				}
-			}
-
-			dir = dir->fileList[index];
-			dir->isOverlayDir = true;
-			CreateEntry(dir,".",true);
-			CreateEntry(dir,"..",true);
-		}
+		dir = dir->fileList[index];
+		dir->isOverlayDir = true;
+		CreateEntry(dir,".",true);
+		CreateEntry(dir,"..",true);
 		//		LOG_DEBUG("DIR: Added Entry %s",path);
 	} else {
 		//		LOG_DEBUG("DIR: Error: Failed to add %s",path);	
 	}
 }
 
+// Keeps the open searches of the directory at the same entry
+void DOS_Drive_Cache::AdjustSearches(CFileInfo* dir, const size_t index,
+                                     const bool is_added)
+{
+	for (uint32_t i = 0; i < MAX_OPENDIRS; i++) {
+		if (dirSearch[i] != dir) {
+			continue;
+		}
+		if (is_added && index <= dirSearch[i]->nextEntry) {
+			dirSearch[i]->nextEntry++;
+		} else if (!is_added && index < dirSearch[i]->nextEntry) {
+			dirSearch[i]->nextEntry--;
+		}
+	}
+}
+
+DOS_Drive_Cache::CFileInfo* DOS_Drive_Cache::FindCachedHostDir(const std::string_view dir_path)
+{
+	const std::string_view base_path = basePath;
+	if (!dir_path.starts_with(base_path)) {
+		return nullptr;
+	}
+
+	// Follow the host names without caching in any directories
+	CFileInfo* dir = dirBase;
+	auto rest      = dir_path.substr(base_path.size());
+	while (dir && IsCachedIn(dir)) {
+		const auto end  = rest.find(CROSS_FILESPLIT);
+		const auto name = rest.substr(0, end);
+		if (name.empty()) {
+			return dir;
+		}
+
+		const auto it = dir->longNameIndex.find(get_host_name_key(name));
+		if (it == dir->longNameIndex.end() || !it->second->isDir) {
+			return nullptr;
+		}
+		dir  = it->second;
+		rest = (end == std::string_view::npos) ? std::string_view()
+		                                       : rest.substr(end + 1);
+	}
+	return nullptr;
+}
+
+void DOS_Drive_Cache::AddHostEntry(const char* path, const bool is_directory)
+{
+	const char* pos = strrchr(path, CROSS_FILESPLIT);
+	if (!pos) {
+		return;
+	}
+
+	CFileInfo* dir = FindCachedHostDir(std::string_view(path, pos + 1));
+	if (!dir || dir->longNameIndex.contains(get_host_name_key(pos + 1))) {
+		return;
+	}
+
+	const auto index = CreateEntry(dir, pos + 1, is_directory);
+	AdjustSearches(dir, index, true);
+}
+
+void DOS_Drive_Cache::RemoveHostEntry(const char* path)
+{
+	const char* pos = strrchr(path, CROSS_FILESPLIT);
+	if (!pos) {
+		return;
+	}
+
+	CFileInfo* dir = FindCachedHostDir(std::string_view(path, pos + 1));
+	if (!dir) {
+		return;
+	}
+
+	const auto it = dir->longNameIndex.find(get_host_name_key(pos + 1));
+	if (it == dir->longNameIndex.end()) {
+		return;
+	}
+	CFileInfo* info = it->second;
+	dir->longNameIndex.erase(it);
+	ReleaseShortNameID(dir, info);
+
+	if (const auto short_it = dir->shortNameIndex.find(
+	            std::string_view(info->shortname));
+	    short_it != dir->shortNameIndex.end() && short_it->second == info) {
+		dir->shortNameIndex.erase(short_it);
+	}
+
+	auto list_it = std::lower_bound(dir->fileList.begin(),
+	                                dir->fileList.end(),
+	                                info,
+	                                SortByName);
+	while (list_it != dir->fileList.end() && *list_it != info) {
+		++list_it;
+	}
+	if (list_it != dir->fileList.end()) {
+		const auto index = static_cast<size_t>(list_it - dir->fileList.begin());
+		dir->fileList.erase(list_it);
+		AdjustSearches(dir, index, false);
+	}
+
+	// The entry, or a directory below it, might be the last one found
+	save_dir = nullptr;
+	DeleteFileInfo(info);
+}
+
 void DOS_Drive_Cache::DeleteEntry(const char* path, bool ignoreLastDir) {
 	CacheOut(path,ignoreLastDir);
 	if (dirSearch[srchNr] && (dirSearch[srchNr]->nextEntry>0)) dirSearch[srchNr]->nextEntry--;
@@ -352,6 +438,9 @@ void DOS_Drive_Cache::CacheOut(const char* path, bool ignoreLastDir) {
 	}
 	// clear lists
 	dir->fileList.clear();
+	dir->shortNameIndex.clear();
+	dir->longNameIndex.clear();
+	dir->shortNrs.clear();
 	save_dir = nullptr;
 }
 
@@ -372,84 +461,70 @@ bool DOS_Drive_Cache::GetShortName(const char* fullname, char* shortname) {
 	else
 		return false;
 
-	std::vector<CFileInfo*>::size_type filelist_size = curDir->fileList.size();
-	if (filelist_size <= 0) {
+	const auto it = curDir->longNameIndex.find(get_host_name_key(pos));
+	if (it == curDir->longNameIndex.end()) {
 		return false;
 	}
+	safe_strncpy(shortname, it->second->shortname, DOS_NAMELENGTH_ASCII);
+	return true;
+}
 
-	// The orgname part of the list is not sorted (shortname is)! So we can only walk through it.
-	for(Bitu i = 0; i < filelist_size; i++) {
-#if defined (WIN32)
-		if (strcasecmp(pos,curDir->fileList[i]->orgname) == 0) {
-#else
-		if (strcmp(pos,curDir->fileList[i]->orgname) == 0) {
-#endif
-			safe_strncpy(shortname, curDir->fileList[i]->shortname, DOS_NAMELENGTH_ASCII);
-			return true;
-		}
+// Converts a host name to the DOS name its short name is based on: in code
+// page 437 and upper case, without spaces, and without leading dots if the
+// extension is longer than 3 characters. Sets `needs_number` if the name
+// changed in a way that requires a numbered short name.
+static std::string get_short_name_base(const char* host_name, bool& needs_number)
+{
+	std::string dos_name = fs_utf8_to_dos_437(host_name);
+	upcase(dos_name);
+	needs_number = std::erase(dos_name, ' ') > 0;
+
+	const auto dot = dos_name.find('.');
+	if (dot != std::string::npos && dos_name.size() - dot > 4) {
+		dos_name.erase(0, dos_name.find_first_not_of('.'));
+		needs_number = true;
 	}
-	return false;
+	return dos_name;
 }
 
-int DOS_Drive_Cache::CompareShortname(const char* compareName, const char* shortName) {
-	const char* cpos = strchr(shortName, '~');
-	if (cpos) {
-/* the following code is replaced as it's not safe when char* is 64 bits */
-/*		Bits compareCount1	= (int)cpos - (int)shortName;
-		char* endPos		= strchr(cpos,'.');
-		Bitu numberSize		= endPos ? int(endPos)-int(cpos) : safe_strlen(cpos);
-		
-		char* lpos			= strchr(compareName,'.');
-		Bits compareCount2	= lpos ? int(lpos)-int(compareName) : safe_strlen(compareName);
-		if (compareCount2>8) compareCount2 = 8;
+// Generated short names keep at most the first 6 characters of the name, so
+// names starting with the same 6 characters share their numbers
+static std::string get_short_name_prefix(const char* dos_name)
+{
+	const auto prefix_len = std::min<size_t>(strcspn(dos_name, "."), 6);
+	return std::string(dos_name, prefix_len);
+}
 
-		compareCount2 -= numberSize;
-		if (compareCount2>compareCount1) compareCount1 = compareCount2;
-*/
-		size_t compareCount1 = strcspn(shortName,"~");
-		size_t numberSize    = strcspn(cpos,".");
-		size_t compareCount2 = strcspn(compareName,".");
-		if(compareCount2 > 8) compareCount2 = 8;
-		/* We want 
-		 * compareCount2 -= numberSize;
-		 * if (compareCount2>compareCount1) compareCount1 = compareCount2;
-		 * but to prevent negative numbers: 
-		 */
-		if(compareCount2 > compareCount1 + numberSize)
-			compareCount1 = compareCount2 - numberSize;
-		return strncmp(compareName,shortName,compareCount1);
-	}
-	return strcmp(compareName,shortName);
-}
-
-unsigned DOS_Drive_Cache::CreateShortNameID(CFileInfo *curDir, const char *name)
+unsigned DOS_Drive_Cache::CreateShortNameID(CFileInfo* curDir, const char* name)
 {
 	assert(curDir);
-	const auto filelist_size = curDir->fileList.size();
-	if (filelist_size == 0)
-		return 1; // short name IDs start with 1
-
-	unsigned found_nr = 0;
-	Bits low  = 0;
-	auto high = (Bits)(filelist_size - 1);
-
-	while (low <= high) {
-		auto mid = std::midpoint(low, high);
-		const char *other_shortname = curDir->fileList[mid]->shortname;
-		const int res = CompareShortname(name, other_shortname);
-		
-		if (res>0)	low  = mid+1; else
-		if (res<0)	high = mid-1; 
-		else {
-			// any more same x chars in next entries ?	
-			do {
-				found_nr = curDir->fileList[mid]->shortNr;
-				mid++;
-			} while((Bitu)mid < filelist_size && (CompareShortname(name, curDir->fileList[mid]->shortname) == 0));
-			break;
-		};
+
+	// Short name IDs start with 1. The numbers of removed entries are
+	// given out again first, so re-adding an entry gets its old short
+	// name back.
+	auto& numbers = curDir->shortNrs[get_short_name_prefix(name)];
+	if (!numbers.released.empty()) {
+		return numbers.released.extract(numbers.released.begin()).value();
+	}
+	return ++numbers.last;
+}
+
+void DOS_Drive_Cache::ReleaseShortNameID(CFileInfo* curDir, const CFileInfo* info)
+{
+	assert(curDir);
+	assert(info);
+
+	if (info->shortNr == 0) {
+		return;
+	}
+	bool needs_number   = false;
+	const auto dos_name = get_short_name_base(info->orgname, needs_number);
+	const auto prefix   = get_short_name_prefix(dos_name.c_str());
+
+	const auto numbers = curDir->shortNrs.find(prefix);
+	if (numbers != curDir->shortNrs.end()) {
+		numbers->second.released.insert(info->shortNr);
 	}
-	return found_nr + 1;
 }
 
 bool DOS_Drive_Cache::RemoveTrailingDot(char* shortname) {
@@ -464,67 +539,41 @@ bool DOS_Drive_Cache::RemoveTrailingDot(char* shortname) {
 	return false;
 }
 
-Bits DOS_Drive_Cache::GetLongName(CFileInfo* curDir, char* shortName, const size_t shortName_len) {
-	std::vector<CFileInfo*>::size_type filelist_size = curDir->fileList.size();
-	if (filelist_size <= 0) {
-		return -1;
+DOS_Drive_Cache::CFileInfo* DOS_Drive_Cache::GetLongName(CFileInfo* curDir,
+                                                        char* shortName,
+                                                        const size_t shortName_len)
+{
+	if (curDir->fileList.empty()) {
+		return nullptr;
 	}
 
 	// Remove dot, if no extension...
 	RemoveTrailingDot(shortName);
-	// Search long name and return array number of element
-	Bits low	= 0;
-	auto high	= (Bits)(filelist_size-1);
-	Bits mid,res;
-	while (low<=high) {
-		mid = std::midpoint(low, high);
-		res = strcmp(shortName,curDir->fileList[mid]->shortname);
-		if (res>0)	low  = mid+1; else
-		if (res<0)	high = mid-1; else
-		{	// Found
-			safe_strncpy(shortName, curDir->fileList[mid]->orgname, shortName_len);
-			return mid;
-		};
+
+	// Search long name and return its entry
+	const auto it = curDir->shortNameIndex.find(std::string_view(shortName));
+	if (it != curDir->shortNameIndex.end()) {
+		safe_strncpy(shortName, it->second->orgname, shortName_len);
+		return it->second;
 	}
+
 	// not available
 	const std::string host_name = dos_437_to_fs_utf8(shortName);
 	safe_strncpy(shortName, host_name.c_str(), shortName_len);
-	return -1;
-}
-
-bool DOS_Drive_Cache::RemoveSpaces(char* str) {
-// Removes all spaces
-	char*	curpos	= str;
-	char*	chkpos	= str;
-	while (*chkpos!=0) { 
-		if (*chkpos==' ') chkpos++; else *curpos++ = *chkpos++; 
-	}
-	*curpos = 0;
-	return (curpos!=chkpos);
+	return nullptr;
 }
 
 void DOS_Drive_Cache::CreateShortName(CFileInfo* curDir, CFileInfo* info) {
 	Bits	len			= 0;
 	bool	createShort = false;
 
-	std::string dos_name = fs_utf8_to_dos_437(info->orgname);
+	std::string dos_name = get_short_name_base(info->orgname, createShort);
 	char* tmpName = dos_name.data();
-	upcase(tmpName);
-	createShort = RemoveSpaces(tmpName);
 
 	// Get Length of filename
 	char* pos = strchr(tmpName,'.');
 	if (pos) {
-		// ignore preceding '.' if extension is longer than "3"
-		if (strlen(pos) > 4) {
-			while (*tmpName=='.') tmpName++;
-			createShort = true;
-		}
-		pos = strchr(tmpName,'.');
-		if (pos)
-			len = pos - tmpName;
-		else
-			len = (Bits)strlen(tmpName);
+		len = pos - tmpName;
 	} else {
 		len = strlen(tmpName);
 	}
@@ -534,10 +583,19 @@ void DOS_Drive_Cache::CreateShortName(CFileInfo* curDir, CFileInfo* info) {
 	if (!createShort) {
 		char buffer[CROSS_LEN];
 		safe_strcpy(buffer, tmpName);
-		createShort = (GetLongName(curDir, buffer, sizeof(buffer)) >= 0);
+		RemoveTrailingDot(buffer);
+		createShort = curDir->shortNameIndex.contains(std::string_view(buffer));
+	}
+
+	if (!createShort) {
+		safe_strcpy(info->shortname, tmpName);
+		RemoveTrailingDot(info->shortname);
+		return;
 	}
 
-	if (createShort) {
+	// Number the name, skipping numbers already taken by other names with
+	// a different prefix or by host files named like short names
+	do {
 		// Create number
 		info->shortNr = CreateShortNameID(curDir, tmpName);
 
@@ -578,10 +636,8 @@ void DOS_Drive_Cache::CreateShortName(CFileInfo* curDir, CFileInfo* info) {
 			strncat(info->shortname, pos, 4 < remaining_space ? 4 : remaining_space);
 			info->shortname[DOS_NAMELENGTH] = 0;
 		}
-	} else {
-		safe_strcpy(info->shortname, tmpName);
-	}
-	RemoveTrailingDot(info->shortname);
+		RemoveTrailingDot(info->shortname);
+	} while (curDir->shortNameIndex.contains(info->shortname));
 }
 
 DOS_Drive_Cache::CFileInfo* DOS_Drive_Cache::FindDirInfo(const char* path, char* expandedPath) {
@@ -637,7 +693,7 @@ DOS_Drive_Cache::CFileInfo* DOS_Drive_Cache::FindDirInfo(const char* path, char*
 		};
  
 		// Path found
-		Bits nextDir = GetLongName(curDir, dir, sizeof(dir));
+		CFileInfo* nextDir = GetLongName(curDir, dir, sizeof(dir));
 		strncat(expandedPath, dir, CROSS_LEN - strlen(expandedPath) - 1);
 
 		// Error check
@@ -646,8 +702,8 @@ DOS_Drive_Cache::CFileInfo* DOS_Drive_Cache::FindDirInfo(const char* path, char*
 		};
 */
 		// Follow Directory
-		if ((nextDir>=0) && curDir->fileList[nextDir]->isDir) {
-			curDir = curDir->fileList[nextDir];
+		if (nextDir && nextDir->isDir) {
+			curDir = nextDir;
 			safe_strcpy(curDir->orgname, dir);
 			if (!IsCachedIn(curDir)) {
 				if (OpenDir(curDir,expandedPath,id)) {
@@ -716,7 +772,7 @@ bool DOS_Drive_Cache::OpenDir(CFileInfo* dir, const char* expand, uint16_t& id)
 	return false;
 }
 
-void DOS_Drive_Cache::CreateEntry(CFileInfo* dir, const char* name, bool is_directory) {
+size_t DOS_Drive_Cache::CreateEntry(CFileInfo* dir, const char* name, bool is_directory) {
 	auto info = new CFileInfo;
 	safe_strcpy(info->orgname, name);
 	info->shortNr = 0;
@@ -725,30 +781,19 @@ void DOS_Drive_Cache::CreateEntry(CFileInfo* dir, const char* name, bool is_dire
 	// Check for long filenames...
 	CreateShortName(dir, info);		
 
-	bool found = false;
-
-	// keep list sorted (so GetLongName works correctly, used by CreateShortName in this routine)
-	if (!dir->fileList.empty()) {
-		if (!(strcmp(info->shortname,dir->fileList.back()->shortname)<0)) {
-			// append at end of list
-			dir->fileList.push_back(info);
-		} else {
-			// look for position where to insert this element
-			std::vector<CFileInfo*>::iterator it;
-			for (it=dir->fileList.begin(); it!=dir->fileList.end(); ++it) {
-				if (strcmp(info->shortname,(*it)->shortname)<0) {
-					found = true;
-					break;
-				}
-			}
-			// Put file in lists
-			if (found) dir->fileList.insert(it,info);
-			else dir->fileList.push_back(info);
-		}
-	} else {
-		// empty file list, append
-		dir->fileList.push_back(info);
-	}
+	// keep list sorted, as the directory listings are returned in this order
+	const auto it = std::upper_bound(dir->fileList.begin(),
+	                                 dir->fileList.end(),
+	                                 info,
+	                                 SortByName);
+	const auto index = static_cast<size_t>(it - dir->fileList.begin());
+	dir->fileList.insert(it, info);
+
+	// Lookups find the first entry added under a name
+	dir->shortNameIndex.try_emplace(info->shortname, info);
+	dir->longNameIndex.try_emplace(get_host_name_key(info->orgname), info);
+
+	return index;
 }
 
 void DOS_Drive_Cache::CopyEntry(CFileInfo* dir, CFileInfo* from) {
@@ -777,6 +822,11 @@ bool DOS_Drive_Cache::ReadDir(uint16_t id, char* &result) {
 			}
 			return false;
 		}
+		// Start watching for changes before reading, so none are missed
+		if (cached_in_callback) {
+			cached_in_callback(dirPath);
+		}
+
 		// Read complete directory
 		char dir_name[CROSS_LEN];
 		bool is_directory;
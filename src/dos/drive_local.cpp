@@ -8,6 +8,7 @@
 #include "dos/drives.h"
 #include "drive_local.h"
 
+#include <algorithm>
 #include <cerrno>
 #include <climits>
 #include <cstdio>
@@ -15,7 +16,10 @@
 #include <cstring>
 #include <ctime>
 #include <limits>
+#include <memory>
+#include <string>
 #include <sys/types.h>
+#include <unordered_map>
 
 #include "audio/disk_noise.h"
 #include "dos.h"
@@ -25,6 +29,59 @@
 #include "utils/fs_utils.h"
 #include "utils/string_utils.h"
 
+// Reads smaller than this are served from the read-ahead buffer of the file;
+// larger ones go straight to the host file, as buffering wouldn't save any
+// host reads.
+constexpr uint32_t ReadAheadSize       = 64 * 1024;
+constexpr uint32_t DirectReadThreshold = 32 * 1024;
+
+// Each host file with open handles has a write generation, shared by its
+// handles and bumped on every write to the file, so the read-ahead buffers of
+// the other handles can tell whether the data they hold might be out of date
+static std::unordered_map<std::string, std::weak_ptr<uint64_t>> write_generations = {};
+
+static std::shared_ptr<uint64_t> get_write_generation(const std::string& host_path)
+{
+	auto& weak_generation = write_generations[host_path];
+
+	auto generation = weak_generation.lock();
+	if (!generation) {
+		// Forget the file once its last handle releases the generation
+		const auto release = [host_path](uint64_t* released) {
+			delete released;
+
+			const auto it = write_generations.find(host_path);
+			if (it != write_generations.end() && it->second.expired()) {
+				write_generations.erase(it);
+			}
+		};
+		generation      = std::shared_ptr<uint64_t>(new uint64_t(0), release);
+		weak_generation = generation;
+	}
+	return generation;
+}
+
+static void bump_write_generation(const std::string& host_path)
+{
+	const auto it = write_generations.find(host_path);
+	if (it == write_generations.end()) {
+		return;
+	}
+	if (const auto generation = it->second.lock(); generation) {
+		++*generation;
+	}
+}
+
+void localFile::BumpWriteGeneration(const std::string& host_path)
+{
+	bump_write_generation(host_path);
+}
+
+void localFile::UseWriteGenerationOf(const std::string& host_path)
+{
+	write_generation = get_write_generation(host_path);
+}
+
 bool localDrive::FileIsReadOnly(const char* name)
 {
 	FatAttributeFlags test_attr = {};
@@ -50,6 +107,8 @@ std::unique_ptr<DOS_File> localDrive::FileCreate(const char* name,
 		return nullptr;
 	}
 
+	ApplyHostChanges();
+
 	char newname[CROSS_LEN];
 	safe_strcpy(newname, basedir);
 	safe_strcat(newname, name);
@@ -66,6 +125,9 @@ std::unique_ptr<DOS_File> localDrive::FileCreate(const char* name,
 	attributes.archive = true;
 	NativeFileHandle file_handle = create_native_file(expanded_name, attributes);
 
+	// Creating an existing file truncates it
+	bump_write_generation(expanded_name);
+
 	if (file_handle == InvalidNativeFileHandle) {
 		LOG_MSG("Warning: file creation failed: %s", expanded_name);
 		DOS_SetError(DOSERR_ACCESS_DENIED);
@@ -232,6 +294,8 @@ FILE* localDrive::GetHostFilePtr(const char* const name, const char* const type)
 
 std::string localDrive::MapDosToHostFilename(const char* const dos_name)
 {
+	ApplyHostChanges();
+
 	char newname[CROSS_LEN];
 	safe_strcpy(newname, basedir);
 	safe_strcat(newname, dos_name);
@@ -257,6 +321,8 @@ bool localDrive::FileUnlink(const char* name)
 		return false;
 	}
 
+	ApplyHostChanges();
+
 	char newname[CROSS_LEN];
 	safe_strcpy(newname, basedir);
 	safe_strcat(newname, name);
@@ -277,6 +343,8 @@ bool localDrive::FileUnlink(const char* name)
 
 bool localDrive::FindFirst(const char* _dir, DOS_DTA& dta, bool fcb_findfirst)
 {
+	ApplyHostChanges();
+
 	char tempDir[CROSS_LEN];
 	safe_strcpy(tempDir, basedir);
 	safe_strcat(tempDir, _dir);
@@ -444,6 +512,7 @@ bool localDrive::SetFileAttr(const char* name, const FatAttributeFlags attr)
 bool localDrive::MakeDir(const char* dir)
 {
 	assert(!IsReadOnly());
+	ApplyHostChanges();
 
 	char newdir[CROSS_LEN];
 	safe_strcpy(newdir, basedir);
@@ -461,6 +530,7 @@ bool localDrive::MakeDir(const char* dir)
 bool localDrive::RemoveDir(const char* dir)
 {
 	assert(!IsReadOnly());
+	ApplyHostChanges();
 
 	char newdir[CROSS_LEN];
 	safe_strcpy(newdir, basedir);
@@ -531,6 +601,47 @@ uint8_t localDrive::GetMediaByte(void)
 	return allocation.mediaid;
 }
 
+void localDrive::WatchHostChanges()
+{
+	dir_watcher = DirWatcher::Create();
+	if (!dir_watcher) {
+		return;
+	}
+
+	// Watch the directories as they are read into the cache, so changes
+	// in the parts of the drive that haven't been looked at cost nothing
+	dirCache.SetCachedInCallback([this](const char* dir_path) {
+		dir_watcher->Watch(dir_path);
+	});
+
+	// The root directory was read when the drive was created
+	dir_watcher->Watch(basedir);
+}
+
+void localDrive::ApplyHostChanges()
+{
+	if (!dir_watcher) {
+		return;
+	}
+
+	for (const auto& change : dir_watcher->ReadChanges()) {
+		switch (change.type) {
+		case DirWatcher::ChangeType::Added:
+			dirCache.AddHostEntry(change.path.c_str(), change.is_directory);
+			break;
+		case DirWatcher::ChangeType::Removed:
+			timestamp_cache.erase(change.path);
+			dirCache.RemoveHostEntry(change.path.c_str());
+			break;
+		case DirWatcher::ChangeType::Overflow:
+			LOG_DEBUG("FS: Too many changes on the host, re-reading '%s'",
+			          basedir);
+			dirCache.EmptyCache();
+			break;
+		}
+	}
+}
+
 bool localDrive::IsRemote(void)
 {
 	return false;
@@ -580,9 +691,58 @@ bool localFile::Read(uint8_t* data, uint16_t* num_bytes)
 		                                   local_drive.lock()->GetMediaByte()));
 	}
 
-	const auto ret = read_native_file(file_handle, data, *num_bytes);
-	*num_bytes     = check_cast<uint16_t>(ret.num_bytes);
-	if (ret.error) {
+	++read_ahead_stats.dos_reads;
+
+	if (read_ahead.is_valid && read_ahead.generation != *write_generation) {
+		DiscardReadAhead();
+	}
+
+	const uint32_t num_requested = *num_bytes;
+
+	uint32_t num_read = 0;
+	bool read_error   = false;
+
+	while (num_read < num_requested) {
+		if (read_ahead.is_valid && read_ahead.pos < read_ahead.size) {
+			const auto num_buffered = std::min(num_requested - num_read,
+			                                   read_ahead.size - read_ahead.pos);
+			memcpy(data + num_read,
+			       read_ahead.buffer.data() + read_ahead.pos,
+			       num_buffered);
+
+			read_ahead.pos += num_buffered;
+			num_read += num_buffered;
+			continue;
+		}
+
+		const auto num_left = num_requested - num_read;
+		if (num_left >= DirectReadThreshold) {
+			DiscardReadAhead();
+
+			const auto ret = read_native_file(file_handle,
+			                                  data + num_read,
+			                                  num_left);
+			++read_ahead_stats.host_reads;
+
+			num_read += check_cast<uint32_t>(ret.num_bytes);
+			read_error = ret.error;
+			break;
+		}
+
+		if (!FillReadAhead()) {
+			read_error = true;
+			break;
+		}
+		if (read_ahead.size == 0) {
+			// End of file
+			break;
+		}
+	}
+
+	*num_bytes = check_cast<uint16_t>(num_read);
+
+	// Data copied before the error is still returned, like a short read
+	if (read_error && num_read == 0) {
 		DOS_SetError(DOSERR_ACCESS_DENIED);
 		return false;
 	}
@@ -612,6 +772,11 @@ bool localFile::Write(uint8_t* data, uint16_t* num_bytes)
 
 	set_archive_on_close = true;
 
+	// Write at the position seen by the DOS program, and make the other
+	// handles of the file re-read their buffered data
+	DiscardReadAhead();
+	++*write_generation;
+
 	// Truncate the file
 	if (*num_bytes == 0) {
 		if (!truncate_native_file(file_handle)) {
@@ -660,6 +825,11 @@ bool localFile::Seek(uint32_t *pos_addr, uint32_t type)
 			break;
 		}
 		case DOS_SEEK_CUR: {
+			if (read_ahead.is_valid) {
+				const auto current_pos = read_ahead.start + read_ahead.pos;
+				seek_to = check_cast<uint32_t>(current_pos) + *pos_addr;
+				break;
+			}
 			const auto current_pos = get_native_file_position(file_handle);
 			if (current_pos == NativeSeekFailed) {
 				LOG_WARNING("FS: File seek failed for '%s'", path.c_str());
@@ -670,6 +840,8 @@ bool localFile::Seek(uint32_t *pos_addr, uint32_t type)
 			break;
 		}
 		case DOS_SEEK_END: {
+			DiscardReadAhead();
+
 			const auto end_pos = seek_native_file(file_handle, 0, NativeSeek::End);
 			if (end_pos == NativeSeekFailed) {
 				LOG_WARNING("FS: File seek failed for '%s'", path.c_str());
@@ -687,15 +859,36 @@ bool localFile::Seek(uint32_t *pos_addr, uint32_t type)
 		}
 	}
 
+	// Seeks within the buffered data, including the position queries made
+	// before every read, don't need to touch the host file
+	if (read_ahead.is_valid && seek_to >= read_ahead.start &&
+	    seek_to <= read_ahead.start + read_ahead.size) {
+		read_ahead.pos = check_cast<uint32_t>(seek_to - read_ahead.start);
+		++read_ahead_stats.seeks_avoided;
+
+		*pos_addr = seek_to;
+		return true;
+	}
+
 	// Always use NativeSeek::Set set since we calculate the absolute value above
 	auto returned_pos = seek_native_file(file_handle, seek_to, NativeSeek::Set);
 
 	if (returned_pos == NativeSeekFailed) {
+		read_ahead.is_valid = false;
+
 		LOG_WARNING("FS: File seek failed for '%s'", path.c_str());
 		DOS_SetError(DOSERR_ACCESS_DENIED);
 		return false;
 	}
 
+	// Start with an empty buffer at the new position, so the next read
+	// doesn't have to ask for it
+	read_ahead.start      = returned_pos;
+	read_ahead.size       = 0;
+	read_ahead.pos        = 0;
+	read_ahead.generation = *write_generation;
+	read_ahead.is_valid   = true;
+
 	// The returned value is always positive.
 	// It can exceed 32-bit signed max (ex. Blackthorne)
 	*pos_addr = check_cast<uint32_t>(returned_pos);
@@ -703,6 +896,77 @@ bool localFile::Seek(uint32_t *pos_addr, uint32_t type)
 	return true;
 }
 
+bool localFile::FillReadAhead()
+{
+	assert(!read_ahead.is_valid || read_ahead.pos == read_ahead.size);
+
+	if (read_ahead.is_valid) {
+		// The host file position is at the end of the buffered data
+		read_ahead.start += read_ahead.size;
+	} else {
+		const auto current_pos = get_native_file_position(file_handle);
+		if (current_pos == NativeSeekFailed) {
+			return false;
+		}
+		read_ahead.start = current_pos;
+	}
+
+	if (read_ahead.buffer.empty()) {
+		read_ahead.buffer.resize(ReadAheadSize);
+	}
+
+	read_ahead.generation = *write_generation;
+
+	const auto ret = read_native_file(file_handle,
+	                                  read_ahead.buffer.data(),
+	                                  ReadAheadSize);
+	++read_ahead_stats.host_reads;
+
+	read_ahead.size     = check_cast<uint32_t>(ret.num_bytes);
+	read_ahead.pos      = 0;
+	read_ahead.is_valid = !ret.error;
+
+	return !ret.error;
+}
+
+void localFile::DiscardReadAhead()
+{
+	if (!read_ahead.is_valid) {
+		return;
+	}
+	read_ahead.is_valid = false;
+
+	// Move the host file position back to where the DOS program is
+	if (read_ahead.pos != read_ahead.size) {
+		const auto current_pos = read_ahead.start + read_ahead.pos;
+		if (seek_native_file(file_handle, current_pos, NativeSeek::Set) ==
+		    NativeSeekFailed) {
+			LOG_WARNING("FS: File seek failed for '%s'", path.c_str());
+		}
+	}
+}
+
+void localFile::LogReadAheadStats() const
+{
+	const auto& stats = read_ahead_stats;
+	if (stats.dos_reads == 0) {
+		return;
+	}
+
+	// Without buffering, every read is a host read
+	const auto host_reads_saved = (stats.dos_reads > stats.host_reads)
+	                                    ? stats.dos_reads - stats.host_reads
+	                                    : 0;
+
+	LOG_DEBUG("FS: '%s' read-ahead: %llu reads, %llu host reads; "
+	          "%llu host reads and %llu host seeks saved",
+	          path.c_str(),
+	          static_cast<unsigned long long>(stats.dos_reads),
+	          static_cast<unsigned long long>(stats.host_reads),
+	          static_cast<unsigned long long>(host_reads_saved),
+	          static_cast<unsigned long long>(stats.seeks_avoided));
+}
+
 void localFile::MaybeFlushTime()
 {
 	assert(file_handle != InvalidNativeFileHandle);
@@ -761,6 +1025,9 @@ void localFile::Close()
 		// Do it here to be safe even though it means typing this block twice.
 		MaybeFlushTime();
 
+		LogReadAheadStats();
+		read_ahead = {};
+
 		close_native_file(file_handle);
 		file_handle = InvalidNativeFileHandle;
 	} else {
@@ -782,6 +1049,7 @@ localFile::localFile(const char* _name, const char* path,
           file_handle(handle),
           path(path),
           basedir(_basedir),
+          write_generation(get_write_generation(path)),
           read_only_medium(_read_only_medium)
 {
 	assert(file_handle != InvalidNativeFileHandle);
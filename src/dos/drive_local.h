@@ -5,6 +5,10 @@
 #ifndef DOSBOX_DRIVE_LOCAL_H
 #define DOSBOX_DRIVE_LOCAL_H
 
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 #include "dos/dos_system.h"
 #include "dos/drives.h"
 
@@ -23,6 +27,7 @@ public:
 	void Close() override;
 	uint16_t GetInformation() override;
 	bool IsOnReadOnlyMedium() const override { return read_only_medium; }
+	void DiscardReadAhead() override;
 	const char* GetBaseDir() const
 	{
 		return basedir;
@@ -31,14 +36,50 @@ public:
 	{
 		return path;
 	}
+
+	// Makes the open handles of the host file refill their read-ahead
+	// buffers, after the file has been changed by other means
+	static void BumpWriteGeneration(const std::string& host_path);
+
 	const std::weak_ptr<localDrive> local_drive = {};
 	NativeFileHandle file_handle = InvalidNativeFileHandle;
 
+protected:
+	// Shares the write generation of another host file, for handles that
+	// have been switched over to it
+	void UseWriteGenerationOf(const std::string& host_path);
+
 private:
 	void MaybeFlushTime();
+	bool FillReadAhead();
+	void LogReadAheadStats() const;
+
 	const std::string path = {};
 	const char* basedir     = nullptr;
 
+	// Small reads are served from a buffer holding the file contents
+	// after the last host read. While the buffer is valid, the host
+	// file position is at the end of the buffered data, so the buffer
+	// has to be discarded before anything else uses the file position.
+	struct ReadAhead {
+		std::vector<uint8_t> buffer = {};
+
+		int64_t start       = 0; // file position of the first byte
+		uint32_t size       = 0; // number of bytes buffered
+		uint32_t pos        = 0; // read position in the buffer
+		uint64_t generation = 0; // write generation at the last fill
+		bool is_valid       = false;
+	} read_ahead = {};
+
+	// Shared by the open handles of the same host file
+	std::shared_ptr<uint64_t> write_generation = {};
+
+	struct ReadAheadStats {
+		uint64_t dos_reads     = 0;
+		uint64_t host_reads    = 0;
+		uint64_t seeks_avoided = 0;
+	} read_ahead_stats = {};
+
 	const bool read_only_medium = false;
 	bool set_archive_on_close   = false;
 };
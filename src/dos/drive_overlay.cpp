@@ -210,6 +210,9 @@ public:
 	{
 		refCtr = file->refCtr;
 
+		// Leave the file handle at the position the DOS program is at
+		file->DiscardReadAhead();
+
 		// We are taking ownership of the file handle.
 		// Set this to invalid so localFile's destructor won't close it.
 		file->file_handle = InvalidNativeFileHandle;
@@ -296,6 +299,8 @@ bool OverlayFile::create_copy()
 
 	assert(file_handle != InvalidNativeFileHandle);
 
+	DiscardReadAhead();
+
 	const auto location_in_old_file = get_native_file_position(file_handle);
 	if (location_in_old_file == NativeSeekFailed) {
 		LOG_ERR("OVERLAY: Failed getting current position in file '%s': %s",
@@ -311,6 +316,7 @@ bool OverlayFile::create_copy()
 	}
 
 	NativeFileHandle newhandle = InvalidNativeFileHandle;
+	std::string newpath        = {};
 	uint8_t drive_set = GetDrive();
 	if (drive_set != 0xff && drive_set < DOS_DRIVES && Drives[drive_set]){
 		const auto od = std::dynamic_pointer_cast<Overlay_Drive>(
@@ -318,7 +324,6 @@ bool OverlayFile::create_copy()
 		if (od) {
 			FatAttributeFlags attributes = {};
 			local_drive_get_attributes(GetPath().c_str(), attributes);
-			std::string newpath = {};
 			std::tie(newhandle,
 			         newpath) = od->create_file_in_overlay(GetName(),
 			                                               attributes);
@@ -343,6 +348,10 @@ bool OverlayFile::create_copy()
 	}
 	close_native_file(file_handle);
 	file_handle = newhandle;
+
+	// Handles opened on the file from now on open the copy, so share
+	// their write generation
+	UseWriteGenerationOf(newpath);
 	// Flags ?
 	if (logoverlay) LOG_MSG("success");
 	return true;
@@ -569,6 +578,9 @@ std::unique_ptr<DOS_File> Overlay_Drive::FileCreate(const char* name,
 		return nullptr;
 	}
 
+	// Creating an existing file truncates it
+	localFile::BumpWriteGeneration(path);
+
 	const DosDateTime dos_time = {
 		.date = DOS_GetBiosDatePacked(),
 		.time = DOS_GetBiosTimePacked()
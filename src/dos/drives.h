@@ -16,6 +16,7 @@
 #include "config/setup.h"
 #include "dos/dos.h"
 #include "dos/dos_system.h"
+#include "utils/dir_watcher.h"
 
 // GCC throws a warning about non-virtual destructor for std::enable_shared_from_this
 // This is normally a helpful warning. Ex: If DOS_Drive had a non-virtual destructor, it would be a problem.
@@ -99,9 +100,15 @@ public:
 		return basedir;
 	}
 
+	// Keeps the directory cache up to date with the files added, removed
+	// or renamed on the host, if supported by the host
+	void WatchHostChanges();
+
 	std::unordered_map<std::string, DosDateTime> timestamp_cache = {};
 
 protected:
+	void ApplyHostChanges();
+
 	char basedir[CROSS_LEN] = "";
 	struct {
 		char srch_dir[CROSS_LEN] = "";
@@ -114,6 +121,7 @@ private:
 	const bool readonly;
 	const bool always_open_ro_files;
 	std::unordered_set<std::string> write_protected_files;
+	std::unique_ptr<DirWatcher> dir_watcher = {};
 	struct {
 		uint16_t bytes_sector;
 		uint8_t sectors_cluster;
@@ -755,6 +755,10 @@ void MIXER::Run()
 		output.Display();
 		return;
 	}
+	if (cmd->FindExist("/TIMING")) {
+		ShowRenderTimings();
+		return;
+	}
 
 	constexpr auto remove = true;
 
@@ -795,6 +799,7 @@ void MIXER::AddMessages()
 	        "Usage:\n"
 	        "  [color=light-green]mixer[reset] [color=light-cyan][CHANNEL][reset] [color=white]COMMANDS[reset] [/noshow]\n"
 	        "  [color=light-green]mixer[reset] [/listmidi]\n"
+	        "  [color=light-green]mixer[reset] [/timing]\n"
 	        "\n"
 	        "Parameters:\n"
 	        "  [color=light-cyan]CHANNEL[reset]   mixer channel to change the settings of\n"
@@ -810,6 +815,7 @@ void MIXER::AddMessages()
 	        "Notes:\n"
 	        "  - Run [color=light-green]mixer[reset] without arguments to view the current settings.\n"
 	        "  - Run [color=light-green]mixer[reset] /listmidi to list all available MIDI devices.\n"
+	        "  - Run [color=light-green]mixer[reset] /timing to show how long each channel takes to render.\n"
 	        "  - You may change the settings of more than one channel in a single command.\n"
 	        "  - If no channel is specified, you can set crossfeed, reverb, or chorus\n"
 	        "    of all channels globally.\n"
@@ -825,6 +831,11 @@ void MIXER::AddMessages()
 	MSG_Add("SHELL_CMD_MIXER_HEADER_LABELS",
 	        "[color=white]Channel      Volume    Volume (dB)   Mode     Xfeed  Reverb  Chorus[reset]");
 
+	MSG_Add("SHELL_CMD_MIXER_TIMING_LAYOUT", "%-22s %8d %9.2f %9.2f %7.1f%%");
+
+	MSG_Add("SHELL_CMD_MIXER_TIMING_LABELS",
+	        "[color=white]Channel       Blocks  Avg (ms) Peak (ms)     Load[reset]");
+
 	MSG_Add("SHELL_CMD_MIXER_CHANNEL_OFF", "off");
 	MSG_Add("SHELL_CMD_MIXER_CHANNEL_STEREO", "Stereo");
 	MSG_Add("SHELL_CMD_MIXER_CHANNEL_REVERSE", "Reverse");
@@ -991,3 +1002,31 @@ void MIXER::ShowMixerStatus()
 
 	WriteOut("\n");
 }
+
+void MIXER::ShowRenderTimings()
+{
+	std::string column_layout = MSG_Get("SHELL_CMD_MIXER_TIMING_LAYOUT");
+	column_layout.append({'\n'});
+
+	WriteOut(MSG_Get("SHELL_CMD_MIXER_TIMING_LABELS"));
+	WriteOut("\n");
+
+	constexpr auto MicrosInMillisecondF = static_cast<double>(MicrosInMillisecond);
+
+	for (auto& [name, chan] : MIXER_GetChannels()) {
+		const auto channel_name = convert_ansi_markup(
+		        std::string("[color=light-cyan]") + name +
+		        std::string("[reset]"));
+
+		const auto timings = chan->GetRenderTimings();
+
+		WriteOut(column_layout,
+		         channel_name.c_str(),
+		         timings.num_blocks,
+		         static_cast<double>(timings.average_us) / MicrosInMillisecondF,
+		         static_cast<double>(timings.peak_us) / MicrosInMillisecondF,
+		         static_cast<double>(timings.load_percent));
+	}
+
+	WriteOut("\n");
+}
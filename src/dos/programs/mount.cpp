@@ -1192,7 +1192,7 @@ void MOUNT::MountLocal(MountParameters& params, const std::string& local_path)
 		const auto section = get_section("dosbox");
 
 		// Standard directory mount
-		newdrive = std::make_shared<localDrive>(
+		auto local_drive = std::make_shared<localDrive>(
 		        final_path.c_str(),
 		        params.sizes[0],
 		        int8_tize,
@@ -1201,6 +1201,9 @@ void MOUNT::MountLocal(MountParameters& params, const std::string& local_path)
 		        params.mediaid,
 		        params.roflag,
 		        section->GetBool("allow_write_protected_files"));
+
+		local_drive->WatchHostChanges();
+		newdrive = local_drive;
 	}
 
 	DriveManager::RegisterFilesystemImage(drive_index(params.drive), newdrive);
@@ -92,6 +92,13 @@ static struct {
 	bool locked       = {};
 } ticks = {};
 
+static DOSBOX_IdleStats idle_stats = {};
+
+DOSBOX_IdleStats DOSBOX_GetIdleStats()
+{
+	return idle_stats;
+}
+
 // Reset wall-clock accounting on resume so `increase_ticks()` doesn't see
 // a multi-second gap from before pause and try to "catch up" by running
 // tens of seconds of emulation in a burst. PIC time is frozen across
@@ -645,13 +652,30 @@ static void increase_ticks()
 		// flat 1ms, to wake up as close to the next tick as possible.
 		const auto next_tick_us = (ticks.last + 1) * MicrosInMillisecond;
 		const auto sleep_us = next_tick_us - ticks_new_us;
+
+		// The precise delay busy-waits for sub-millisecond sleeps. That's
+		// wasted when the guest is waiting in HLT, as the next interrupt
+		// can't arrive before the next tick anyway, so we yield the host
+		// CPU to the OS instead and accept a little wake-up jitter.
+		const auto is_guest_idle = CPU_IsHaltedWaitingForInterrupt();
+
 		if (sleep_us > 0) {
-			SDL_DelayPrecise(static_cast<uint64_t>(sleep_us) * 1000);
+			const auto sleep_ns = static_cast<uint64_t>(sleep_us) * 1000;
+			if (is_guest_idle) {
+				SDL_DelayNS(sleep_ns);
+			} else {
+				SDL_DelayPrecise(sleep_ns);
+			}
 		}
 
 		const auto time_slept_us = GetTicksUsSince(ticks_new_us);
 		cumulative_time_slept_us += time_slept_us;
 
+		if (is_guest_idle) {
+			++idle_stats.num_idle_ticks;
+			idle_stats.time_slept_us += time_slept_us;
+		}
+
 		// Update ticks.done with the total time spent sleeping
 		if (cumulative_time_slept_us >= MicrosInMillisecond) {
 			// 1 tick == 1 millisecond
@@ -1225,6 +1249,13 @@ void DOSBOX_Init()
 
 void DOSBOX_Destroy()
 {
+	if (idle_stats.num_idle_ticks > 0) {
+		LOG_DEBUG("DOSBOX: Slept %lld ms over %lld ticks while the guest was idle",
+		          static_cast<long long>(idle_stats.time_slept_us / MicrosInMillisecond),
+		          static_cast<long long>(idle_stats.num_idle_ticks));
+	}
+	idle_stats = {};
+
 	CMOS_Destroy();
 	TIMER_Destroy();
 	PROGRAMS_Destroy();
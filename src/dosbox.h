@@ -103,6 +103,15 @@ int64_t DOSBOX_GetTicksDone();
 void DOSBOX_SetTicksDone(const int64_t ticks_done);
 void DOSBOX_SetTicksScheduled(const int64_t ticks_scheduled);
 
+// Host time slept while the guest was idling in HLT, which used to be spent
+// busy-waiting for the next tick
+struct DOSBOX_IdleStats {
+	int64_t num_idle_ticks = 0;
+	int64_t time_slept_us  = 0;
+};
+
+DOSBOX_IdleStats DOSBOX_GetIdleStats();
+
 void DOSBOX_Restart();
 void DOSBOX_Restart(std::vector<std::string>& parameters);
 
@@ -5,8 +5,10 @@
 #define DOSBOX_GUI_PRIVATE_COMMON_H
 
 #include <optional>
+#include <span>
 
 #include "dosbox_config.h"
+#include "gui/render/private/dirty_regions.h"
 #include "misc/video.h"
 #include "utils/fraction.h"
 #include "utils/rect.h"
@@ -99,6 +101,11 @@ void GFX_Stop();
 // the framebuffer).
 bool GFX_StartUpdate(uint32_t*& pixels, int& pitch);
 
+// Optionally called before GFX_EndUpdate() with the areas of the framebuffer
+// that have been written to in the current frame. The whole framebuffer is
+// assumed to have changed otherwise.
+void GFX_MarkDirtyRegions(std::span<const DirtyRegion> regions);
+
 // Called at the end of every frame, regardless of whether there have been
 // changes to the framebuffer or not.
 void GFX_EndUpdate();
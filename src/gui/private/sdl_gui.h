@@ -155,6 +155,14 @@ struct SDL_Block {
 		int frame_time_us            = 0;
 		int early_present_window_us  = 0;
 		int64_t last_present_time_us = 0;
+
+		// True if there's anything new to present since the last
+		// present: a changed frame, or any change to the renderer or
+		// the window that might affect the rendered output.
+		bool needs_present = true;
+
+		uint64_t num_presents         = 0;
+		uint64_t num_skipped_presents = 0;
 	} presentation = {};
 
 	struct {
@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "private/dirty_regions.h"
+
+#include <algorithm>
+
+#include "utils/checks.h"
+
+CHECK_NARROWING();
+
+void DirtyRegions::Resize(const int width, const int height)
+{
+	fb_width  = width;
+	fb_height = height;
+
+	MarkAll();
+}
+
+void DirtyRegions::MarkAll()
+{
+	regions.clear();
+	all = true;
+}
+
+void DirtyRegions::Clear()
+{
+	regions.clear();
+	all = false;
+}
+
+void DirtyRegions::Add(const DirtyRegion& region)
+{
+	if (all) {
+		return;
+	}
+
+	const auto x1 = std::max(region.x, 0);
+	const auto y1 = std::max(region.y, 0);
+	const auto x2 = std::min(region.x + region.width, fb_width);
+	const auto y2 = std::min(region.y + region.height, fb_height);
+
+	if (x1 >= x2 || y1 >= y2) {
+		return;
+	}
+
+	if (regions.size() < MaxRegions) {
+		regions.push_back({x1, y1, x2 - x1, y2 - y1});
+		return;
+	}
+
+	// Too many regions; merge them all into their bounding box
+	auto min_x = x1;
+	auto min_y = y1;
+	auto max_x = x2;
+	auto max_y = y2;
+
+	for (const auto& r : regions) {
+		min_x = std::min(min_x, r.x);
+		min_y = std::min(min_y, r.y);
+		max_x = std::max(max_x, r.x + r.width);
+		max_y = std::max(max_y, r.y + r.height);
+	}
+
+	regions.clear();
+	regions.push_back({min_x, min_y, max_x - min_x, max_y - min_y});
+}
+
+void DirtyRegions::Add(const std::span<const DirtyRegion> other_regions)
+{
+	for (const auto& region : other_regions) {
+		Add(region);
+	}
+}
+
+void DirtyRegions::Add(const DirtyRegions& other)
+{
+	if (other.IsAll()) {
+		MarkAll();
+	} else {
+		Add(other.GetRegions());
+	}
+}
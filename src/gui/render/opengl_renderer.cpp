@@ -5,6 +5,8 @@
 
 #if C_OPENGL
 
+#include <algorithm>
+
 #include "gui/private/common.h"
 #include "private/auto_shader_switcher.h"
 #include "private/shader_manager.h"
@@ -418,6 +420,10 @@ void OpenGlRenderer::RecreateInputTexture()
 	curr_framebuf.resize(num_pixels);
 	last_framebuf.resize(num_pixels);
 
+	// The new texture needs a full upload
+	frame_dirty_regions.Resize(input_texture.width, input_texture.height);
+	upload_dirty_regions.Resize(input_texture.width, input_texture.height);
+
 	constexpr auto BytesPerPixel = sizeof(uint32_t);
 	const auto pitch_bytes       = pitch_pixels * BytesPerPixel;
 
@@ -435,6 +441,12 @@ void OpenGlRenderer::StartFrame(uint32_t*& pixels_out, int& pitch_out)
 	pitch_out = input_texture.pitch;
 }
 
+void OpenGlRenderer::MarkDirtyRegions(const std::span<const DirtyRegion> regions)
+{
+	frame_dirty_regions.Clear();
+	frame_dirty_regions.Add(regions);
+}
+
 void OpenGlRenderer::EndFrame()
 {
 	assert(!curr_framebuf.empty());
@@ -442,9 +454,30 @@ void OpenGlRenderer::EndFrame()
 
 	// We need to copy the buffers. We can't just swap them because the VGA
 	// emulation only writes the changed pixels to the framebuffer in each
-	// frame.
+	// frame. For the same reason, it's enough to copy the changed areas.
+
+	if (frame_dirty_regions.IsAll()) {
+		last_framebuf = curr_framebuf;
+	} else {
+		const auto pitch_pixels = static_cast<size_t>(input_texture.width);
+
+		for (const auto& r : frame_dirty_regions.GetRegions()) {
+			for (auto y = r.y; y < r.y + r.height; ++y) {
+				const auto offset = static_cast<size_t>(y) * pitch_pixels +
+				                    static_cast<size_t>(r.x);
+
+				std::copy_n(curr_framebuf.data() + offset,
+				            r.width,
+				            last_framebuf.data() + offset);
+			}
+		}
+	}
+
+	upload_dirty_regions.Add(frame_dirty_regions);
+
+	// Assume the whole frame changes unless told otherwise next time
+	frame_dirty_regions.MarkAll();
 
-	last_framebuf       = curr_framebuf;
 	last_framebuf_dirty = true;
 }
 
@@ -456,19 +489,45 @@ void OpenGlRenderer::PrepareFrame()
 		glActiveTexture(GL_TEXTURE0);
 		glBindTexture(GL_TEXTURE_2D, input_texture.texture);
 
-		glTexSubImage2D(GL_TEXTURE_2D,
-		                0, // mimap level (0 = base image)
-		                0, // x offset
-		                0, // y offset
-		                input_texture.width,  // width
-		                input_texture.height, // height
-		                GL_BGRA,              // pixel data format
-		                GL_UNSIGNED_INT_8_8_8_8_REV, // pixel data type
-		                last_framebuf.data() // pointer to image data
-		);
+		if (upload_dirty_regions.IsAll()) {
+			glTexSubImage2D(GL_TEXTURE_2D,
+			                0, // mimap level (0 = base image)
+			                0, // x offset
+			                0, // y offset
+			                input_texture.width,  // width
+			                input_texture.height, // height
+			                GL_BGRA,              // pixel data format
+			                GL_UNSIGNED_INT_8_8_8_8_REV, // pixel data type
+			                last_framebuf.data() // pointer to image data
+			);
+		} else {
+			// Only upload the changed areas; the row length tells
+			// OpenGL the pitch of the source image
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, input_texture.width);
+
+			for (const auto& r : upload_dirty_regions.GetRegions()) {
+				const auto offset = static_cast<size_t>(r.y) *
+				                            static_cast<size_t>(
+				                                    input_texture.width) +
+				                    static_cast<size_t>(r.x);
+
+				glTexSubImage2D(GL_TEXTURE_2D,
+				                0,        // mimap level (0 = base image)
+				                r.x,      // x offset
+				                r.y,      // y offset
+				                r.width,  // width
+				                r.height, // height
+				                GL_BGRA,  // pixel data format
+				                GL_UNSIGNED_INT_8_8_8_8_REV, // pixel data type
+				                last_framebuf.data() + offset);
+			}
+
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		}
 
 		glBindTexture(GL_TEXTURE_2D, 0);
 
+		upload_dirty_regions.Clear();
 		last_framebuf_dirty = false;
 	}
 }
@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef DOSBOX_DIRTY_REGIONS_H
+#define DOSBOX_DIRTY_REGIONS_H
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// A rectangular area of the framebuffer, in pixels
+struct DirtyRegion {
+	int x      = 0;
+	int y      = 0;
+	int width  = 0;
+	int height = 0;
+};
+
+// Keeps track of the changed areas of a framebuffer so the render backends
+// only have to copy and upload those instead of the whole frame.
+//
+// The "everything has changed" state is tracked separately from the list of
+// regions; this is the initial state, and the state to fall back to whenever
+// we don't know exactly what has changed.
+//
+class DirtyRegions {
+public:
+	// Sets the framebuffer size regions are clipped to, and marks the
+	// whole framebuffer as changed
+	void Resize(int width, int height);
+
+	void MarkAll();
+	void Clear();
+
+	void Add(const DirtyRegion& region);
+	void Add(std::span<const DirtyRegion> regions);
+	void Add(const DirtyRegions& other);
+
+	bool IsEmpty() const
+	{
+		return !all && regions.empty();
+	}
+
+	bool IsAll() const
+	{
+		return all;
+	}
+
+	// Only meaningful if IsAll() is false
+	std::span<const DirtyRegion> GetRegions() const
+	{
+		return regions;
+	}
+
+private:
+	// Past this we merge everything into a single bounding box; the
+	// scalers produce at most a handful of regions per frame in practice
+	static constexpr size_t MaxRegions = 32;
+
+	std::vector<DirtyRegion> regions = {};
+
+	int fb_width  = 0;
+	int fb_height = 0;
+
+	bool all = true;
+};
+
+#endif // DOSBOX_DIRTY_REGIONS_H
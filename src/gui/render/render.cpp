@@ -9,6 +9,7 @@
 #include <cstdlib>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "private/auto_image_adjustments.h"
 #include "private/auto_shader_switcher.h"
@@ -383,9 +384,36 @@ static void latch_last_complete_source()
 	render.last_complete_source.palette   = render.palette;
 	render.last_complete_source.pitch     = render.scale.cache_pitch;
 	render.last_complete_source.valid     = true;
+	render.last_complete_source.up_to_date = true;
 	render.last_complete_source.populated = true;
 }
 
+// Tells the render backend which parts of the framebuffer the scaler has
+// written to in this frame, so it only needs to copy and upload those.
+static void mark_dirty_regions()
+{
+	static std::vector<DirtyRegion> regions = {};
+	regions.clear();
+
+	// Runs of unchanged and changed lines alternate, starting with an
+	// unchanged run
+	auto y = 0;
+	for (auto i = 0; i <= scaler_changed_line_index; ++i) {
+		const auto num_lines = scaler_changed_lines[i];
+
+		if (i & 1) {
+			const auto& extent = scaler_changed_extents[i];
+			regions.push_back({extent.x_begin,
+			                   y,
+			                   extent.x_end - extent.x_begin,
+			                   num_lines});
+		}
+		y += num_lines;
+	}
+
+	GFX_MarkDirtyRegions(regions);
+}
+
 void RENDER_EndUpdate(const bool abort)
 {
 	if (!render.render_in_progress) {
@@ -394,10 +422,21 @@ void RENDER_EndUpdate(const bool abort)
 
 	RENDER_DrawLine = empty_line_handler;
 
+	// Nothing has been written to the line cache or the render backend in
+	// this frame, and the palette is the same
+	const auto is_static_frame = !render.updating_frame &&
+	                             !render.palette.changed;
+	if (is_static_frame) {
+		++render.num_static_frames;
+	} else {
+		render.last_complete_source.up_to_date = false;
+	}
+
 	// Latch the just-finished frame before any consumer (capture,
 	// deinterlace) runs, so anything that reads via the latch sees the fresh
 	// frame, not the previous one.
-	if (!abort) {
+	if (!abort && !(is_static_frame && render.last_complete_source.valid &&
+	                render.last_complete_source.up_to_date)) {
 		latch_last_complete_source();
 	}
 
@@ -421,6 +460,11 @@ void RENDER_EndUpdate(const bool abort)
 	// Only deinterlace the output if the frame has changed
 	if (is_deinterlacing() && render.updating_frame) {
 		deinterlace_rendered_output();
+
+	} else if (render.updating_frame) {
+		// The deinterlacer rewrites the whole output, so we only know
+		// the changed regions if it's off
+		mark_dirty_regions();
 	}
 
 	GFX_EndUpdate();
@@ -617,6 +661,8 @@ static void render_reset()
 	RENDER_DrawLine        = finish_line_handler;
 	render.scale.out_write = nullptr;
 
+	render.last_complete_source.up_to_date = false;
+
 	// Signal the next frame to first reinit the cache
 	render.scale.clear_cache = true;
 	render.active            = true;
@@ -625,6 +671,10 @@ static void render_reset()
 static void render_callback(GFX_CallbackFunctions_t function)
 {
 	if (function == GFX_CallbackStop) {
+		if (render.num_static_frames > 0) {
+			LOG_DEBUG("RENDER: %llu frames were unchanged and not re-latched",
+			          static_cast<unsigned long long>(render.num_static_frames));
+		}
 		halt_render();
 		return;
 
@@ -138,6 +138,11 @@ struct Render {
 		// the latch, the held bytes are the only source we can
 		// replay through the freshly-configured scaler.
 		bool populated = false;
+
+		// `false` when `scale.cache` might have changed since the last
+		// latch. If it hasn't, re-latching would copy the exact same
+		// data, so we skip it for unchanged frames.
+		bool up_to_date = false;
 	} last_complete_source = {};
 
 	RenderPalette palette = {};
@@ -148,6 +153,9 @@ struct Render {
 	bool render_in_progress = false;
 	bool updating_frame     = false;
 
+	// Frames identical to the previous one, including the palette
+	uint64_t num_static_frames = 0;
+
 	AspectRatioCorrectionMode aspect_ratio_correction_mode = {};
 	IntegerScalingMode integer_scaling_mode                = {};
 
@@ -4,6 +4,7 @@
 #ifndef DOSBOX_RENDER_BACKEND_H
 #define DOSBOX_RENDER_BACKEND_H
 
+#include <span>
 #include <string>
 
 #include "gui/private/common.h"
@@ -93,6 +94,15 @@ public:
 	//
 	virtual void StartFrame(uint32_t*& pixels_out, int& pitch_out) = 0;
 
+	// Optionally called between StartFrame() and EndFrame() with the areas
+	// of the framebuffer written to in the current frame. If it's not
+	// called, the whole framebuffer should be treated as changed.
+	//
+	// Renderers can use this to only copy and upload the changed parts of
+	// the frame.
+	//
+	virtual void MarkDirtyRegions(std::span<const DirtyRegion> regions) = 0;
+
 	// Called at the end of every frame. There is a matching EndUpdate()
 	// call for every StartUpdate() call.
 	//
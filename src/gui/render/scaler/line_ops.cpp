@@ -0,0 +1,182 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "line_ops.h"
+
+#include <bit>
+
+#include "simde/x86/sse2.h"
+
+#include "utils/checks.h"
+
+CHECK_NARROWING();
+
+static simde__m128i load(const void* p)
+{
+	return simde_mm_loadu_si128(static_cast<const simde__m128i*>(p));
+}
+
+static void store(void* p, const simde__m128i v)
+{
+	simde_mm_storeu_si128(static_cast<simde__m128i*>(p), v);
+}
+
+// Returns a 16-bit mask with a bit set for every byte that differs
+static uint32_t diff_mask(const uint8_t* a, const uint8_t* b)
+{
+	const auto eq = simde_mm_cmpeq_epi8(load(a), load(b));
+	return ~static_cast<uint32_t>(simde_mm_movemask_epi8(eq)) & 0xffff;
+}
+
+size_t find_first_changed_byte(const uint8_t* a, const uint8_t* b,
+                               const size_t num_bytes)
+{
+	size_t pos = 0;
+
+	// Unchanged runs are usually long, so check 64 bytes per iteration
+	// and only narrow down the position once we've found a difference.
+	while (pos + 64 <= num_bytes) {
+		const auto eq = simde_mm_and_si128(
+		        simde_mm_and_si128(simde_mm_cmpeq_epi8(load(a + pos),
+		                                               load(b + pos)),
+		                           simde_mm_cmpeq_epi8(load(a + pos + 16),
+		                                               load(b + pos + 16))),
+		        simde_mm_and_si128(simde_mm_cmpeq_epi8(load(a + pos + 32),
+		                                               load(b + pos + 32)),
+		                           simde_mm_cmpeq_epi8(load(a + pos + 48),
+		                                               load(b + pos + 48))));
+
+		if (simde_mm_movemask_epi8(eq) != 0xffff) {
+			break;
+		}
+		pos += 64;
+	}
+
+	while (pos + 16 <= num_bytes) {
+		const auto mask = diff_mask(a + pos, b + pos);
+		if (mask != 0) {
+			return pos + static_cast<size_t>(std::countr_zero(mask));
+		}
+		pos += 16;
+	}
+
+	while (pos < num_bytes && a[pos] == b[pos]) {
+		++pos;
+	}
+	return pos;
+}
+
+void convert_indexed_to_bgrx(const uint8_t* src, const uint32_t* palette_lut,
+                             uint32_t* dest, const int num_pixels)
+{
+	// There's no gather in SSE2, and a plain table lookup is about as fast
+	// as it gets anyway
+	for (auto i = 0; i < num_pixels; ++i) {
+		dest[i] = palette_lut[src[i]];
+	}
+}
+
+static uint32_t rgb555_to_bgrx(const uint32_t v)
+{
+	return ((v & (31 << 10)) << 9) | ((v & (31 << 5)) << 6) |
+	       ((v & 31) << 3) | ((v & (7 << 12)) << 4) |
+	       ((v & (7 << 7)) << 1) | ((v & (7 << 2)) >> 2);
+}
+
+static simde__m128i rgb555_to_bgrx(const simde__m128i v)
+{
+	const auto bits = [&](const int mask) {
+		return simde_mm_and_si128(v, simde_mm_set1_epi32(mask));
+	};
+
+	const auto r = simde_mm_or_si128(simde_mm_slli_epi32(bits(31 << 10), 9),
+	                                 simde_mm_slli_epi32(bits(7 << 12), 4));
+
+	const auto g = simde_mm_or_si128(simde_mm_slli_epi32(bits(31 << 5), 6),
+	                                 simde_mm_slli_epi32(bits(7 << 7), 1));
+
+	const auto b = simde_mm_or_si128(simde_mm_slli_epi32(bits(31), 3),
+	                                 simde_mm_srli_epi32(bits(7 << 2), 2));
+
+	return simde_mm_or_si128(r, simde_mm_or_si128(g, b));
+}
+
+static uint32_t rgb565_to_bgrx(const uint32_t v)
+{
+	return ((v & (31 << 11)) << 8) | ((v & (63 << 5)) << 5) |
+	       ((v & 0xe01f) << 3) | ((v & (3 << 9)) >> 1) | ((v & (7 << 2)) >> 2);
+}
+
+static simde__m128i rgb565_to_bgrx(const simde__m128i v)
+{
+	const auto bits = [&](const int mask) {
+		return simde_mm_and_si128(v, simde_mm_set1_epi32(mask));
+	};
+
+	const auto r = simde_mm_or_si128(simde_mm_slli_epi32(bits(31 << 11), 8),
+	                                 simde_mm_slli_epi32(bits(0xe000), 3));
+
+	const auto g = simde_mm_or_si128(simde_mm_slli_epi32(bits(63 << 5), 5),
+	                                 simde_mm_srli_epi32(bits(3 << 9), 1));
+
+	const auto b = simde_mm_or_si128(simde_mm_slli_epi32(bits(31), 3),
+	                                 simde_mm_srli_epi32(bits(7 << 2), 2));
+
+	return simde_mm_or_si128(r, simde_mm_or_si128(g, b));
+}
+
+// Expands 8 16-bit pixels at a time; the per-lane operations are exactly the
+// same as in the scalar version
+template <simde__m128i (*ConvertLanes)(simde__m128i), uint32_t (*ConvertPixel)(uint32_t)>
+static void convert_16bit_to_bgrx(const uint16_t* src, uint32_t* dest,
+                                  const int num_pixels)
+{
+	const auto zero = simde_mm_setzero_si128();
+
+	auto i = 0;
+	for (; i + 8 <= num_pixels; i += 8) {
+		const auto pixels = load(src + i);
+
+		store(dest + i, ConvertLanes(simde_mm_unpacklo_epi16(pixels, zero)));
+		store(dest + i + 4, ConvertLanes(simde_mm_unpackhi_epi16(pixels, zero)));
+	}
+	for (; i < num_pixels; ++i) {
+		dest[i] = ConvertPixel(src[i]);
+	}
+}
+
+void convert_rgb555_to_bgrx(const uint16_t* src, uint32_t* dest, const int num_pixels)
+{
+	convert_16bit_to_bgrx<rgb555_to_bgrx, rgb555_to_bgrx>(src, dest, num_pixels);
+}
+
+void convert_rgb565_to_bgrx(const uint16_t* src, uint32_t* dest, const int num_pixels)
+{
+	convert_16bit_to_bgrx<rgb565_to_bgrx, rgb565_to_bgrx>(src, dest, num_pixels);
+}
+
+void convert_bgr24_to_bgrx(const uint8_t* src, uint32_t* dest, const int num_pixels)
+{
+	// SSE2 has no byte shuffle, so we line up the four pixels in the first
+	// 12 bytes of a 16-byte load with byte shifts instead. The load reads 4
+	// bytes past the last pixel, hence the loop condition.
+	const auto colour_mask = simde_mm_set1_epi32(0x00ffffff);
+
+	auto i = 0;
+	for (; (num_pixels - i) * 3 >= 16; i += 4) {
+		const auto p0 = load(src + i * 3);
+		const auto p1 = simde_mm_srli_si128(p0, 3);
+		const auto p2 = simde_mm_srli_si128(p0, 6);
+		const auto p3 = simde_mm_srli_si128(p0, 9);
+
+		const auto p01 = simde_mm_unpacklo_epi32(p0, p1);
+		const auto p23 = simde_mm_unpacklo_epi32(p2, p3);
+
+		store(dest + i,
+		      simde_mm_and_si128(simde_mm_unpacklo_epi64(p01, p23), colour_mask));
+	}
+	for (; i < num_pixels; ++i) {
+		const auto p = src + i * 3;
+		dest[i] = static_cast<uint32_t>(p[0] | (p[1] << 8) | (p[2] << 16));
+	}
+}
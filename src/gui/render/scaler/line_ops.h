@@ -0,0 +1,35 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef DOSBOX_RENDER_LINE_OPS_H
+#define DOSBOX_RENDER_LINE_OPS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Scanline primitives used by the simple scalers. They're vectorised with
+// SIMDe, so they use SSE2 on x86 and NEON on ARM, and fall back to portable
+// scalar code elsewhere.
+//
+// None of these functions read or write past the end of the passed in
+// buffers.
+
+// Returns the offset of the first byte that differs between `a` and `b`, or
+// `num_bytes` if the two buffers are identical.
+size_t find_first_changed_byte(const uint8_t* a, const uint8_t* b, size_t num_bytes);
+
+// The output of all conversions is 32-bit BGRX with the X byte set to zero.
+
+void convert_indexed_to_bgrx(const uint8_t* src, const uint32_t* palette_lut,
+                             uint32_t* dest, int num_pixels);
+
+// xRRRrrGGGggBBBbb -> RRRrrRRRGGGggGGGBBBbbBBB
+void convert_rgb555_to_bgrx(const uint16_t* src, uint32_t* dest, int num_pixels);
+
+// RRRrrGGggggBBBbb -> RRRrrRRRGGggggGGBBBbbBBB
+void convert_rgb565_to_bgrx(const uint16_t* src, uint32_t* dest, int num_pixels);
+
+// Packed 3-byte pixels in B, G, R byte order
+void convert_bgr24_to_bgrx(const uint8_t* src, uint32_t* dest, int num_pixels);
+
+#endif // DOSBOX_RENDER_LINE_OPS_H
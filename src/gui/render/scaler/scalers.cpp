@@ -10,7 +10,9 @@
 
 #include "gui/private/common.h"
 #include "gui/render/render.h"
+#include "gui/render/scaler/line_ops.h"
 
+#include <algorithm>
 #include <array>
 #include <cstring>
 
@@ -18,15 +20,28 @@ std::array<int, ScalerMaxHeight> scaler_changed_lines = {};
 
 int scaler_changed_line_index = 0;
 
+std::array<ScalerChangedExtent, ScalerMaxHeight> scaler_changed_extents = {};
+
 #define _conc3(A, B, C) A##B##C
 #define conc2d(A, B)    _conc3(A, _, B)
 
-static inline void scaler_add_lines(int changed, int count)
+static inline void scaler_add_lines(int changed, int count, int x_begin, int x_end)
 {
 	if ((scaler_changed_line_index & 1) == changed) {
 		scaler_changed_lines[scaler_changed_line_index] += count;
+
+		if (changed) {
+			auto& extent = scaler_changed_extents[scaler_changed_line_index];
+			extent.x_begin = std::min(extent.x_begin, x_begin);
+			extent.x_end   = std::max(extent.x_end, x_end);
+		}
 	} else {
 		scaler_changed_lines[++scaler_changed_line_index] = count;
+
+		if (changed) {
+			scaler_changed_extents[scaler_changed_line_index] = {x_begin,
+			                                                     x_end};
+		}
 	}
 	render.scale.out_write += render.scale.out_pitch * count;
 }
@@ -12,9 +12,8 @@
 // The additional padding pixels are party for some tweaked text modes (e.g.,
 // Q200x25x8 used by Necromancer's DOS Navigator) plus as a safety margin.
 //
-// This ensures we're not going to crash in the 1600x1200 24-bit (BGR24)
-// 0x184 VESA mode when reading a few bytes beyond the end of the buffer (see
-// comment above `PixelsPerStep` in `scaler/simple.h`).
+// The line handlers in `scaler/simple.h` never read past the end of the
+// scanline, but the margin is kept in case a video mode misreports its width.
 
 // Make sure ScalerMaxWidth remains a multiple of 8
 constexpr int ScalerWidthExtraPadding = 8 * 5;
@@ -22,9 +21,20 @@ constexpr int ScalerWidthExtraPadding = 8 * 5;
 constexpr int ScalerMaxWidth  = 1600 + ScalerWidthExtraPadding;
 constexpr int ScalerMaxHeight = 1200;
 
+// Alternating runs of unchanged and changed output lines of the current frame,
+// starting with an unchanged run (which can be empty)
 extern std::array<int, ScalerMaxHeight> scaler_changed_lines;
 extern int scaler_changed_line_index;
 
+// The horizontal extent of the changed pixels in each run of changed lines,
+// in output pixels. Only the odd (changed) entries are valid.
+struct ScalerChangedExtent {
+	int x_begin = 0;
+	int x_end   = 0;
+};
+
+extern std::array<ScalerChangedExtent, ScalerMaxHeight> scaler_changed_extents;
+
 typedef void (*ScalerLineHandler)(const void* src);
 
 struct Scaler {
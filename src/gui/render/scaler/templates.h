@@ -3,37 +3,32 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #if SBPP == 8 || SBPP == 9
-#define PMAKE(_VAL) render.palette.lut[_VAL]
-#define SRCTYPE     uint8_t
+#define PCONVERT(_SRC, _DEST, _NUM) \
+	convert_indexed_to_bgrx(_SRC, render.palette.lut, _DEST, _NUM)
+#define SRCTYPE uint8_t
 #endif
 
 #if SBPP == 15
-#// xRRRrrGGGggBBBbb -> RRRrrRRRGGGggGGGBBBbbBBB
-#define PMAKE(_VAL) \
-	(((_VAL & (31 << 10)) << 9) | ((_VAL & (31 << 5)) << 6) | \
-	 ((_VAL & 31) << 3) | ((_VAL & (7 << 12)) << 4) | \
-	 ((_VAL & (7 << 7)) << 1) | ((_VAL & (7 << 2)) >> 2))
-#define SRCTYPE uint16_t
+#define PCONVERT(_SRC, _DEST, _NUM) convert_rgb555_to_bgrx(_SRC, _DEST, _NUM)
+#define SRCTYPE                     uint16_t
 #endif
 
 #if SBPP == 16
-#// RRRrrGGggggBBBbb -> RRRrrRRRGGggggGGBBBbbBBB
-#define PMAKE(_VAL) \
-	(((_VAL & (31 << 11)) << 8) | ((_VAL & (63 << 5)) << 5) | \
-	 ((_VAL & 0xE01F) << 3) | ((_VAL & (3 << 9)) >> 1) | \
-	 ((_VAL & (7 << 2)) >> 2))
-#define SRCTYPE uint16_t
+#define PCONVERT(_SRC, _DEST, _NUM) convert_rgb565_to_bgrx(_SRC, _DEST, _NUM)
+#define SRCTYPE                     uint16_t
 #endif
 
 #if SBPP == 24
-#define PMAKE(_VAL) (_VAL)
 #include "utils/rgb888.h"
+#define PCONVERT(_SRC, _DEST, _NUM) \
+	convert_bgr24_to_bgrx(reinterpret_cast<const uint8_t*>(_SRC), _DEST, _NUM)
 #define SRCTYPE Rgb888
 #endif
 
 #if SBPP == 32
-#define PMAKE(_VAL) (_VAL)
-#define SRCTYPE     uint32_t
+#define PCONVERT(_SRC, _DEST, _NUM) \
+	std::memcpy(_DEST, _SRC, (_NUM) * sizeof(uint32_t))
+#define SRCTYPE uint32_t
 #endif
 
 // Simple scalers
@@ -89,5 +84,5 @@
 #undef SCALERHEIGHT
 #undef SCALERFUNC
 
-#undef PMAKE
+#undef PCONVERT
 #undef SRCTYPE
@@ -19,6 +19,8 @@ CHECK_NARROWING();
 
 static constexpr SDL_PixelFormat SdlPixelFormat = SDL_PIXELFORMAT_XRGB8888;
 
+static constexpr int BytesPerPixel = sizeof(uint32_t);
+
 SdlRenderer::SdlRenderer(const int x, const int y,
 						 const int width, const int height,
 						 const SDL_WindowFlags sdl_window_flags,
@@ -251,6 +253,10 @@ void SdlRenderer::NotifyRenderSizeChanged(const int render_width_px,
 		LOG_ERR("SDL: Error creating input surface: %s", SDL_GetError());
 		return;
 	}
+
+	// The new texture needs a full upload
+	frame_dirty_regions.Resize(render_width_px, render_height_px);
+	upload_dirty_regions.Resize(render_width_px, render_height_px);
 }
 
 SdlRenderer::SetShaderResult SdlRenderer::SetShader(
@@ -310,6 +316,12 @@ void SdlRenderer::StartFrame(uint32_t*& pixels_out, int& pitch_out)
 	pitch_out  = curr_framebuf.surface->pitch;
 }
 
+void SdlRenderer::MarkDirtyRegions(const std::span<const DirtyRegion> regions)
+{
+	frame_dirty_regions.Clear();
+	frame_dirty_regions.Add(regions);
+}
+
 void SdlRenderer::EndFrame()
 {
 	assert(curr_framebuf.surface);
@@ -319,14 +331,33 @@ void SdlRenderer::EndFrame()
 
 	// We need to copy the buffers. We can't just swap them because the VGA
 	// emulation only writes the changed pixels to the framebuffer in each
-	// frame.
+	// frame. For the same reason, it's enough to copy the changed areas.
 
 	// TODO Couldn't get SDL_BlitSurface to work... If you
 	// can, feel free to use that here, but this works
 	// perfectly fine.
-	std::memcpy(last_framebuf.surface->pixels,
-	            curr_framebuf.surface->pixels,
-	            (curr_framebuf.surface->h * curr_framebuf.surface->pitch));
+	if (frame_dirty_regions.IsAll()) {
+		std::memcpy(last_framebuf.surface->pixels,
+		            curr_framebuf.surface->pixels,
+		            (curr_framebuf.surface->h * curr_framebuf.surface->pitch));
+	} else {
+		const auto pitch = curr_framebuf.surface->pitch;
+
+		const auto src = static_cast<const uint8_t*>(curr_framebuf.surface->pixels);
+		const auto dest = static_cast<uint8_t*>(last_framebuf.surface->pixels);
+
+		for (const auto& r : frame_dirty_regions.GetRegions()) {
+			for (auto y = r.y; y < r.y + r.height; ++y) {
+				const auto offset = y * pitch + r.x * BytesPerPixel;
+				std::memcpy(dest + offset, src + offset, r.width * BytesPerPixel);
+			}
+		}
+	}
+
+	upload_dirty_regions.Add(frame_dirty_regions);
+
+	// Assume the whole frame changes unless told otherwise next time
+	frame_dirty_regions.MarkAll();
 
 	last_framebuf_dirty = true;
 }
@@ -339,11 +370,27 @@ void SdlRenderer::PrepareFrame()
 	last_framebuf.UnlockSurface();
 
 	if (last_framebuf_dirty) {
-		SDL_UpdateTexture(texture,
-		                  nullptr, // entire texture
-		                  last_framebuf.surface->pixels,
-		                  last_framebuf.surface->pitch);
+		if (upload_dirty_regions.IsAll()) {
+			SDL_UpdateTexture(texture,
+			                  nullptr, // entire texture
+			                  last_framebuf.surface->pixels,
+			                  last_framebuf.surface->pitch);
+		} else {
+			const auto pitch  = last_framebuf.surface->pitch;
+			const auto pixels = static_cast<const uint8_t*>(
+			        last_framebuf.surface->pixels);
+
+			for (const auto& r : upload_dirty_regions.GetRegions()) {
+				const SDL_Rect rect = {r.x, r.y, r.width, r.height};
+
+				SDL_UpdateTexture(texture,
+				                  &rect,
+				                  pixels + r.y * pitch + r.x * BytesPerPixel,
+				                  pitch);
+			}
+		}
 
+		upload_dirty_regions.Clear();
 		last_framebuf_dirty = false;
 	}
 }
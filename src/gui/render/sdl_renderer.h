@@ -59,6 +59,7 @@ public:
 	ShaderDescriptor GetCurrentShaderDescriptor() override;
 
 	void StartFrame(uint32_t*& pixels_out, int& pitch_out) override;
+	void MarkDirtyRegions(std::span<const DirtyRegion> regions) override;
 	void EndFrame() override;
 
 	void PrepareFrame() override;
@@ -104,6 +105,12 @@ private:
 	// True if the last framebuffer has been updated since the last present
 	bool last_framebuf_dirty = false;
 
+	// The areas written to in the current frame
+	DirtyRegions frame_dirty_regions = {};
+
+	// The areas of the last framebuffer changed since the last upload
+	DirtyRegions upload_dirty_regions = {};
+
 	SDL_Texture* texture = {};
 
 	TextureFilterMode texture_filter_mode = TextureFilterMode::Bilinear;
@@ -754,9 +754,15 @@ DosBox::Rect GFX_GetCanvasSizeInPixels()
 	return sdl.renderer->GetCanvasSizeInPixels();
 }
 
+// Callers can change the renderer's settings (shader, image adjustments,
+// etc.) through the returned pointer, which might change the rendered output
+// even if the DOS framebuffer stays the same, so we make sure to present the
+// next frame.
 RenderBackend* GFX_GetRenderer()
 {
 	assert(sdl.renderer);
+
+	sdl.presentation.needs_present = true;
 	return sdl.renderer.get();
 }
 
@@ -857,6 +863,7 @@ static void update_viewport()
 		sdl.draw.draw_rect_px = to_sdl_rect(draw_rect_px);
 
 		sdl.renderer->NotifyViewportSizeChanged(draw_rect_px);
+		sdl.presentation.needs_present = true;
 	};
 
 	// TODO come up with a better design for the adaptive shader switching
@@ -956,6 +963,7 @@ void GFX_SetSize(const int render_width_px, const int render_height_px,
 
 	sdl.renderer->NotifyRenderSizeChanged(sdl.draw.render_width_px,
 	                                      sdl.draw.render_height_px);
+	sdl.presentation.needs_present = true;
 	update_viewport();
 	setup_presentation_mode();
 
@@ -1103,6 +1111,15 @@ bool GFX_StartUpdate(uint32_t*& pixels, int& pitch)
 	return true;
 }
 
+void GFX_MarkDirtyRegions(const std::span<const DirtyRegion> regions)
+{
+	assert(sdl.renderer);
+
+	if (sdl.draw.updating_framebuffer) {
+		sdl.renderer->MarkDirtyRegions(regions);
+	}
+}
+
 // Called at the end of each frame at the emulated DOS rate, *regardless* of
 // whether contents of the framebuffer have changed or not compared to the
 // prevoius frame.
@@ -1125,6 +1142,8 @@ void GFX_EndUpdate()
 		// don't want to upload the texture for the skipped frames.
 		//
 		sdl.renderer->EndFrame();
+
+		sdl.presentation.needs_present = true;
 	}
 
 	if (GFX_GetPresentationMode() == PresentationMode::DosRate) {
@@ -1177,8 +1196,26 @@ void GFX_Start()
 	sdl.draw.active = true;
 }
 
+static void log_presentation_stats()
+{
+	const auto& p = sdl.presentation;
+
+	const auto total = p.num_presents + p.num_skipped_presents;
+	if (total == 0) {
+		return;
+	}
+
+	LOG_DEBUG("DISPLAY: Presented %llu frames, skipped %llu unchanged frames (%.1f%%)",
+	          static_cast<unsigned long long>(p.num_presents),
+	          static_cast<unsigned long long>(p.num_skipped_presents),
+	          100.0 * static_cast<double>(p.num_skipped_presents) /
+	                  static_cast<double>(total));
+}
+
 static void gui_destroy()
 {
+	log_presentation_stats();
+
 	GFX_Stop();
 
 	if (sdl.draw.callback) {
@@ -2030,6 +2067,7 @@ static void notify_sdl_setting_updated(SectionProp& section,
 		configure_presentation_mode();
 
 		sdl.renderer->SetVsync(is_vsync_enabled());
+		sdl.presentation.needs_present = true;
 		maybe_log_presentation_and_vsync_mode();
 		GFX_ResetScreen();
 
@@ -2158,6 +2196,10 @@ int GFX_GetUserSdlEventId(DosBoxSdlEvent event)
 
 static bool handle_sdl_windowevent(const SDL_Event& event)
 {
+	// The window might need to be redrawn even if the DOS framebuffer
+	// hasn't changed (e.g., after being uncovered while paused)
+	sdl.presentation.needs_present = true;
+
 	switch (event.type) {
 	case SDL_EVENT_WINDOW_RESTORED: {
 		log_window_event("SDL: Window has been restored");
@@ -2437,9 +2479,24 @@ void GFX_MaybePresentFrame()
 
 	if (force_present || (curr_frame_time_us >= present_window_start_us)) {
 
+		// Nothing has changed since the last present, so presenting
+		// again would just run the shaders and swap the buffers to
+		// produce the exact same image. This makes static screens
+		// (e.g., idle text mode sessions) almost free.
+		if (!force_present && !sdl.presentation.needs_present) {
+			++sdl.presentation.num_skipped_presents;
+
+			// Skip until the next present slot
+			sdl.presentation.last_present_time_us = start_us;
+			return;
+		}
+
 		if (sdl.draw.active) {
 			sdl.renderer->PrepareFrame();
 			sdl.renderer->PresentFrame();
+
+			sdl.presentation.needs_present = false;
+			++sdl.presentation.num_presents;
 		}
 
 		const auto end_us = GetTicksUs();
@@ -4,6 +4,7 @@
 
 #include "memory.h"
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
 
@@ -192,22 +193,105 @@ void mem_strcpy(PhysPt dest,PhysPt src) {
 	mem_writeb_inline(dest,0);
 }
 
-void mem_memcpy(PhysPt dest,PhysPt src,Bitu size) {
-	while (size--) mem_writeb_inline(dest++,mem_readb_inline(src++));
+// The block functions below copy one page span at a time. Spans in pages
+// with a host pointer in the TLB (plain RAM) are copied with memcpy; pages
+// without one (memory-mapped I/O, video memory, the code pages of the dynamic
+// cores, and pages not mapped in the TLB yet) go through the page handlers one
+// byte at a time. As the handlers can map the page in the TLB, the page is
+// looked up again after every byte.
+static size_t get_page_span(const PhysPt address, const size_t size)
+{
+	const auto bytes_left_in_page = MEM_PAGE_SIZE - (address & (MEM_PAGE_SIZE - 1));
+	return std::min(size, static_cast<size_t>(bytes_left_in_page));
 }
 
-void MEM_BlockRead(PhysPt pt,void * data,Bitu size) {
-	auto write = reinterpret_cast<uint8_t *>(data);
-	while (size--) {
-		*write++=mem_readb_inline(pt++);
+static void update_read_breakpoints([[maybe_unused]] const PhysPt address,
+                                    [[maybe_unused]] const size_t size)
+{
+#if C_DEBUGGER && C_HEAVY_DEBUGGER
+	for (size_t i = 0; i < size; ++i) {
+		DEBUG_UpdateMemoryReadBreakpoints<uint8_t>(address + i);
 	}
+#endif
 }
 
-void MEM_BlockWrite(PhysPt pt, const void *data, size_t size)
+void mem_memcpy(PhysPt dest, PhysPt src, Bitu size)
 {
-	auto read = static_cast<const uint8_t *>(data);
-	while (size--) {
-		mem_writeb_inline(pt++,*read++);
+	while (size) {
+		auto span = std::min(get_page_span(src, size), get_page_span(dest, size));
+
+		const auto src_addr  = get_tlb_read(src);
+		const auto dest_addr = get_tlb_write(dest);
+		if (!src_addr || !dest_addr) {
+			for (size_t i = 0; i < span; ++i) {
+				mem_writeb_inline(dest++, mem_readb_inline(src++));
+			}
+			size -= span;
+			continue;
+		}
+
+		// Overlapping copies to a higher address repeat the source
+		// bytes, like copying byte by byte does, so never copy more
+		// than the distance between the two in one go
+		const auto host_src  = src_addr + src;
+		const auto host_dest = dest_addr + dest;
+		const auto distance  = reinterpret_cast<uintptr_t>(host_dest) -
+		                      reinterpret_cast<uintptr_t>(host_src);
+		if (distance > 0 && distance < span) {
+			span = distance;
+		}
+
+		update_read_breakpoints(src, span);
+		memmove(host_dest, host_src, span);
+
+		src += static_cast<PhysPt>(span);
+		dest += static_cast<PhysPt>(span);
+		size -= span;
+	}
+}
+
+void MEM_BlockRead(PhysPt pt, void* data, Bitu size)
+{
+	auto write = static_cast<uint8_t*>(data);
+	while (size) {
+		const auto span     = get_page_span(pt, size);
+		const auto tlb_addr = get_tlb_read(pt);
+		if (!tlb_addr) {
+			for (size_t i = 0; i < span; ++i) {
+				*write++ = mem_readb_inline(pt++);
+			}
+			size -= span;
+			continue;
+		}
+
+		update_read_breakpoints(pt, span);
+		memcpy(write, tlb_addr + pt, span);
+
+		write += span;
+		pt += static_cast<PhysPt>(span);
+		size -= span;
+	}
+}
+
+void MEM_BlockWrite(PhysPt pt, const void* data, size_t size)
+{
+	auto read = static_cast<const uint8_t*>(data);
+	while (size) {
+		const auto span     = get_page_span(pt, size);
+		const auto tlb_addr = get_tlb_write(pt);
+		if (!tlb_addr) {
+			for (size_t i = 0; i < span; ++i) {
+				mem_writeb_inline(pt++, *read++);
+			}
+			size -= span;
+			continue;
+		}
+
+		memcpy(tlb_addr + pt, read, span);
+
+		read += span;
+		pt += static_cast<PhysPt>(span);
+		size -= span;
 	}
 }
 
@@ -215,11 +299,59 @@ void MEM_BlockCopy(PhysPt dest,PhysPt src,Bitu size) {
 	mem_memcpy(dest,src,size);
 }
 
-void MEM_StrCopy(PhysPt pt,char * data,Bitu size) {
-	while (size--) {
-		uint8_t r=mem_readb_inline(pt++);
-		if (!r) break;
-		*data++=r;
+HostPt MEM_GetWritableHostPointer(const PhysPt pt, const size_t size)
+{
+	if (size == 0) {
+		return nullptr;
+	}
+	const auto last = pt + static_cast<PhysPt>(size - 1);
+	if (last < pt) {
+		return nullptr;
+	}
+
+	// Pages with the same TLB entry are contiguous in host memory, as
+	// adding the address to the entry gives the host pointer
+	const auto tlb_addr = get_tlb_write(pt);
+	if (!tlb_addr) {
+		return nullptr;
+	}
+	for (auto page = (pt / MEM_PAGE_SIZE) + 1; page <= last / MEM_PAGE_SIZE; ++page) {
+		if (get_tlb_write(page * MEM_PAGE_SIZE) != tlb_addr) {
+			return nullptr;
+		}
+	}
+	return tlb_addr + pt;
+}
+
+void MEM_StrCopy(PhysPt pt, char* data, Bitu size)
+{
+	while (size) {
+		const auto tlb_addr = get_tlb_read(pt);
+		if (!tlb_addr) {
+			const auto r = mem_readb_inline(pt++);
+			if (!r) {
+				break;
+			}
+			*data++ = static_cast<char>(r);
+			--size;
+			continue;
+		}
+
+		const auto span = get_page_span(pt, size);
+		const auto host_pt = tlb_addr + pt;
+
+		// Copy up to the terminating zero, if it's in the span
+		const auto end = static_cast<const uint8_t*>(memchr(host_pt, 0, span));
+		const auto num_bytes = end ? static_cast<size_t>(end - host_pt) : span;
+
+		update_read_breakpoints(pt, end ? num_bytes + 1 : num_bytes);
+		memcpy(data, host_pt, num_bytes);
+		data += num_bytes;
+		if (end) {
+			break;
+		}
+		pt += static_cast<PhysPt>(span);
+		size -= span;
 	}
 	*data=0;
 }
@@ -180,6 +180,13 @@ void MEM_BlockRead(PhysPt pt, void *data, Bitu size);
 void MEM_BlockCopy(PhysPt dest, PhysPt src, Bitu size);
 void MEM_StrCopy(PhysPt pt, char *data, Bitu size);
 
+// Returns a host pointer to a guest memory block if all of its pages are
+// plain RAM that can be written without going through the page handlers and
+// are contiguous in host memory, so the block can be written to directly.
+// Returns nullptr otherwise (e.g., for video memory, ROM, pages holding code
+// translated by the dynamic cores, or pages not mapped in the TLB yet).
+HostPt MEM_GetWritableHostPointer(PhysPt pt, size_t size);
+
 void mem_memcpy(PhysPt dest, PhysPt src, Bitu size);
 Bitu mem_strlen(PhysPt pt);
 void mem_strcpy(PhysPt dest, PhysPt src);
@@ -9,6 +9,7 @@
 #include "cpu/callback.h"
 #include "cpu/cpu.h"
 #include "hardware/pic.h"
+#include "hardware/pic_event_queue.h"
 #include "hardware/port.h"
 #include "hardware/timer.h"
 
@@ -180,18 +181,15 @@ void PIC_Controller::start_irq(uint8_t val) {
 }
 
 
-struct PICEntry {
-	double index;
-	Bitu value;
-	PIC_EventHandler pic_event;
-	PICEntry * next;
-};
+static PicEventQueue pic_queue(PIC_QUEUESIZE);
 
+// Tracks the number of serviced events per emulated millisecond, averaged
+// over the last emulated second
 static struct {
-	PICEntry entries[PIC_QUEUESIZE];
-	PICEntry * free_entry;
-	PICEntry * next_entry;
-} pic_queue;
+	uint32_t window_start_tick  = 0;
+	uint64_t window_start_count = 0;
+	double events_per_ms        = 0.0;
+} pic_event_rate = {};
 
 static void write_command(io_port_t port, io_val_t value, io_width_t)
 {
@@ -423,109 +421,50 @@ void PIC_SetIRQMask(uint32_t irq, bool masked)
 	pic->set_imr(newmask);
 }
 
-static void AddEntry(PICEntry * entry) {
-	PICEntry * find_entry=pic_queue.next_entry;
-	if (find_entry == nullptr) {
-		entry->next=nullptr;
-		pic_queue.next_entry=entry;
-	} else if (find_entry->index > entry->index) {
-		pic_queue.next_entry=entry;
-		entry->next=find_entry;
-	} else {
-		while (find_entry) {
-			if (find_entry->next) {
-				/* See if the next index comes later than this
-				 * one */
-				if (find_entry->next->index > entry->index) {
-					entry->next      = find_entry->next;
-					find_entry->next = entry;
-					break;
-				} else {
-					find_entry = find_entry->next;
-				}
-			} else {
-				entry->next      = find_entry->next;
-				find_entry->next = entry;
-				break;
-			}
-		}
-	}
-	Bits cycles=PIC_MakeCycles(pic_queue.next_entry->index-PIC_TickIndex());
-	if (cycles<CPU_Cycles) {
-		CPU_CycleLeft+=CPU_Cycles;
-		CPU_Cycles=0;
-	}
-}
 static bool InEventService = false;
 static double srv_lag = 0.0;
 
 void PIC_AddEvent(PIC_EventHandler handler, double delay, uint32_t val)
 {
-	if (!pic_queue.free_entry) {
+	const auto index = InEventService ? delay + srv_lag
+	                                  : delay + PIC_TickIndex();
+
+	if (!pic_queue.Add(handler, index, val)) {
 		LOG(LOG_PIC,LOG_ERROR)("Event queue full");
 		return;
 	}
-	PICEntry * entry=pic_queue.free_entry;
-	if(InEventService) entry->index = delay + srv_lag;
-	else entry->index = delay + PIC_TickIndex();
-
-	entry->pic_event=handler;
-	entry->value=val;
-	pic_queue.free_entry=pic_queue.free_entry->next;
-	AddEntry(entry);
+
+	Bits cycles=PIC_MakeCycles(pic_queue.Top().index-PIC_TickIndex());
+	if (cycles<CPU_Cycles) {
+		CPU_CycleLeft+=CPU_Cycles;
+		CPU_Cycles=0;
+	}
 }
 
 void PIC_RemoveSpecificEvents(PIC_EventHandler handler, uint32_t val)
 {
-	PICEntry *entry = pic_queue.next_entry;
-	PICEntry *prev_entry;
-	prev_entry = nullptr;
-	while (entry) {
-		if ((entry->pic_event == handler) && (entry->value == val)) {
-			if (prev_entry) {
-				prev_entry->next=entry->next;
-				entry->next=pic_queue.free_entry;
-				pic_queue.free_entry=entry;
-				entry=prev_entry->next;
-				continue;
-			} else {
-				pic_queue.next_entry=entry->next;
-				entry->next=pic_queue.free_entry;
-				pic_queue.free_entry=entry;
-				entry=pic_queue.next_entry;
-				continue;
-			}
-		}
-		prev_entry=entry;
-		entry=entry->next;
-	}
+	pic_queue.RemoveSpecificEvents(handler, val);
 }
 
-void PIC_RemoveEvents(PIC_EventHandler handler) {
-	PICEntry * entry=pic_queue.next_entry;
-	PICEntry * prev_entry;
-	prev_entry=nullptr;
-	while (entry) {
-		if (entry->pic_event == handler) {
-			if (prev_entry) {
-				prev_entry->next=entry->next;
-				entry->next=pic_queue.free_entry;
-				pic_queue.free_entry=entry;
-				entry=prev_entry->next;
-				continue;
-			} else {
-				pic_queue.next_entry=entry->next;
-				entry->next=pic_queue.free_entry;
-				pic_queue.free_entry=entry;
-				entry=pic_queue.next_entry;
-				continue;
-			}
-		}
-		prev_entry=entry;
-		entry=entry->next;
-	}
+void PIC_RemoveEvents(PIC_EventHandler handler)
+{
+	pic_queue.RemoveEvents(handler);
 }
 
+PIC_EventQueueStats PIC_GetEventQueueStats()
+{
+	const auto& queue_stats = pic_queue.GetStats();
+
+	PIC_EventQueueStats stats = {};
+
+	stats.events_per_ms      = pic_event_rate.events_per_ms;
+	stats.queue_depth        = pic_queue.Size();
+	stats.max_queue_depth    = queue_stats.max_depth;
+	stats.num_events_run     = queue_stats.num_run;
+	stats.num_events_dropped = queue_stats.num_dropped;
+
+	return stats;
+}
 
 bool PIC_RunQueue(void) {
 	PIC_UpdateAtomicIndex();
@@ -541,24 +480,19 @@ bool PIC_RunQueue(void) {
 
 	/* Check the queue for an entry */
 	InEventService = true;
-	while (pic_queue.next_entry &&
-	       (pic_queue.next_entry->index * static_cast<double>(CPU_CycleMax) <= index_nd_f)) {
-		PICEntry *entry = pic_queue.next_entry;
-		pic_queue.next_entry = entry->next;
-
-		srv_lag = entry->index;
-		(entry->pic_event)(entry->value); // call the event handler
+	while (!pic_queue.IsEmpty() &&
+	       (pic_queue.Top().index * static_cast<double>(CPU_CycleMax) <= index_nd_f)) {
+		const auto event = pic_queue.Pop();
 
-		/* Put the entry in the free list */
-		entry->next=pic_queue.free_entry;
-		pic_queue.free_entry=entry;
+		srv_lag = event.index;
+		(event.handler)(event.value); // call the event handler
 	}
 	InEventService = false;
 
 	/* Check when to set the new cycle end */
-	if (pic_queue.next_entry) {
+	if (!pic_queue.IsEmpty()) {
 		auto cycles = static_cast<int32_t>(
-		        pic_queue.next_entry->index * static_cast<double>(CPU_CycleMax) -
+		        pic_queue.Top().index * static_cast<double>(CPU_CycleMax) -
 		        index_nd_f);
 		if (!cycles) {
 			cycles = 1;
@@ -610,10 +544,18 @@ void TIMER_AddTick(void) {
 	CPU_Cycles=0;
 	PIC_Ticks++;
 	/* Go through the list of scheduled events and lower their index with 1000 */
-	PICEntry * entry=pic_queue.next_entry;
-	while (entry) {
-		entry->index -= 1.0f;
-		entry=entry->next;
+	pic_queue.ShiftIndices(1.0);
+
+	constexpr auto EventRateWindowMs = 1000;
+	if (PIC_Ticks - pic_event_rate.window_start_tick >= EventRateWindowMs) {
+		const auto num_run = pic_queue.GetStats().num_run;
+
+		pic_event_rate.events_per_ms =
+		        static_cast<double>(num_run - pic_event_rate.window_start_count) /
+		        static_cast<double>(PIC_Ticks - pic_event_rate.window_start_tick);
+
+		pic_event_rate.window_start_tick  = PIC_Ticks;
+		pic_event_rate.window_start_count = num_run;
 	}
 	/* Call our list of ticker handlers */
 	TickerBlock * ticker=firstticker;
@@ -678,15 +620,22 @@ public:
 		WriteHandler[2].Install(0xa0, write_command, io_width_t::byte);
 		WriteHandler[3].Install(0xa1, write_data, io_width_t::byte);
 		/* Initialize the pic queue */
-		for (i=0;i<PIC_QUEUESIZE-1;i++) {
-			pic_queue.entries[i].next=&pic_queue.entries[i+1];
-		}
-		pic_queue.entries[PIC_QUEUESIZE-1].next=nullptr;
-		pic_queue.free_entry=&pic_queue.entries[0];
-		pic_queue.next_entry=nullptr;
+		pic_queue.Clear();
+		pic_event_rate = {};
 	}
 
-	~PIC_8259A() = default;
+	~PIC_8259A()
+	{
+		const auto stats = PIC_GetEventQueueStats();
+
+		LOG_DEBUG("PIC: Serviced %llu events, %.1f events/ms recently, "
+		          "max queue depth %zu of %d, %llu events dropped",
+		          static_cast<unsigned long long>(stats.num_events_run),
+		          stats.events_per_ms,
+		          stats.max_queue_depth,
+		          PIC_QUEUESIZE,
+		          static_cast<unsigned long long>(stats.num_events_dropped));
+	}
 };
 
 static std::unique_ptr<PIC_8259A> pic = {};
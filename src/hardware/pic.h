@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText:  2025-2025 The DOSBox Staging Team
+// SPDX-FileCopyrightText:  2025-2026 The DOSBox Staging Team
 // SPDX-FileCopyrightText:  2002-2021 The DOSBox Team
 // SPDX-License-Identifier: GPL-2.0-or-later
 
@@ -78,6 +78,20 @@ void PIC_AddEvent(PIC_EventHandler handler, double delay, uint32_t val = 0);
 void PIC_RemoveEvents(PIC_EventHandler handler);
 void PIC_RemoveSpecificEvents(PIC_EventHandler handler, uint32_t val);
 
+struct PIC_EventQueueStats {
+	// Average number of events serviced per emulated millisecond over the
+	// last emulated second
+	double events_per_ms = 0.0;
+
+	size_t queue_depth     = 0;
+	size_t max_queue_depth = 0;
+
+	uint64_t num_events_run     = 0;
+	uint64_t num_events_dropped = 0;
+};
+
+PIC_EventQueueStats PIC_GetEventQueueStats();
+
 void PIC_SetIRQMask(uint32_t irq, bool masked);
 
 #endif // DOSBOX_PIC_H
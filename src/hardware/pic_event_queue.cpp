@@ -0,0 +1,229 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "pic_event_queue.h"
+
+#include <cassert>
+
+#include "utils/checks.h"
+
+CHECK_NARROWING();
+
+PicEventQueue::PicEventQueue(const size_t capacity)
+        : nodes(capacity)
+{
+	assert(capacity > 0);
+
+	free_nodes.reserve(capacity);
+	heap.reserve(capacity);
+
+	Clear();
+}
+
+void PicEventQueue::Clear()
+{
+	heap.clear();
+	handler_heads.clear();
+
+	// Hand out the lowest nodes first
+	free_nodes.clear();
+	for (auto i = nodes.size(); i > 0; --i) {
+		free_nodes.push_back(check_cast<int32_t>(i - 1));
+	}
+	for (auto& node : nodes) {
+		node = {};
+	}
+}
+
+bool PicEventQueue::IsEarlier(const int32_t a, const int32_t b) const
+{
+	const auto& node_a = nodes[a];
+	const auto& node_b = nodes[b];
+
+	if (node_a.event.index != node_b.event.index) {
+		return node_a.event.index < node_b.event.index;
+	}
+	return node_a.sequence < node_b.sequence;
+}
+
+void PicEventQueue::Place(const size_t pos, const int32_t node)
+{
+	heap[pos]            = node;
+	nodes[node].heap_pos = check_cast<int32_t>(pos);
+}
+
+void PicEventQueue::SiftUp(size_t pos)
+{
+	const auto node = heap[pos];
+
+	while (pos > 0) {
+		const auto parent = (pos - 1) / 2;
+		if (!IsEarlier(node, heap[parent])) {
+			break;
+		}
+		Place(pos, heap[parent]);
+		pos = parent;
+	}
+	Place(pos, node);
+}
+
+void PicEventQueue::SiftDown(size_t pos)
+{
+	const auto node = heap[pos];
+	const auto size = heap.size();
+
+	while (true) {
+		auto child = pos * 2 + 1;
+		if (child >= size) {
+			break;
+		}
+		if (child + 1 < size && IsEarlier(heap[child + 1], heap[child])) {
+			++child;
+		}
+		if (!IsEarlier(heap[child], node)) {
+			break;
+		}
+		Place(pos, heap[child]);
+		pos = child;
+	}
+	Place(pos, node);
+}
+
+void PicEventQueue::LinkHandler(const int32_t node)
+{
+	auto [it, inserted] = handler_heads.try_emplace(nodes[node].event.handler, None);
+
+	const auto head = it->second;
+
+	nodes[node].handler_prev = None;
+	nodes[node].handler_next = head;
+	if (head != None) {
+		nodes[head].handler_prev = node;
+	}
+	it->second = node;
+}
+
+void PicEventQueue::UnlinkHandler(const int32_t node)
+{
+	const auto prev = nodes[node].handler_prev;
+	const auto next = nodes[node].handler_next;
+
+	if (prev != None) {
+		nodes[prev].handler_next = next;
+	} else {
+		handler_heads[nodes[node].event.handler] = next;
+	}
+	if (next != None) {
+		nodes[next].handler_prev = prev;
+	}
+	nodes[node].handler_prev = None;
+	nodes[node].handler_next = None;
+}
+
+bool PicEventQueue::Add(const PIC_EventHandler handler, const double index,
+                        const uint32_t value)
+{
+	if (free_nodes.empty()) {
+		++stats.num_dropped;
+		return false;
+	}
+
+	const auto node = free_nodes.back();
+	free_nodes.pop_back();
+
+	nodes[node].event    = {index, handler, value};
+	nodes[node].sequence = next_sequence++;
+
+	LinkHandler(node);
+
+	heap.push_back(node);
+	SiftUp(heap.size() - 1);
+
+	++stats.num_added;
+	if (heap.size() > stats.max_depth) {
+		stats.max_depth = heap.size();
+	}
+	return true;
+}
+
+void PicEventQueue::Remove(const int32_t node)
+{
+	const auto pos = static_cast<size_t>(nodes[node].heap_pos);
+	assert(pos < heap.size() && heap[pos] == node);
+
+	const auto last = heap.back();
+	heap.pop_back();
+
+	if (last != node) {
+		Place(pos, last);
+
+		// The moved node can belong either above or below its new spot
+		if (pos > 0 && IsEarlier(last, heap[(pos - 1) / 2])) {
+			SiftUp(pos);
+		} else {
+			SiftDown(pos);
+		}
+	}
+
+	UnlinkHandler(node);
+
+	nodes[node].heap_pos = None;
+	free_nodes.push_back(node);
+}
+
+PicEventQueue::Event PicEventQueue::Pop()
+{
+	assert(!heap.empty());
+
+	const auto node  = heap.front();
+	const auto event = nodes[node].event;
+
+	Remove(node);
+
+	++stats.num_run;
+	return event;
+}
+
+void PicEventQueue::RemoveEvents(const PIC_EventHandler handler)
+{
+	const auto it = handler_heads.find(handler);
+	if (it == handler_heads.end()) {
+		return;
+	}
+
+	auto node = it->second;
+	while (node != None) {
+		const auto next = nodes[node].handler_next;
+		Remove(node);
+		++stats.num_removed;
+		node = next;
+	}
+}
+
+void PicEventQueue::RemoveSpecificEvents(const PIC_EventHandler handler,
+                                         const uint32_t value)
+{
+	const auto it = handler_heads.find(handler);
+	if (it == handler_heads.end()) {
+		return;
+	}
+
+	auto node = it->second;
+	while (node != None) {
+		const auto next = nodes[node].handler_next;
+		if (nodes[node].event.value == value) {
+			Remove(node);
+			++stats.num_removed;
+		}
+		node = next;
+	}
+}
+
+void PicEventQueue::ShiftIndices(const double amount)
+{
+	// Subtracting the same amount from every index keeps their relative
+	// order, so the heap stays valid
+	for (const auto node : heap) {
+		nodes[node].event.index -= amount;
+	}
+}
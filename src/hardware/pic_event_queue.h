@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef DOSBOX_PIC_EVENT_QUEUE_H
+#define DOSBOX_PIC_EVENT_QUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "hardware/pic.h"
+
+/*  PIC Event Queue
+ *  ---------------
+ *  The scheduler behind PIC_AddEvent() and friends: a fixed-capacity indexed
+ *  binary min-heap of pending events, ordered by their due index (in
+ *  milliseconds relative to the start of the current tick).
+ *
+ *  Events with the same index are serviced in the order they were added,
+ *  exactly like the sorted linked list this replaces.
+ *
+ *  Every event remembers its position in the heap and is also linked into a
+ *  per-handler list, so removing the events of a given handler only touches
+ *  those events instead of scanning the whole queue.
+ *
+ *  Insertion and removal are O(log n). The queue is only ever accessed from
+ *  the emulation thread, so there's no locking.
+ */
+
+class PicEventQueue {
+public:
+	struct Event {
+		double index             = 0.0;
+		PIC_EventHandler handler = nullptr;
+		uint32_t value           = 0;
+	};
+
+	struct Stats {
+		uint64_t num_added   = 0;
+		uint64_t num_run     = 0;
+		uint64_t num_removed = 0;
+		uint64_t num_dropped = 0; // because the queue was full
+
+		size_t max_depth = 0;
+	};
+
+	explicit PicEventQueue(size_t capacity);
+
+	PicEventQueue()                                = delete;
+	PicEventQueue(const PicEventQueue&)            = delete;
+	PicEventQueue& operator=(const PicEventQueue&) = delete;
+
+	// Returns false if the queue is full
+	bool Add(PIC_EventHandler handler, double index, uint32_t value);
+
+	bool IsEmpty() const
+	{
+		return heap.empty();
+	}
+
+	size_t Size() const
+	{
+		return heap.size();
+	}
+
+	// The earliest event; the queue must not be empty
+	const Event& Top() const
+	{
+		return nodes[heap.front()].event;
+	}
+
+	// Removes and returns the earliest event; the queue must not be empty
+	Event Pop();
+
+	void RemoveEvents(PIC_EventHandler handler);
+	void RemoveSpecificEvents(PIC_EventHandler handler, uint32_t value);
+
+	// Moves all pending events closer by `amount` milliseconds; called at
+	// the start of every tick
+	void ShiftIndices(double amount);
+
+	void Clear();
+
+	const Stats& GetStats() const
+	{
+		return stats;
+	}
+
+private:
+	static constexpr int32_t None = -1;
+
+	struct Node {
+		Event event = {};
+
+		// Tie-breaker to keep events with the same index in FIFO order
+		uint64_t sequence = 0;
+
+		int32_t heap_pos = None;
+
+		// Doubly-linked list of the events of the same handler
+		int32_t handler_prev = None;
+		int32_t handler_next = None;
+	};
+
+	bool IsEarlier(int32_t a, int32_t b) const;
+
+	void SiftUp(size_t pos);
+	void SiftDown(size_t pos);
+	void Place(size_t pos, int32_t node);
+
+	void LinkHandler(int32_t node);
+	void UnlinkHandler(int32_t node);
+
+	void Remove(int32_t node);
+
+	std::vector<Node> nodes         = {};
+	std::vector<int32_t> free_nodes = {};
+	std::vector<int32_t> heap       = {};
+
+	std::unordered_map<PIC_EventHandler, int32_t> handler_heads = {};
+
+	uint64_t next_sequence = 0;
+
+	Stats stats = {};
+};
+
+#endif // DOSBOX_PIC_EVENT_QUEUE_H
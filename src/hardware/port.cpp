@@ -1,9 +1,11 @@
-// SPDX-FileCopyrightText:  2020-2025 The DOSBox Staging Team
+// SPDX-FileCopyrightText:  2020-2026 The DOSBox Staging Team
 // SPDX-FileCopyrightText:  2002-2021 The DOSBox Team
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "port.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstring>
 #include <limits>
@@ -14,6 +16,7 @@
 #include "cpu/callback.h"
 #include "cpu/cpu.h"
 #include "cpu/lazyflags.h"
+#include "hardware/pic.h"
 
 //#define ENABLE_PORTLOG
 
@@ -28,6 +31,38 @@ uint32_t read_dword_from_port(const io_port_t port);
 void write_byte_to_port(const io_port_t port, const uint8_t val);
 void write_word_to_port(const io_port_t port, const uint16_t val);
 void write_dword_to_port(const io_port_t port, const uint32_t val);
+void clear_fast_port_slots();
+
+static std::array<uint64_t, UINT16_MAX + 1> port_read_hits  = {};
+static std::array<uint64_t, UINT16_MAX + 1> port_write_hits = {};
+
+std::vector<IO_PortHits> IO_GetPortHits(const size_t max_ports)
+{
+	std::vector<IO_PortHits> hits = {};
+	for (size_t port = 0; port < port_read_hits.size(); ++port) {
+		if (port_read_hits[port] || port_write_hits[port]) {
+			hits.push_back({static_cast<io_port_t>(port),
+			                port_read_hits[port],
+			                port_write_hits[port]});
+		}
+	}
+
+	const auto num_ports = std::min(max_ports, hits.size());
+	std::partial_sort(hits.begin(),
+	                  hits.begin() + static_cast<ptrdiff_t>(num_ports),
+	                  hits.end(),
+	                  [](const IO_PortHits& a, const IO_PortHits& b) {
+		                  return a.reads + a.writes > b.reads + b.writes;
+	                  });
+	hits.resize(num_ports);
+	return hits;
+}
+
+void IO_ResetPortHits()
+{
+	port_read_hits.fill(0);
+	port_write_hits.fill(0);
+}
 
 
 struct IOF_Entry {
@@ -87,6 +122,93 @@ inline void IO_USEC_write_delay() {
 	CPU_IODelayRemoved += delaycyc;
 }
 
+// Polling loop skipping
+// ~~~~~~~~~~~~~~~~~~~~~
+// Programs often busy-wait on a status port, e.g., 'in al,dx; test al,8;
+// jz' on the VGA status register, burning through their whole cycle budget
+// just to observe a bit flipping at a known time. If the same port keeps
+// returning the same value a few cycles apart with no other IO in between,
+// and its read handler has reported how long that value stays the same, we
+// consume those cycles in one go, like HLT does.
+//
+// The jump never reaches past the end of the current slice, which ends at
+// the next PIC event, and never past the point where the polled value could
+// change, so the guest sees every transition at the same emulated time.
+//
+constexpr int MinPollingLoopRepeats = 4;
+
+// Cycles between two reads on top of the IO read delay
+constexpr int32_t MaxPollingLoopGap = 100;
+
+static struct {
+	io_port_t port     = 0;
+	uint8_t value      = 0;
+	int num_repeats    = 0;
+	uint32_t last_tick = 0;
+	int32_t last_index = 0;
+
+	// Reported by the read handler during the current read
+	double stable_for_ms = 0.0;
+
+	uint64_t num_skips     = 0;
+	int64_t cycles_skipped = 0;
+} polling_loop = {};
+
+void IO_ReportReadStableFor(const double milliseconds)
+{
+	polling_loop.stable_for_ms = milliseconds;
+}
+
+static void reset_polling_loop_detection()
+{
+	polling_loop.num_repeats = 0;
+}
+
+static void maybe_skip_polling_loop(const io_port_t port, const uint8_t value)
+{
+	auto& loop = polling_loop;
+
+	const auto stable_for_ms = loop.stable_for_ms;
+	loop.stable_for_ms       = 0.0;
+
+	const auto index = PIC_TickIndexND();
+
+	const auto max_gap = MaxPollingLoopGap + CPU_CycleMax / IODELAY_READ_MICROSk;
+
+	const auto is_repeat = port == loop.port && value == loop.value &&
+	                       PIC_Ticks == loop.last_tick &&
+	                       index - loop.last_index <= max_gap;
+
+	loop.port       = port;
+	loop.value      = value;
+	loop.last_tick  = PIC_Ticks;
+	loop.last_index = index;
+
+	if (!is_repeat) {
+		loop.num_repeats = 0;
+		return;
+	}
+	if (++loop.num_repeats < MinPollingLoopRepeats || stable_for_ms <= 0.0) {
+		return;
+	}
+
+	// The slice ends at the next PIC event
+	const auto slice_ms = static_cast<double>(CPU_Cycles) /
+	                      static_cast<double>(CPU_CycleMax);
+
+	const auto skip = PIC_MakeCycles(std::min(stable_for_ms, slice_ms));
+	if (skip <= 0) {
+		return;
+	}
+	CPU_Cycles -= skip;
+	CPU_IODelayRemoved += skip;
+
+	loop.last_index = PIC_TickIndexND();
+
+	++loop.num_skips;
+	loop.cycles_skipped += skip;
+}
+
 #ifdef ENABLE_PORTLOG
 static uint8_t crtc_index = 0;
 
@@ -151,6 +273,8 @@ void log_io(io_width_t width, bool write, io_port_t port, io_val_t val)
 
 void IO_WriteB(io_port_t port, uint8_t val)
 {
+	++port_write_hits[port];
+	reset_polling_loop_detection();
 	log_io(io_width_t::byte, true, port, val);
 	if (GETFLAG(VM) && (CPU_IO_Exception(port, 1))) {
 		const auto old_lflags = lflags;
@@ -185,6 +309,8 @@ void IO_WriteB(io_port_t port, uint8_t val)
 
 void IO_WriteW(io_port_t port, uint16_t val)
 {
+	++port_write_hits[port];
+	reset_polling_loop_detection();
 	log_io(io_width_t::word, true, port, val);
 	if (GETFLAG(VM) && (CPU_IO_Exception(port, 2))) {
 		const auto old_lflags = lflags;
@@ -219,6 +345,8 @@ void IO_WriteW(io_port_t port, uint16_t val)
 
 void IO_WriteD(io_port_t port, uint32_t val)
 {
+	++port_write_hits[port];
+	reset_polling_loop_detection();
 	log_io(io_width_t::dword, true, port, val);
 	if (GETFLAG(VM) && (CPU_IO_Exception(port, 4))) {
 		const auto old_lflags = lflags;
@@ -252,6 +380,7 @@ void IO_WriteD(io_port_t port, uint32_t val)
 
 uint8_t IO_ReadB(io_port_t port)
 {
+	++port_read_hits[port];
 	uint8_t retval;
 	if (GETFLAG(VM) && (CPU_IO_Exception(port, 1))) {
 		const auto old_lflags = lflags;
@@ -282,6 +411,10 @@ uint8_t IO_ReadB(io_port_t port)
 	} else {
 		IO_USEC_read_delay();
 		retval = read_byte_from_port(port);
+
+		if (CPU_ShouldSkipPollingLoops()) {
+			maybe_skip_polling_loop(port, retval);
+		}
 	}
 	log_io(io_width_t::byte, false, port, retval);
 	return retval;
@@ -289,6 +422,8 @@ uint8_t IO_ReadB(io_port_t port)
 
 uint16_t IO_ReadW(io_port_t port)
 {
+	++port_read_hits[port];
+	reset_polling_loop_detection();
 	uint16_t retval;
 	if (GETFLAG(VM) && (CPU_IO_Exception(port, 2))) {
 		const auto old_lflags = lflags;
@@ -325,6 +460,8 @@ uint16_t IO_ReadW(io_port_t port)
 
 uint32_t IO_ReadD(io_port_t port)
 {
+	++port_read_hits[port];
+	reset_polling_loop_detection();
 	uint32_t retval;
 	if (GETFLAG(VM) && (CPU_IO_Exception(port, 4))) {
 		const auto old_lflags = lflags;
@@ -361,6 +498,8 @@ uint32_t IO_ReadD(io_port_t port)
 
 class IO {
 public:
+	static constexpr size_t MaxLoggedPorts = 8;
+
 	IO()
 	{
 		iof_queue.used = 0;
@@ -386,6 +525,22 @@ public:
 		}
 		LOG_DEBUG("IOBUS: Handlers consumed %d total bytes",
 		          static_cast<int>(total_bytes));
+		clear_fast_port_slots();
+
+		for (const auto& hits : IO_GetPortHits(MaxLoggedPorts)) {
+			LOG_DEBUG("IOBUS: Port %04Xh: %llu reads, %llu writes",
+			          hits.port,
+			          static_cast<unsigned long long>(hits.reads),
+			          static_cast<unsigned long long>(hits.writes));
+		}
+		IO_ResetPortHits();
+
+		if (polling_loop.num_skips > 0) {
+			LOG_DEBUG("IOBUS: Skipped %llu polling loop iterations, saving %lld cycles",
+			          static_cast<unsigned long long>(polling_loop.num_skips),
+			          static_cast<long long>(polling_loop.cycles_skipped));
+		}
+		polling_loop = {};
 	}
 };
 
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText:  2020-2025 The DOSBox Staging Team
+// SPDX-FileCopyrightText:  2020-2026 The DOSBox Staging Team
 // SPDX-FileCopyrightText:  2002-2021 The DOSBox Team
 // SPDX-License-Identifier: GPL-2.0-or-later
 
@@ -8,6 +8,7 @@
 #include "dosbox.h"
 
 #include <functional>
+#include <vector>
 
 using io_port_t = uint16_t; // DOS only supports 16-bit port addresses
 using io_val_t  = uint32_t; // Handling exists up to a dword (or less)
@@ -58,6 +59,25 @@ void IO_FreeWriteHandler(io_port_t port,
                          io_width_t max_width,
                          io_port_t range = 1);
 
+// Per-port access counters for profiling which ports a program hammers
+// (e.g., VGA retrace polling or Sound Blaster status reads)
+struct IO_PortHits {
+	io_port_t port  = 0;
+	uint64_t reads  = 0;
+	uint64_t writes = 0;
+};
+
+// Returns up to 'max_ports' of the most accessed ports, busiest first
+std::vector<IO_PortHits> IO_GetPortHits(size_t max_ports);
+
+void IO_ResetPortHits();
+
+// Read handlers of status ports can report how many milliseconds the value
+// they're returning is guaranteed to stay the same. Tight loops polling the
+// port are then fast-forwarded up to that point when 'cpu_skip_polling' is
+// enabled (see CPU_ShouldSkipPollingLoops()).
+void IO_ReportReadStableFor(double milliseconds);
+
 /* Classes to manage the IO objects created by the various devices.
  * The io objects will remove itself on destruction.*/
 class IO_Base{
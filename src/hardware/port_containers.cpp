@@ -1,12 +1,14 @@
-// SPDX-FileCopyrightText:  2020-2025 The DOSBox Staging Team
+// SPDX-FileCopyrightText:  2020-2026 The DOSBox Staging Team
 // SPDX-FileCopyrightText:  2002-2021 The DOSBox Team
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "port.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <functional>
+#include <iterator>
 #include <limits>
 #include <unordered_map>
 
@@ -52,17 +54,154 @@ constexpr io_val_t blocked_read(const io_port_t, const io_width_t)
 	return 0xff;
 }
 
+// Flat dispatch tables for the ports below FastPortRange, which covers the
+// ISA range where the devices games hammer live (VGA status, Sound Blaster,
+// PIT, PIC, keyboard controller). The maps above remain the source of truth;
+// each slot caches a plain function pointer and its context so the hot
+// accesses skip both the hash lookup and the std::function type erasure.
+//
+// Handlers registered as plain functions are called through a small thunk
+// that gets the function pointer as its context; everything else (lambdas,
+// bound member functions) goes through the std::function itself.
+constexpr io_port_t FastPortRange = 0x400;
+
+using io_read_thunk_t  = io_val_t (*)(const void* context, io_port_t, io_width_t);
+using io_write_thunk_t = void (*)(const void* context, io_port_t, io_val_t, io_width_t);
+
+struct IoReadSlot {
+	io_read_thunk_t thunk = nullptr;
+	const void* context   = nullptr;
+};
+
+struct IoWriteSlot {
+	io_write_thunk_t thunk = nullptr;
+	const void* context    = nullptr;
+};
+
+static IoReadSlot fast_read_slots[io_widths][FastPortRange]   = {};
+static IoWriteSlot fast_write_slots[io_widths][FastPortRange] = {};
+
+template <typename Function>
+static io_val_t call_read_handler(const void* context, const io_port_t port,
+                                  const io_width_t width)
+{
+	return (*static_cast<const Function*>(context))(port, width);
+}
+
+template <typename Function, typename Value>
+static void call_write_handler(const void* context, const io_port_t port,
+                               const io_val_t val, const io_width_t width)
+{
+	// Narrowing is intended, the value fits the width of the access
+	(*static_cast<const Function*>(context))(port, static_cast<Value>(val), width);
+}
+
+template <typename Result>
+static bool try_bind_read_function(IoReadSlot& slot, const io_read_f& handler)
+{
+	using function_t = Result (*)(io_port_t, io_width_t);
+
+	if (const auto function = handler.target<function_t>(); function) {
+		slot = {call_read_handler<function_t>, function};
+		return true;
+	}
+	return false;
+}
+
+template <typename Value>
+static bool try_bind_write_function(IoWriteSlot& slot, const io_write_f& handler)
+{
+	using function_t = void (*)(io_port_t, Value, io_width_t);
+
+	if (const auto function = handler.target<function_t>(); function) {
+		slot = {call_write_handler<function_t, Value>, function};
+		return true;
+	}
+	return false;
+}
+
+static void update_fast_read_slot(const int width_index, const io_port_t port)
+{
+	if (port >= FastPortRange) {
+		return;
+	}
+	auto& slot = fast_read_slots[width_index][port];
+
+	const auto& handlers = io_read_handlers[width_index];
+	const auto it        = handlers.find(port);
+	if (it == handlers.end()) {
+		slot = {};
+		return;
+	}
+	const auto& handler = it->second;
+
+	if (try_bind_read_function<uint8_t>(slot, handler) ||
+	    try_bind_read_function<uint16_t>(slot, handler) ||
+	    try_bind_read_function<uint32_t>(slot, handler)) {
+		return;
+	}
+	slot = {call_read_handler<io_read_f>, &handler};
+}
+
+static void update_fast_write_slot(const int width_index, const io_port_t port)
+{
+	if (port >= FastPortRange) {
+		return;
+	}
+	auto& slot = fast_write_slots[width_index][port];
+
+	const auto& handlers = io_write_handlers[width_index];
+	const auto it        = handlers.find(port);
+	if (it == handlers.end()) {
+		slot = {};
+		return;
+	}
+	const auto& handler = it->second;
+
+	if (try_bind_write_function<io_val_t>(slot, handler) ||
+	    try_bind_write_function<uint8_t>(slot, handler) ||
+	    try_bind_write_function<uint16_t>(slot, handler)) {
+		return;
+	}
+	slot = {call_write_handler<io_write_f, io_val_t>, &handler};
+}
+
+void clear_fast_port_slots()
+{
+	for (auto& slots : fast_read_slots) {
+		std::fill(std::begin(slots), std::end(slots), IoReadSlot{});
+	}
+	for (auto& slots : fast_write_slots) {
+		std::fill(std::begin(slots), std::end(slots), IoWriteSlot{});
+	}
+}
+
 // type-sized IO handler API
 uint8_t read_byte_from_port(const io_port_t port)
 {
+	if (port < FastPortRange) {
+		const auto& slot = fast_read_slots[0][port];
+		if (slot.thunk) {
+			return slot.thunk(slot.context, port, io_width_t::byte) & 0xff;
+		}
+	}
 	const auto [it, was_blocked] = io_read_byte_handler.try_emplace(port, blocked_read);
-	if (was_blocked)
+	if (was_blocked) {
 		LOG(LOG_IO, LOG_WARN)("Unhandled read from port %04Xh; blocking", port);
+		update_fast_read_slot(0, port);
+	}
 	return it->second(port, io_width_t::byte) & 0xff;
 }
 
 uint16_t read_word_from_port(const io_port_t port)
 {
+	if (port < FastPortRange) {
+		const auto& slot = fast_read_slots[1][port];
+		if (slot.thunk) {
+			return static_cast<uint16_t>(
+			        slot.thunk(slot.context, port, io_width_t::word) & 0xffff);
+		}
+	}
 	const auto reader = io_read_word_handler.find(port);
 	const auto value = reader != io_read_word_handler.end()
 	                           ? (reader->second(port, io_width_t::word) & 0xffff)
@@ -74,6 +213,12 @@ uint16_t read_word_from_port(const io_port_t port)
 
 uint32_t read_dword_from_port(const io_port_t port)
 {
+	if (port < FastPortRange) {
+		const auto& slot = fast_read_slots[2][port];
+		if (slot.thunk) {
+			return slot.thunk(slot.context, port, io_width_t::dword);
+		}
+	}
 	const auto reader = io_read_dword_handler.find(port);
 	const auto value = reader != io_read_dword_handler.end()
 	                           ? reader->second(port, io_width_t::dword)
@@ -91,16 +236,32 @@ constexpr void blocked_write(const io_port_t, const io_val_t, const io_width_t)
 
 void write_byte_to_port(const io_port_t port, const uint8_t val)
 {
+	if (port < FastPortRange) {
+		const auto& slot = fast_write_slots[0][port];
+		if (slot.thunk) {
+			slot.thunk(slot.context, port, val, io_width_t::byte);
+			return;
+		}
+	}
 	const auto [it, was_blocked] = io_write_byte_handler.try_emplace(port, blocked_write);
-	if (was_blocked)
+	if (was_blocked) {
 		LOG(LOG_IO, LOG_WARN)("Unhandled write of value 0x%02x"
 		                      " (%u) to port %04Xh; blocking",
 		                      val, val, port);
+		update_fast_write_slot(0, port);
+	}
 	it->second(port, val, io_width_t::byte);
 }
 
 void write_word_to_port(const io_port_t port, const uint16_t val)
 {
+	if (port < FastPortRange) {
+		const auto& slot = fast_write_slots[1][port];
+		if (slot.thunk) {
+			slot.thunk(slot.context, port, val, io_width_t::word);
+			return;
+		}
+	}
 	const auto writer = io_write_word_handler.find(port);
 	if (writer != io_write_word_handler.end()) {
 		writer->second(port, val, io_width_t::word);
@@ -112,6 +273,13 @@ void write_word_to_port(const io_port_t port, const uint16_t val)
 
 void write_dword_to_port(const io_port_t port, const uint32_t val)
 {
+	if (port < FastPortRange) {
+		const auto& slot = fast_write_slots[2][port];
+		if (slot.thunk) {
+			slot.thunk(slot.context, port, val, io_width_t::dword);
+			return;
+		}
+	}
 	const auto writer = io_write_dword_handler.find(port);
 	if (writer != io_write_dword_handler.end()) {
 		writer->second(port, val, io_width_t::dword);
@@ -128,10 +296,15 @@ void IO_RegisterReadHandler(io_port_t port,
 {
 	while (range--) {
 		io_read_byte_handler[port] = handler;
-		if (max_width == io_width_t::word || max_width == io_width_t::dword)
+		update_fast_read_slot(0, port);
+		if (max_width == io_width_t::word || max_width == io_width_t::dword) {
 			io_read_word_handler[port] = handler;
-		if (max_width == io_width_t::dword)
+			update_fast_read_slot(1, port);
+		}
+		if (max_width == io_width_t::dword) {
 			io_read_dword_handler[port] = handler;
+			update_fast_read_slot(2, port);
+		}
 		++port;
 	}
 }
@@ -143,10 +316,15 @@ void IO_RegisterWriteHandler(io_port_t port,
 {
 	while (range--) {
 		io_write_byte_handler[port] = handler;
-		if (max_width == io_width_t::word || max_width == io_width_t::dword)
+		update_fast_write_slot(0, port);
+		if (max_width == io_width_t::word || max_width == io_width_t::dword) {
 			io_write_word_handler[port] = handler;
-		if (max_width == io_width_t::dword)
+			update_fast_write_slot(1, port);
+		}
+		if (max_width == io_width_t::dword) {
 			io_write_dword_handler[port] = handler;
+			update_fast_write_slot(2, port);
+		}
 		++port;
 	}
 }
@@ -157,10 +335,15 @@ void IO_FreeReadHandler(io_port_t port,
 {
 	while (range--) {
 		io_read_byte_handler.erase(port);
-		if (max_width == io_width_t::word || max_width == io_width_t::dword)
+		update_fast_read_slot(0, port);
+		if (max_width == io_width_t::word || max_width == io_width_t::dword) {
 			io_read_word_handler.erase(port);
-		if (max_width == io_width_t::dword)
+			update_fast_read_slot(1, port);
+		}
+		if (max_width == io_width_t::dword) {
 			io_read_dword_handler.erase(port);
+			update_fast_read_slot(2, port);
+		}
 		++port;
 	}
 }
@@ -171,10 +354,15 @@ void IO_FreeWriteHandler(io_port_t port,
 {
 	while (range--) {
 		io_write_byte_handler.erase(port);
-		if (width == io_width_t::word || width == io_width_t::dword)
+		update_fast_write_slot(0, port);
+		if (width == io_width_t::word || width == io_width_t::dword) {
 			io_write_word_handler.erase(port);
-		if (width == io_width_t::dword)
+			update_fast_write_slot(1, port);
+		}
+		if (width == io_width_t::dword) {
 			io_write_dword_handler.erase(port);
+			update_fast_write_slot(2, port);
+		}
 		++port;
 	}
 }
@@ -1,13 +1,16 @@
-// SPDX-FileCopyrightText:  2020-2025 The DOSBox Staging Team
+// SPDX-FileCopyrightText:  2020-2026 The DOSBox Staging Team
 // SPDX-FileCopyrightText:  2002-2021 The DOSBox Team
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "dosbox.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include "vga.h"
 
+#include "cpu/cpu.h"
 #include "hardware/pic.h"
 #include "hardware/port.h"
 
@@ -16,6 +19,38 @@ uint8_t vga_read_p3d4(io_port_t port, io_width_t);
 void vga_write_p3d5(io_port_t port, io_val_t value, io_width_t);
 uint8_t vga_read_p3d5(io_port_t port, io_width_t);
 
+// Returns how long the status register keeps its value from the given point
+// in the frame, i.e., the time until the next retrace or blanking edge
+static double get_p3da_stable_for(const double time_in_frame)
+{
+	const auto& delay = vga.draw.delay;
+	if (delay.htotal <= 0.0) {
+		return 0.0;
+	}
+
+	// Without further edges the value holds until the next frame starts,
+	// which is a PIC event
+	auto stable_for = std::numeric_limits<double>::max();
+
+	auto limit_to_edge = [&](const double edge) {
+		if (time_in_frame <= edge) {
+			stable_for = std::min(stable_for, edge - time_in_frame);
+		}
+	};
+
+	limit_to_edge(delay.vrstart);
+	limit_to_edge(delay.vrend);
+	limit_to_edge(delay.vdend);
+
+	if (time_in_frame < delay.vdend) {
+		const auto line_start = time_in_frame - fmod(time_in_frame, delay.htotal);
+		limit_to_edge(line_start + delay.hblkstart);
+		limit_to_edge(line_start + delay.hblkend);
+		limit_to_edge(line_start + delay.htotal);
+	}
+	return stable_for;
+}
+
 uint8_t vga_read_p3da(io_port_t, io_width_t)
 {
 	uint8_t retval = 4; // bit 2 set, needed by Blues Brothers
@@ -40,6 +75,10 @@ uint8_t vga_read_p3da(io_port_t, io_width_t)
 			retval |= 1;
 		}
 	}
+
+	if (CPU_ShouldSkipPollingLoops()) {
+		IO_ReportReadStableFor(get_p3da_stable_for(timeInFrame));
+	}
 	return retval;
 }
 
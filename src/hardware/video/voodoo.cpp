@@ -66,6 +66,7 @@
 #include <condition_variable>
 #include <cstdlib>
 #include <cstring>
+#include <map>
 #include <mutex>
 
 #include <SDL3/SDL.h>
@@ -260,10 +261,10 @@ enum VoodooModel
 #ifdef C_ENABLE_VOODOO_OPENGL
 /* maximum number of rasterizers */
 #define MAX_RASTERIZERS			1024
+#endif
 
 /* size of the rasterizer hash table */
 #define RASTER_HASH_SIZE		97
-#endif
 
 /* flags for LFB writes */
 #define LFB_RGB_PRESENT			1
@@ -874,6 +875,175 @@ struct raster_info
 };
 #endif
 
+// The normalised ("effective") register state that determines which code
+// paths of the pixel pipeline a triangle goes through. The texture modes of
+// unused TMUs are set to 0xffffffff.
+struct raster_config {
+	uint32_t eff_color_path = 0; /* effective fbzColorPath value */
+	uint32_t eff_alpha_mode = 0; /* effective alphaMode value */
+	uint32_t eff_fog_mode   = 0; /* effective fogMode value */
+	uint32_t eff_fbz_mode   = 0; /* effective fbzMode value */
+	uint32_t eff_tex_mode_0 = 0; /* effective textureMode value for TMU #0 */
+	uint32_t eff_tex_mode_1 = 0; /* effective textureMode value for TMU #1 */
+
+	constexpr uint32_t tmus() const
+	{
+		return (eff_tex_mode_1 != 0xffffffff) ? 2
+		     : (eff_tex_mode_0 != 0xffffffff) ? 1
+		                                      : 0;
+	}
+
+	constexpr auto operator<=>(const raster_config&) const = default;
+};
+
+struct voodoo_state;
+struct triangle_job;
+
+typedef void (*raster_func)(const voodoo_state* vs, const triangle_job& tri,
+                            int32_t y, const poly_extent* extent,
+                            stats_block& stats);
+
+// The iterated start values and gradients of a triangle. They're captured at
+// setup time because the guest is free to rewrite the parameter registers
+// while a deferred triangle is still waiting to be drawn.
+struct triangle_params {
+	int16_t ax = 0; /* vertex A x,y (12.4) */
+	int16_t ay = 0;
+
+	int32_t startr = 0; /* starting R,G,B,A (12.12) */
+	int32_t startg = 0;
+	int32_t startb = 0;
+	int32_t starta = 0;
+	int32_t startz = 0; /* starting Z (20.12) */
+	int64_t startw = 0; /* starting W (16.32) */
+
+	int32_t drdx = 0; /* delta R,G,B,A,Z,W per X */
+	int32_t dgdx = 0;
+	int32_t dbdx = 0;
+	int32_t dadx = 0;
+	int32_t dzdx = 0;
+	int64_t dwdx = 0;
+
+	int32_t drdy = 0; /* delta R,G,B,A,Z,W per Y */
+	int32_t dgdy = 0;
+	int32_t dbdy = 0;
+	int32_t dady = 0;
+	int32_t dzdy = 0;
+	int64_t dwdy = 0;
+
+	struct {
+		int64_t starts = 0; /* starting S,T,W */
+		int64_t startt = 0;
+		int64_t startw = 0;
+		int64_t dsdx   = 0; /* delta S,T,W per X */
+		int64_t dtdx   = 0;
+		int64_t dwdx   = 0;
+		int64_t dsdy   = 0; /* delta S,T,W per Y */
+		int64_t dtdy   = 0;
+		int64_t dwdy   = 0;
+
+		int32_t lodbase = 0; /* LOD base from prepare_tmu() */
+	} tmu[MAX_TMU] = {};
+};
+
+// The FBI registers the rasterizers read, from fbzColorPath to color1. Like
+// the triangle parameters, they're captured per triangle, so the guest can
+// change the rendering state while earlier triangles are still queued up.
+struct render_regs {
+	static constexpr int first_reg = 0x104 / 4; /* fbzColorPath */
+	static constexpr int last_reg  = 0x148 / 4; /* color1 */
+
+	voodoo_reg regs[last_reg - first_reg + 1] = {};
+
+	voodoo_reg& operator[](const int regnum)
+	{
+		assert(regnum >= first_reg && regnum <= last_reg);
+		return regs[regnum - first_reg];
+	}
+	const voodoo_reg& operator[](const int regnum) const
+	{
+		assert(regnum >= first_reg && regnum <= last_reg);
+		return regs[regnum - first_reg];
+	}
+};
+
+// The rendering state captured per triangle. The members are named like
+// their voodoo_state counterparts so the pixel pipeline macros can read
+// either of them.
+struct render_state {
+	render_regs reg = {};
+
+	struct {
+		uint8_t fogblend[64]  = {}; /* 64-entry fog table */
+		uint8_t fogdelta[64]  = {}; /* 64-entry fog table */
+		uint8_t fogdelta_mask = 0;  /* mask for delta */
+	} fbi = {};
+};
+
+// The texture state of a TMU captured per triangle, derived from its texture
+// registers by recompute_texture_params(). The texel lookup tables and the
+// texture memory itself aren't copied; writes to them wait for the queued
+// triangles to be drawn.
+struct texture_state {
+	uint8_t* ram  = nullptr; /* pointer to aligned RAM */
+	uint32_t mask = 0;       /* mask to apply to pointers */
+
+	int32_t lodmin        = 0;  /* min, max LOD values */
+	int32_t lodmax        = 0;
+	int32_t lodbias       = 0;  /* LOD bias */
+	uint32_t lodmask      = 0;  /* mask of available LODs */
+	uint32_t lodoffset[9] = {}; /* offset of texture base for each LOD */
+	int32_t detailmax     = 0;  /* detail clamp */
+	int32_t detailbias    = 0;  /* detail bias */
+	uint8_t detailscale   = 0;  /* detail scale */
+
+	uint32_t wmask = 0; /* mask for the current texture width */
+	uint32_t hmask = 0; /* mask for the current texture height */
+
+	uint8_t bilinear_mask = 0; /* mask for bilinear resolution */
+
+	const rgb_t* lookup = nullptr; /* currently selected lookup */
+};
+
+// Everything the workers need to draw a single triangle
+struct triangle_job {
+	poly_vertex v1 = {};
+	poly_vertex v2 = {};
+	poly_vertex v3 = {};
+
+	int32_t v1y = 0;
+	int32_t v3y = 0;
+
+	uint16_t* drawbuf = {};
+
+	// Rasterizer and texture modes selected for the triangle
+	raster_func rasterizer = {};
+	uint32_t tmus          = 0;
+	uint32_t texmode0      = 0;
+	uint32_t texmode1      = 0;
+
+	triangle_params params = {};
+
+	render_state state              = {};
+	texture_state textures[MAX_TMU] = {};
+
+	// Data sent to the frame buffer instead of the TMU #0 texels
+	bool send_config    = false;
+	uint32_t tmu_config = 0;
+};
+
+// Per-configuration triangle counts to find out which configurations would
+// benefit from a specialised rasterizer
+struct raster_stats {
+	std::map<raster_config, uint32_t> polys = {};
+
+	// Consecutive triangles mostly share the same configuration, so we
+	// remember the last lookup
+	raster_config last_config = {};
+	raster_func last_callback = {};
+	uint32_t* last_polys      = {};
+};
+
 constexpr auto VoodooDefaultRefreshRateHz = 60.0;
 
 struct draw_state {
@@ -907,15 +1077,29 @@ struct triangle_worker
 
 	std::atomic_bool threads_active = {};
 
-	uint16_t* drawbuf = {};
+	// The triangle being drawn in immediate mode
+	triangle_job job = {};
+	int32_t totalpix = 0;
 
-	poly_vertex v1 = {};
-	poly_vertex v2 = {};
-	poly_vertex v3 = {};
+	// In deferred mode, the emulation thread queues up triangles and hands
+	// them over to the worker threads in batches instead of waiting for
+	// each triangle to be drawn. See triangle_worker_sync().
+	bool deferred        = false;
+	bool batch_in_flight = false;
 
-	int32_t v1y      = 0;
-	int32_t v3y      = 0;
-	int32_t totalpix = 0;
+	std::vector<triangle_job> queued = {};
+	std::vector<triangle_job> batch  = {};
+
+	// Deferred mode statistics, logged on shutdown
+	struct {
+		uint64_t triangles = 0;
+		uint64_t batches   = 0;
+		uint64_t syncs     = 0;
+
+		// Rendering state changes made while triangles drawn with the
+		// previous state were still queued up or being drawn
+		uint64_t state_changes = 0;
+	} deferred_stats = {};
 
 	std::vector<std::thread> threads = {};
 
@@ -959,6 +1143,8 @@ struct voodoo_state
 	                                                    rasterizers */
 #endif
 
+	raster_stats rstats = {};
+
 	bool send_config   = {};
 	bool clock_enabled = {};
 	bool output_on     = {};
@@ -1174,7 +1360,6 @@ inline int64_t float_to_int64(uint32_t data, int fixedbits)
 
 
 
-#ifdef C_ENABLE_VOODOO_OPENGL
 /*************************************
  *
  *  Rasterizer inlines
@@ -1238,7 +1423,8 @@ inline uint32_t normalize_tex_mode(uint32_t eff_tex_mode)
 	return eff_tex_mode;
 }
 
-inline uint32_t compute_raster_hash(const raster_info* info)
+template <typename T>
+inline uint32_t compute_raster_hash(const T* info)
 {
 	uint32_t hash;
 
@@ -1257,7 +1443,6 @@ inline uint32_t compute_raster_hash(const raster_info* info)
 
 	return hash % RASTER_HASH_SIZE;
 }
-#endif
 
 
 /*************************************
@@ -2663,6 +2848,9 @@ while (0)
 #define trexInit1		(0x320/4)	/*  W  F */
 #define nccTable		(0x324/4)	/*  W  F */
 
+static_assert(render_regs::first_reg == fbzColorPath);
+static_assert(render_regs::last_reg == color1);
+
 
 
 /*************************************
@@ -3008,6 +3196,7 @@ static voodoo_state* v = nullptr; //-V707
 static auto vtype = VOODOO_1;
 
 static auto voodoo_bilinear_filtering = false;
+static auto voodoo_deferred_rendering = false;
 
 #define LOG_VOODOO LOG_PCI
 enum {
@@ -3037,9 +3226,14 @@ static double Voodoo_GetHRetracePosition();
 static dither_lut_t dither2_lookup = {};
 static dither_lut_t dither4_lookup = {};
 
-static inline void raster_generic(const voodoo_state* vs, uint32_t TMUS, uint32_t TEXMODE0,
-                                  uint32_t TEXMODE1, void* destbase, int32_t y,
-                                  const poly_extent* extent, stats_block& stats)
+// The pixel pipeline shared by all rasterizers. Specialised instances
+// substitute the mode registers and texture modes with the compile-time
+// constants of their configuration, which lets the compiler fold away the
+// per-pixel mode checks and the pipeline stages they don't use.
+template <bool IsSpecialised, raster_config Config>
+static inline void raster_pipeline(const voodoo_state* vs, const triangle_job& tri,
+                                   int32_t y, const poly_extent* extent,
+                                   stats_block& stats)
 {
 	const uint8_t* dither_lookup = nullptr;
 	const uint8_t* dither4       = nullptr;
@@ -3050,16 +3244,30 @@ static inline void raster_generic(const voodoo_state* vs, uint32_t TMUS, uint32_
 	int32_t stopx = extent->stopx;
 
 	// Quick references
-	const auto regs  = vs->reg;
-	const auto& fbi  = vs->fbi;
-	const auto& tmu0 = vs->tmu[0];
-	const auto& tmu1 = vs->tmu[1];
-
-	const uint32_t r_fbzColorPath = regs[fbzColorPath].u;
-	const uint32_t r_fbzMode      = regs[fbzMode].u;
-	const uint32_t r_alphaMode    = regs[alphaMode].u;
-	const uint32_t r_fogMode      = regs[fogMode].u;
-	const uint32_t r_zaColor      = regs[zaColor].u;
+	const auto& fbi = vs->fbi;
+
+	// Rendering state captured with the triangle
+	const auto rs    = &tri.state;
+	const auto& regs = tri.state.reg;
+
+	// Triangle parameters
+	const auto& tp  = tri.params;
+	const auto& tp0 = tri.params.tmu[0];
+	const auto& tp1 = tri.params.tmu[1];
+
+	const uint32_t TMUS     = IsSpecialised ? Config.tmus() : tri.tmus;
+	const uint32_t TEXMODE0 = IsSpecialised ? Config.eff_tex_mode_0 : tri.texmode0;
+	const uint32_t TEXMODE1 = IsSpecialised ? Config.eff_tex_mode_1 : tri.texmode1;
+
+	const uint32_t r_fbzColorPath = IsSpecialised ? Config.eff_color_path
+	                                              : regs[fbzColorPath].u;
+	const uint32_t r_fbzMode   = IsSpecialised ? Config.eff_fbz_mode
+	                                           : regs[fbzMode].u;
+	const uint32_t r_alphaMode = IsSpecialised ? Config.eff_alpha_mode
+	                                           : regs[alphaMode].u;
+	const uint32_t r_fogMode   = IsSpecialised ? Config.eff_fog_mode
+	                                           : regs[fogMode].u;
+	const uint32_t r_zaColor   = regs[zaColor].u;
 
 	uint32_t r_stipple = regs[stipple].u;
 
@@ -3111,22 +3319,22 @@ static inline void raster_generic(const voodoo_state* vs, uint32_t TMUS, uint32_
 	}
 
 	/* get pointers to the target buffer and depth buffer */
-	uint16_t* dest  = (uint16_t*)destbase + scry * fbi.rowpixels;
+	uint16_t* dest  = tri.drawbuf + scry * fbi.rowpixels;
 	uint16_t* depth = (fbi.auxoffs != (uint32_t)(~0))
 	                        ? ((uint16_t*)(fbi.ram + fbi.auxoffs) +
 	                           scry * fbi.rowpixels)
 	                        : nullptr;
 
 	/* compute the starting parameters */
-	const int32_t dx = startx - (fbi.ax >> 4);
-	const int32_t dy = y - (fbi.ay >> 4);
-
-	int64_t iterr = fbi.startr + dy * fbi.drdy + dx * fbi.drdx;
-	int64_t iterg = fbi.startg + dy * fbi.dgdy + dx * fbi.dgdx;
-	int64_t iterb = fbi.startb + dy * fbi.dbdy + dx * fbi.dbdx;
-	int64_t itera = fbi.starta + dy * fbi.dady + dx * fbi.dadx;
-	int32_t iterz = fbi.startz + dy * fbi.dzdy + dx * fbi.dzdx;
-	int64_t iterw = fbi.startw + dy * fbi.dwdy + dx * fbi.dwdx;
+	const int32_t dx = startx - (tp.ax >> 4);
+	const int32_t dy = y - (tp.ay >> 4);
+
+	int64_t iterr = tp.startr + dy * tp.drdy + dx * tp.drdx;
+	int64_t iterg = tp.startg + dy * tp.dgdy + dx * tp.dgdx;
+	int64_t iterb = tp.startb + dy * tp.dbdy + dx * tp.dbdx;
+	int64_t itera = tp.starta + dy * tp.dady + dx * tp.dadx;
+	int32_t iterz = tp.startz + dy * tp.dzdy + dx * tp.dzdx;
+	int64_t iterw = tp.startw + dy * tp.dwdy + dx * tp.dwdx;
 	int64_t iterw0 = 0;
 	int64_t iterw1 = 0;
 	int64_t iters0 = 0;
@@ -3135,15 +3343,15 @@ static inline void raster_generic(const voodoo_state* vs, uint32_t TMUS, uint32_
 	int64_t itert1 = 0;
 	if (TMUS >= 1)
 	{
-		iterw0 = tmu0.startw + dy * tmu0.dwdy + dx * tmu0.dwdx;
-		iters0 = tmu0.starts + dy * tmu0.dsdy + dx * tmu0.dsdx;
-		itert0 = tmu0.startt + dy * tmu0.dtdy + dx * tmu0.dtdx;
+		iterw0 = tp0.startw + dy * tp0.dwdy + dx * tp0.dwdx;
+		iters0 = tp0.starts + dy * tp0.dsdy + dx * tp0.dsdx;
+		itert0 = tp0.startt + dy * tp0.dtdy + dx * tp0.dtdx;
 	}
 	if (TMUS >= 2)
 	{
-		iterw1 = tmu1.startw + dy * tmu1.dwdy + dx * tmu1.dwdx;
-		iters1 = tmu1.starts + dy * tmu1.dsdy + dx * tmu1.dsdx;
-		itert1 = tmu1.startt + dy * tmu1.dtdy + dx * tmu1.dtdx;
+		iterw1 = tp1.startw + dy * tp1.dwdy + dx * tp1.dwdx;
+		iters1 = tp1.starts + dy * tp1.dsdy + dx * tp1.dsdx;
+		itert1 = tp1.startt + dy * tp1.dtdy + dx * tp1.dtdx;
 	}
 
 	/* loop in X */
@@ -3153,31 +3361,31 @@ static inline void raster_generic(const voodoo_state* vs, uint32_t TMUS, uint32_
 		rgb_union texel = { 0 };
 
 		/* pixel pipeline part 1 handles depth testing and stippling */
-		PIXEL_PIPELINE_BEGIN(vs, stats, x, y, r_fbzColorPath, r_fbzMode, iterz, iterw, r_zaColor, r_stipple);
+		PIXEL_PIPELINE_BEGIN(rs, stats, x, y, r_fbzColorPath, r_fbzMode, iterz, iterw, r_zaColor, r_stipple);
 
 		/* run the texture pipeline on TMU1 to produce a value in texel */
 		/* note that they set LOD min to 8 to "disable" a TMU */
 
-		if (TMUS >= 2 && vs->tmu[1].lodmin < (8 << 8)) {
-			const tmu_state* const tmus = &vs->tmu[1];
+		if (TMUS >= 2 && tri.textures[1].lodmin < (8 << 8)) {
+			const texture_state* const tmus = &tri.textures[1];
 			const rgb_t* const lookup = tmus->lookup;
 			TEXTURE_PIPELINE(tmus, x, dither4, TEXMODE1, texel,
-								lookup, tmus->lodbasetemp,
+								lookup, tp1.lodbase,
 								iters1, itert1, iterw1, texel);
 		}
 
 		/* run the texture pipeline on TMU0 to produce a final */
 		/* result in texel */
 		/* note that they set LOD min to 8 to "disable" a TMU */
-		if (TMUS >= 1 && tmu0.lodmin < (8 << 8)) {
-			if (!vs->send_config) {
-				const tmu_state* const tmus = &tmu0;
+		if (TMUS >= 1 && tri.textures[0].lodmin < (8 << 8)) {
+			if (!tri.send_config) {
+				const texture_state* const tmus = &tri.textures[0];
 				const rgb_t* const lookup = tmus->lookup;
 				TEXTURE_PIPELINE(tmus, x, dither4, TEXMODE0, texel,
-								lookup, tmus->lodbasetemp,
+								lookup, tp0.lodbase,
 								iters0, itert0, iterw0, texel);
 			} else {	/* send config data to the frame buffer */
-				texel.u=vs->tmu_config;
+				texel.u=tri.tmu_config;
 			}
 		}
 
@@ -3210,7 +3418,7 @@ static inline void raster_generic(const voodoo_state* vs, uint32_t TMUS, uint32_
 		}
 
 		/* handle chroma key */
-		APPLY_CHROMAKEY(vs, stats, r_fbzMode, c_other);
+		APPLY_CHROMAKEY(rs, stats, r_fbzMode, c_other);
 
 		/* compute a_other */
 		switch (FBZCP_CC_ASELECT(r_fbzColorPath))
@@ -3230,10 +3438,10 @@ static inline void raster_generic(const voodoo_state* vs, uint32_t TMUS, uint32_
 		}
 
 		/* handle alpha mask */
-		APPLY_ALPHAMASK(vs, stats, r_fbzMode, c_other.rgb.a);
+		APPLY_ALPHAMASK(rs, stats, r_fbzMode, c_other.rgb.a);
 
 		/* handle alpha test */
-		APPLY_ALPHATEST(vs, stats, r_alphaMode, c_other.rgb.a);
+		APPLY_ALPHATEST(rs, stats, r_alphaMode, c_other.rgb.a);
 
 		/* compute c_local */
 		if (FBZCP_CC_LOCALSELECT_OVERRIDE(r_fbzColorPath) == 0)
@@ -3419,31 +3627,211 @@ static inline void raster_generic(const voodoo_state* vs, uint32_t TMUS, uint32_
 		}
 
 		/* pixel pipeline part 2 handles fog, alpha, and final output */
-		PIXEL_PIPELINE_MODIFY(vs, dither, dither4, x,
+		PIXEL_PIPELINE_MODIFY(rs, dither, dither4, x,
 							r_fbzMode, r_fbzColorPath, r_alphaMode, r_fogMode,
 							iterz, iterw, iterargb);
-		PIXEL_PIPELINE_FINISH(vs, dither_lookup, x, dest, depth, r_fbzMode);
+		PIXEL_PIPELINE_FINISH(rs, dither_lookup, x, dest, depth, r_fbzMode);
 		PIXEL_PIPELINE_END(stats);
 
 		/* update the iterated parameters */
-		iterr += fbi.drdx;
-		iterg += fbi.dgdx;
-		iterb += fbi.dbdx;
-		itera += fbi.dadx;
-		iterz += fbi.dzdx;
-		iterw += fbi.dwdx;
+		iterr += tp.drdx;
+		iterg += tp.dgdx;
+		iterb += tp.dbdx;
+		itera += tp.dadx;
+		iterz += tp.dzdx;
+		iterw += tp.dwdx;
 		if (TMUS >= 1)
 		{
-			iterw0 += tmu0.dwdx;
-			iters0 += tmu0.dsdx;
-			itert0 += tmu0.dtdx;
+			iterw0 += tp0.dwdx;
+			iters0 += tp0.dsdx;
+			itert0 += tp0.dtdx;
 		}
 		if (TMUS >= 2)
 		{
-			iterw1 += tmu1.dwdx;
-			iters1 += tmu1.dsdx;
-			itert1 += tmu1.dtdx;
+			iterw1 += tp1.dwdx;
+			iters1 += tp1.dsdx;
+			itert1 += tp1.dtdx;
+		}
+	}
+}
+
+static void raster_generic(const voodoo_state* vs, const triangle_job& tri,
+                           int32_t y, const poly_extent* extent, stats_block& stats)
+{
+	raster_pipeline<false, raster_config{}>(vs, tri, y, extent, stats);
+}
+
+template <raster_config Config>
+static void raster_specialised(const voodoo_state* vs, const triangle_job& tri,
+                               int32_t y, const poly_extent* extent,
+                               stats_block& stats)
+{
+	raster_pipeline<true, Config>(vs, tri, y, extent, stats);
+}
+
+/*-------------------------------------------------
+    Specialised rasterizers
+-------------------------------------------------*/
+
+struct raster_entry {
+	raster_config config = {};
+	raster_func callback = {};
+	raster_entry* next   = {}; /* next entry with the same hash */
+};
+
+#define RASTERIZER_ENTRY(fbzcp, alpha, fog, fbz, tex0, tex1) \
+	{{fbzcp, alpha, fog, fbz, tex0, tex1}, \
+	 raster_specialised<raster_config{fbzcp, alpha, fog, fbz, tex0, tex1}>, \
+	 nullptr}
+
+// Seed set of common Glide configurations in normalised form (see
+// normalize_*()). Triangles with any other configuration are drawn by
+// raster_generic(). Set LOG_RASTERIZERS to get the configurations a game
+// uses at shutdown in this format, and add the busiest ones here.
+//
+//                 fbzColorPath alphaMode   fogMode     fbzMode     textureMode0 textureMode1
+static raster_entry specialised_rasterizers[] = {
+        // Gouraud shaded, untextured
+        RASTERIZER_ENTRY(0x00000000, 0x00000000, 0x00000000, 0x00000731, 0xFFFFFFFF, 0xFFFFFFFF),
+        RASTERIZER_ENTRY(0x00000000, 0x00000000, 0x00000000, 0x00000739, 0xFFFFFFFF, 0xFFFFFFFF),
+        RASTERIZER_ENTRY(0x00000000, 0x00000000, 0x00000000, 0x00000301, 0xFFFFFFFF, 0xFFFFFFFF),
+
+        // Decal textured, Z or W buffered, bilinear or point sampled
+        RASTERIZER_ENTRY(0x00000005, 0x00000000, 0x00000000, 0x00000731, 0x0C261ACF, 0xFFFFFFFF),
+        RASTERIZER_ENTRY(0x00000005, 0x00000000, 0x00000000, 0x00000739, 0x0C261ACF, 0xFFFFFFFF),
+        RASTERIZER_ENTRY(0x00000005, 0x00000000, 0x00000000, 0x00000731, 0x0C261AC9, 0xFFFFFFFF),
+        RASTERIZER_ENTRY(0x00000005, 0x00000000, 0x00000000, 0x00000739, 0x0C261AC9, 0xFFFFFFFF),
+
+        // Textured modulated by the iterated colour, optionally fogged or
+        // alpha blended
+        RASTERIZER_ENTRY(0x00482405, 0x00000000, 0x00000000, 0x00000739, 0x0C261ACF, 0xFFFFFFFF),
+        RASTERIZER_ENTRY(0x00482405, 0x00000000, 0x00000001, 0x00000739, 0x0C261ACF, 0xFFFFFFFF),
+        RASTERIZER_ENTRY(0x00482405, 0x00005110, 0x00000000, 0x00000739, 0x0C261ACF, 0xFFFFFFFF),
+        RASTERIZER_ENTRY(0x00482405, 0x00000000, 0x00000000, 0x00000739, 0x0C261AC9, 0xFFFFFFFF),
+
+        // Alpha tested 2D overlays with palettised textures
+        RASTERIZER_ENTRY(0x00000005, 0x00000009, 0x00000000, 0x00000301, 0x0C2610C9, 0xFFFFFFFF),
+        RASTERIZER_ENTRY(0x00000005, 0x00005110, 0x00000000, 0x00000301, 0x0C2610C9, 0xFFFFFFFF),
+};
+
+#undef RASTERIZER_ENTRY
+
+static raster_entry* specialised_raster_hash[RASTER_HASH_SIZE] = {};
+
+static void init_specialised_rasterizers()
+{
+	static bool initialised = false;
+	if (initialised) {
+		return;
+	}
+	for (auto& entry : specialised_rasterizers) {
+		const auto hash = compute_raster_hash(&entry.config);
+
+		entry.next = specialised_raster_hash[hash];
+		specialised_raster_hash[hash] = &entry;
+	}
+	initialised = true;
+}
+
+static raster_func find_specialised_rasterizer(const raster_config& config)
+{
+	const auto hash = compute_raster_hash(&config);
+
+	for (auto entry = specialised_raster_hash[hash]; entry; entry = entry->next) {
+		if (entry->config == config) {
+			return entry->callback;
+		}
+	}
+	return nullptr;
+}
+
+/*-------------------------------------------------
+    select_rasterizer - pick the rasterizer for
+    the next triangle based on the current
+    register state
+-------------------------------------------------*/
+static void select_rasterizer(voodoo_state* vs, const int texcount,
+                              triangle_job& job)
+{
+	job.tmus     = check_cast<uint32_t>(texcount);
+	job.texmode0 = 0;
+	job.texmode1 = 0;
+	if (texcount >= 1) {
+		job.texmode0 = vs->tmu[0].reg[textureMode].u;
+		if (texcount >= 2) {
+			job.texmode1 = vs->tmu[1].reg[textureMode].u;
+		}
+		if (vs->tworker.disable_bilinear_filter) // force disable bilinear filter
+		{
+			job.texmode0 &= ~6;
+			job.texmode1 &= ~6;
+		}
+	}
+
+	const auto regs = vs->reg;
+
+	raster_config config = {};
+	config.eff_color_path = normalize_color_path(regs[fbzColorPath].u);
+	config.eff_alpha_mode = normalize_alpha_mode(regs[alphaMode].u);
+	config.eff_fog_mode   = normalize_fog_mode(regs[fogMode].u);
+	config.eff_fbz_mode   = normalize_fbz_mode(regs[fbzMode].u);
+	config.eff_tex_mode_0 = (texcount >= 1) ? normalize_tex_mode(job.texmode0)
+	                                        : 0xffffffff;
+	config.eff_tex_mode_1 = (texcount >= 2) ? normalize_tex_mode(job.texmode1)
+	                                        : 0xffffffff;
+
+	auto& rstats = vs->rstats;
+	if (!rstats.last_polys || config != rstats.last_config) {
+		rstats.last_config   = config;
+		rstats.last_callback = find_specialised_rasterizer(config);
+		rstats.last_polys    = &rstats.polys[config];
+	}
+	++(*rstats.last_polys);
+
+	job.rasterizer = rstats.last_callback ? rstats.last_callback : raster_generic;
+}
+
+static void log_rasterizer_stats(const voodoo_state* vs)
+{
+	std::vector<std::pair<uint32_t, raster_config>> configs = {};
+
+	uint64_t total_polys       = 0;
+	uint64_t specialised_polys = 0;
+	for (const auto& [config, polys] : vs->rstats.polys) {
+		total_polys += polys;
+		if (find_specialised_rasterizer(config)) {
+			specialised_polys += polys;
 		}
+		configs.emplace_back(polys, config);
+	}
+	if (total_polys == 0) {
+		return;
+	}
+
+	LOG_DEBUG("VOODOO: Drew %.1f%% of %llu triangles with specialised rasterizers, "
+	          "%zu distinct rasterizer configurations used",
+	          100.0 * static_cast<double>(specialised_polys) /
+	                  static_cast<double>(total_polys),
+	          static_cast<unsigned long long>(total_polys),
+	          configs.size());
+
+	if (!LOG_RASTERIZERS) {
+		return;
+	}
+
+	std::sort(configs.begin(), configs.end(), [](const auto& a, const auto& b) {
+		return a.first > b.first;
+	});
+	for (const auto& [polys, config] : configs) {
+		LOG_MSG("VOODOO:   RASTERIZER_ENTRY(0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X), // %u polys, %s",
+		        config.eff_color_path,
+		        config.eff_alpha_mode,
+		        config.eff_fog_mode,
+		        config.eff_fbz_mode,
+		        config.eff_tex_mode_0,
+		        config.eff_tex_mode_1,
+		        polys,
+		        find_specialised_rasterizer(config) ? "specialised" : "generic");
 	}
 }
 
@@ -4313,30 +4701,12 @@ static void update_statistics(voodoo_state *vs, bool accumulate)
 static void triangle_worker_work(const triangle_worker& tworker,
                                  const int32_t work_start, const int32_t work_end)
 {
-	/* determine the number of TMUs involved */
-	uint32_t tmus     = 0;
-	uint32_t texmode0 = 0;
-	uint32_t texmode1 = 0;
-	if (!FBIINIT3_DISABLE_TMUS(v->reg[fbiInit3].u) && FBZCP_TEXTURE_ENABLE(v->reg[fbzColorPath].u))
-	{
-		tmus = 1;
-		texmode0 = v->tmu[0].reg[textureMode].u;
-		if ((v->chipmask & 0x04) != 0)
-		{
-			tmus = 2;
-			texmode1 = v->tmu[1].reg[textureMode].u;
-		}
-		if (tworker.disable_bilinear_filter) //force disable bilinear filter
-		{
-			texmode0 &= ~6;
-			texmode1 &= ~6;
-		}
-	}
+	const triangle_job& tri = tworker.job;
 
 	/* compute the slopes for each portion of the triangle */
-	const poly_vertex v1 = tworker.v1;
-	const poly_vertex v2 = tworker.v2;
-	const poly_vertex v3 = tworker.v3;
+	const poly_vertex v1 = tri.v1;
+	const poly_vertex v2 = tri.v2;
+	const poly_vertex v3 = tri.v3;
 
 	const float dxdy_v1v2 = (v2.y == v1.y) ? 0.0f
 	                                       : (v2.x - v1.x) / (v2.y - v1.y);
@@ -4358,7 +4728,7 @@ static void triangle_worker_work(const triangle_worker& tworker,
 	const int32_t from = tworker.totalpix * work_start / num_work_units;
 	const int32_t to   = tworker.totalpix * work_end / num_work_units;
 
-	for (int32_t curscan = tworker.v1y, scanend = tworker.v3y, sumpix = 0, lastsum = 0;
+	for (int32_t curscan = tri.v1y, scanend = tri.v3y, sumpix = 0, lastsum = 0;
 	     curscan != scanend && lastsum < to;
 	     lastsum = sumpix, curscan++) {
 
@@ -4397,11 +4767,74 @@ static void triangle_worker_work(const triangle_worker& tworker,
 			extent.stopx -= (sumpix - to);
 		}
 
-		raster_generic(v, tmus, texmode0, texmode1, tworker.drawbuf, curscan, &extent, my_stats);
+		tri.rasterizer(v, tri, curscan, &extent, my_stats);
 	}
 	sum_statistics(&v->thread_stats[work_start], &my_stats);
 }
 
+// In deferred mode, the scanlines are dealt out to the work units in
+// interleaved bands of this height. Every unit draws all the triangles of
+// the batch in order, but only the scanlines of its own band, so no two
+// units ever touch the same pixel and the drawing order of overlapping
+// triangles is preserved.
+constexpr auto DeferredBandHeight = 8;
+
+static void triangle_worker_work_band(const triangle_worker& tworker, const int band)
+{
+	const auto num_bands = static_cast<uint32_t>(tworker.num_work_units);
+
+	stats_block my_stats = {};
+
+	for (const triangle_job& tri : tworker.batch) {
+		/* compute the slopes for each portion of the triangle */
+		const poly_vertex v1 = tri.v1;
+		const poly_vertex v2 = tri.v2;
+		const poly_vertex v3 = tri.v3;
+
+		const float dxdy_v1v2 = (v2.y == v1.y) ? 0.0f
+		                                       : (v2.x - v1.x) / (v2.y - v1.y);
+		const float dxdy_v1v3 = (v3.y == v1.y) ? 0.0f
+		                                       : (v3.x - v1.x) / (v3.y - v1.y);
+		const float dxdy_v2v3 = (v3.y == v2.y) ? 0.0f
+		                                       : (v3.x - v2.x) / (v3.y - v2.y);
+
+		for (int32_t curscan = tri.v1y, scanend = tri.v3y; curscan != scanend;
+		     curscan++) {
+			const auto scan_band = (static_cast<uint32_t>(curscan) /
+			                        DeferredBandHeight) %
+			                       num_bands;
+			if (scan_band != static_cast<uint32_t>(band)) {
+				continue;
+			}
+
+			const float fully = (float)(curscan) + 0.5f;
+
+			const float startx = v1.x + (fully - v1.y) * dxdy_v1v3;
+
+			/* compute the ending X based on which part of the triangle we're in */
+			const float stopx = (fully < v2.y
+			                             ? (v1.x + (fully - v1.y) * dxdy_v1v2)
+			                             : (v2.x + (fully - v2.y) * dxdy_v2v3));
+
+			/* clamp to full pixels */
+			poly_extent extent;
+			extent.startx = round_coordinate(startx);
+			extent.stopx  = round_coordinate(stopx);
+
+			/* force start < stop */
+			if (extent.startx >= extent.stopx) {
+				if (extent.startx == extent.stopx) {
+					continue;
+				}
+				std::swap(extent.startx, extent.stopx);
+			}
+
+			tri.rasterizer(v, tri, curscan, &extent, my_stats);
+		}
+	}
+	sum_statistics(&v->thread_stats[band], &my_stats);
+}
+
 // NOTE (weirddan455): In case anyone wants to optimize this further on ARM:
 //
 // I was conservative with setting memory order on these atomic variables.
@@ -4438,7 +4871,11 @@ static int do_triangle_work(triangle_worker& tworker)
 
 	i = tworker.work_index.fetch_add(1, std::memory_order_acq_rel);
 	if (i < tworker.num_work_units) {
-		triangle_worker_work(tworker, i, i + 1);
+		if (tworker.deferred) {
+			triangle_worker_work_band(tworker, i);
+		} else {
+			triangle_worker_work(tworker, i, i + 1);
+		}
 		int done = tworker.done_count.fetch_add(1, std::memory_order_acq_rel) + 1;
 		if (done >= tworker.num_work_units) {
 			tworker.done_count.notify_all();
@@ -4478,8 +4915,136 @@ static void triangle_worker_shutdown(triangle_worker& tworker)
 	}
 }
 
-static void triangle_worker_run(triangle_worker& tworker)
+static void triangle_worker_start_threads(triangle_worker& tworker)
+{
+	// The main thread is the only one who sets threads_active (here and in shutdown) so there is no race condition.
+	// In the future, if this changes, this will need to be an atomic compare_exchange.
+	// For now, this is better because 99% of the time threads_active == true.
+	// We only spin up the threads once and a load is much faster than a compare_exchange.
+	if (!tworker.threads_active.load(std::memory_order_acquire))
+	{
+		tworker.threads_active.store(true, std::memory_order_release);
+
+		for (auto& triangle_worker : tworker.threads) {
+			triangle_worker = std::thread([] {
+				triangle_worker_thread_func();
+			});
+		}
+	}
+}
+
+// Deferred mode hands the queued triangles over to the workers once this many
+// have piled up, or sooner if the workers are idle
+constexpr size_t MaxQueuedTriangles = 512;
+constexpr size_t MinQueuedTriangles = 16;
+
+static bool triangle_worker_batch_done(const triangle_worker& tworker)
+{
+	return !tworker.batch_in_flight ||
+	       tworker.done_count.load(std::memory_order_acquire) >=
+	               tworker.num_work_units;
+}
+
+static void triangle_worker_wait_batch(triangle_worker& tworker)
+{
+	if (!tworker.batch_in_flight) {
+		return;
+	}
+
+	// Help out rather than just sit around
+	while (do_triangle_work(tworker) < tworker.num_work_units);
+
+	// Wait until all work has been completed by the worker threads.
+	int i;
+	while ((i = tworker.done_count.load(std::memory_order_acquire)) < tworker.num_work_units) {
+		tworker.done_count.wait(i, std::memory_order_acquire);
+	}
+
+	tworker.batch.clear();
+	tworker.batch_in_flight = false;
+}
+
+static void triangle_worker_submit_batch(triangle_worker& tworker)
+{
+	triangle_worker_wait_batch(tworker);
+
+	std::swap(tworker.batch, tworker.queued);
+	tworker.batch_in_flight = true;
+
+	++tworker.deferred_stats.batches;
+	tworker.deferred_stats.triangles += tworker.batch.size();
+
+	triangle_worker_start_threads(tworker);
+
+	tworker.done_count.store(0, std::memory_order_release);
+
+	// Reseting this index triggers the worker threads to start working
+	tworker.work_index.store(0, std::memory_order_release);
+	tworker.work_index.notify_all();
+}
+
+static void triangle_worker_queue(triangle_worker& tworker, const triangle_job& job)
+{
+	tworker.queued.push_back(job);
+
+	const auto num_queued = tworker.queued.size();
+
+	// Only block on the previous batch when the queue is full
+	if (num_queued >= MaxQueuedTriangles ||
+	    (num_queued >= MinQueuedTriangles && triangle_worker_batch_done(tworker))) {
+		triangle_worker_submit_batch(tworker);
+	}
+}
+
+static bool triangle_worker_has_pending(const triangle_worker& tworker)
 {
+	return tworker.deferred &&
+	       (!tworker.queued.empty() || tworker.batch_in_flight);
+}
+
+// Draws all deferred triangles and waits for them to finish. This must be
+// called before anything that reads or writes the frame buffer, the texture
+// memory or the texel lookup tables, or changes the state the rasterizers
+// depend on that isn't captured with each triangle (see
+// is_render_state_register()).
+static void triangle_worker_sync(triangle_worker& tworker)
+{
+	if (!tworker.deferred) {
+		return;
+	}
+	if (triangle_worker_has_pending(tworker)) {
+		++tworker.deferred_stats.syncs;
+	}
+	if (!tworker.queued.empty()) {
+		triangle_worker_submit_batch(tworker);
+	}
+	triangle_worker_wait_batch(tworker);
+}
+
+static void log_deferred_stats(const triangle_worker& tworker)
+{
+	const auto& stats = tworker.deferred_stats;
+	if (!tworker.deferred || stats.batches == 0) {
+		return;
+	}
+	LOG_MSG("VOODOO: Deferred rendering drew %llu triangles in %llu batches, "
+	        "waited for them %llu times, and %llu rendering state changes "
+	        "didn't need to wait",
+	        static_cast<unsigned long long>(stats.triangles),
+	        static_cast<unsigned long long>(stats.batches),
+	        static_cast<unsigned long long>(stats.syncs),
+	        static_cast<unsigned long long>(stats.state_changes));
+}
+
+static void triangle_worker_run(triangle_worker& tworker, const triangle_job& job)
+{
+	if (tworker.deferred) {
+		triangle_worker_queue(tworker, job);
+		return;
+	}
+
+	tworker.job = job;
+
 	if (!tworker.num_threads) {
 		// do not use threaded calculation
 		tworker.totalpix = 0xFFFFFFF;
@@ -4488,9 +5053,9 @@ static void triangle_worker_run(triangle_worker& tworker)
 	}
 
 	/* compute the slopes for each portion of the triangle */
-	const poly_vertex v1 = tworker.v1;
-	const poly_vertex v2 = tworker.v2;
-	const poly_vertex v3 = tworker.v3;
+	const poly_vertex v1 = job.v1;
+	const poly_vertex v2 = job.v2;
+	const poly_vertex v3 = job.v3;
 
 	const float dxdy_v1v2 = (v2.y == v1.y) ? 0.0f
 	                                       : (v2.x - v1.x) / (v2.y - v1.y);
@@ -4500,7 +5065,7 @@ static void triangle_worker_run(triangle_worker& tworker)
 	                                       : (v3.x - v2.x) / (v3.y - v2.y);
 
 	int32_t pixsum = 0;
-	for (int32_t curscan = tworker.v1y, scanend = tworker.v3y; curscan != scanend; curscan++)
+	for (int32_t curscan = job.v1y, scanend = job.v3y; curscan != scanend; curscan++)
 	{
 		const float fully  = (float)(curscan) + 0.5f;
 		const float startx = v1.x + (fully - v1.y) * dxdy_v1v3;
@@ -4526,20 +5091,7 @@ static void triangle_worker_run(triangle_worker& tworker)
 		return;
 	}
 
-	// The main thread is the only one who sets threads_active (here and in shutdown) so there is no race condition.
-	// In the future, if this changes, this will need to be an atomic compare_exchange.
-	// For now, this is better because 99% of the time threads_active == true.
-	// We only spin up the threads once and a load is much faster than a compare_exchange.
-	if (!tworker.threads_active.load(std::memory_order_acquire))
-	{
-		tworker.threads_active.store(true, std::memory_order_release);
-
-		for (auto& triangle_worker : tworker.threads) {
-			triangle_worker = std::thread([] {
-				triangle_worker_thread_func();
-			});
-		}
-	}
+	triangle_worker_start_threads(tworker);
 
 	tworker.done_count.store(0, std::memory_order_release);
 
@@ -4557,6 +5109,87 @@ static void triangle_worker_run(triangle_worker& tworker)
 	}
 }
 
+static void capture_triangle_params(const voodoo_state* vs, const int texcount,
+                                    triangle_params& params)
+{
+	const auto& fbi = vs->fbi;
+
+	params.ax     = fbi.ax;
+	params.ay     = fbi.ay;
+	params.startr = fbi.startr;
+	params.startg = fbi.startg;
+	params.startb = fbi.startb;
+	params.starta = fbi.starta;
+	params.startz = fbi.startz;
+	params.startw = fbi.startw;
+	params.drdx   = fbi.drdx;
+	params.dgdx   = fbi.dgdx;
+	params.dbdx   = fbi.dbdx;
+	params.dadx   = fbi.dadx;
+	params.dzdx   = fbi.dzdx;
+	params.dwdx   = fbi.dwdx;
+	params.drdy   = fbi.drdy;
+	params.dgdy   = fbi.dgdy;
+	params.dbdy   = fbi.dbdy;
+	params.dady   = fbi.dady;
+	params.dzdy   = fbi.dzdy;
+	params.dwdy   = fbi.dwdy;
+
+	for (auto i = 0; i < texcount; ++i) {
+		const auto& tmu = vs->tmu[i];
+		auto& tp        = params.tmu[i];
+
+		tp.starts  = tmu.starts;
+		tp.startt  = tmu.startt;
+		tp.startw  = tmu.startw;
+		tp.dsdx    = tmu.dsdx;
+		tp.dtdx    = tmu.dtdx;
+		tp.dwdx    = tmu.dwdx;
+		tp.dsdy    = tmu.dsdy;
+		tp.dtdy    = tmu.dtdy;
+		tp.dwdy    = tmu.dwdy;
+		tp.lodbase = tmu.lodbasetemp;
+	}
+}
+
+static void capture_render_state(const voodoo_state* vs, const int texcount,
+                                 triangle_job& job)
+{
+	auto& state = job.state;
+
+	std::copy_n(&vs->reg[render_regs::first_reg],
+	            std::size(state.reg.regs),
+	            state.reg.regs);
+
+	const auto& fbi = vs->fbi;
+	std::copy_n(fbi.fogblend, std::size(fbi.fogblend), state.fbi.fogblend);
+	std::copy_n(fbi.fogdelta, std::size(fbi.fogdelta), state.fbi.fogdelta);
+	state.fbi.fogdelta_mask = fbi.fogdelta_mask;
+
+	for (auto i = 0; i < texcount; ++i) {
+		const auto& tmu = vs->tmu[i];
+		auto& tex       = job.textures[i];
+
+		tex.ram           = tmu.ram;
+		tex.mask          = tmu.mask;
+		tex.lodmin        = tmu.lodmin;
+		tex.lodmax        = tmu.lodmax;
+		tex.lodbias       = tmu.lodbias;
+		tex.lodmask       = tmu.lodmask;
+		std::copy_n(tmu.lodoffset, std::size(tmu.lodoffset), tex.lodoffset);
+		tex.detailmax     = tmu.detailmax;
+		tex.detailbias    = tmu.detailbias;
+		tex.detailscale   = tmu.detailscale;
+		tex.wmask         = tmu.wmask;
+		tex.hmask         = tmu.hmask;
+		tex.bilinear_mask = tmu.bilinear_mask;
+		tex.lookup        = tmu.lookup;
+	}
+
+	job.send_config = vs->send_config;
+	job.tmu_config  = vs->tmu_config;
+}
+
 /*-------------------------------------------------
     triangle - execute the 'triangle'
     command
@@ -4759,12 +5392,15 @@ static void triangle(voodoo_state *vs)
 		}
 	}
 
-	triangle_worker& tworker = vs->tworker;
-	tworker.v1 = *v1, tworker.v2 = *v2, tworker.v3 = *v3;
-	tworker.drawbuf = drawbuf;
-	tworker.v1y = v1y;
-	tworker.v3y = v3y;
-	triangle_worker_run(tworker);
+	triangle_job job = {};
+	job.v1 = *v1, job.v2 = *v2, job.v3 = *v3;
+	job.drawbuf = drawbuf;
+	job.v1y = v1y;
+	job.v3y = v3y;
+	select_rasterizer(vs, texcount, job);
+	capture_triangle_params(vs, texcount, job.params);
+	capture_render_state(vs, texcount, job);
+	triangle_worker_run(vs->tworker, job);
 
 	/* update stats */
 	regs[fbiTrianglesOut].u++;
@@ -5172,6 +5808,45 @@ static void soft_reset(voodoo_state *vs)
 }
 
 
+// Returns whether a register holds rendering state that's captured with each
+// triangle (see capture_render_state()). Changing it doesn't have to wait for
+// the deferred triangles to be drawn.
+static bool is_render_state_register(const uint8_t regnum)
+{
+	/* fog tables */
+	if (regnum >= fogTable && regnum < fogTable + 32) {
+		return true;
+	}
+	switch (regnum) {
+	/* rendering modes and colors */
+	case fbzColorPath:
+	case fogMode:
+	case alphaMode:
+	case fbzMode:
+	case lfbMode:
+	case clipLeftRight:
+	case clipLowYHighY:
+	case fogColor:
+	case zaColor:
+	case chromaKey:
+	case chromaRange:
+	case stipple:
+	case color0:
+	case color1:
+
+	/* texture modes, LODs and base addresses */
+	case textureMode:
+	case tLOD:
+	case tDetail:
+	case texBaseAddr:
+	case texBaseAddr_1:
+	case texBaseAddr_2:
+	case texBaseAddr_3_8: return true;
+
+	default: return false;
+	}
+}
+
 /*************************************
  *
  *  Voodoo register writes
@@ -5207,6 +5882,19 @@ static void register_w(uint32_t offset, uint32_t data)
 		return;
 	}
 
+	/* deferred triangles capture the vertex and parameter registers and */
+	/* the rendering state, but everything else must be settled before it */
+	/* changes */
+	const auto is_triangle_setup = (regnum >= vertexAx && regnum <= ftriangleCMD) ||
+	                               (regnum >= sSetupMode && regnum <= sBeginTriCMD);
+	if (is_render_state_register(regnum)) {
+		if (triangle_worker_has_pending(v->tworker)) {
+			++v->tworker.deferred_stats.state_changes;
+		}
+	} else if (!is_triangle_setup) {
+		triangle_worker_sync(v->tworker);
+	}
+
 	/* switch off the register */
 	switch (regnum)
 	{
@@ -6833,6 +7521,12 @@ static uint32_t register_r(const uint32_t offset)
 		return 0xffffffff;
 	}
 
+	/* the status register is polled a lot and doesn't depend on the */
+	/* drawing results, so don't make it wait for deferred triangles */
+	if (regnum != status) {
+		triangle_worker_sync(v->tworker);
+	}
+
 	/* default result is the FBI register value */
 	auto result = v->reg[regnum].u;
 
@@ -7023,7 +7717,13 @@ static void voodoo_w(const uint32_t addr, const uint32_t data, const uint32_t ma
 
 	if ((offset & offset_base) == 0) {
 		register_w(offset, data);
-	} else if ((offset & lfb_base) == 0) {
+		return;
+	}
+
+	// Frame buffer and texture writes must not overtake deferred triangles
+	triangle_worker_sync(v->tworker);
+
+	if ((offset & lfb_base) == 0) {
 		lfb_w(offset, data, mask);
 	} else {
 		texture_w(offset, data);
@@ -7038,6 +7738,7 @@ static constexpr uint32_t voodoo_r(const uint32_t addr)
 		return register_r(offset);
 	}
 	if ((offset & lfb_base) == 0) {
+		triangle_worker_sync(v->tworker);
 		return lfb_r(offset);
 	}
 	return 0xffffffff;
@@ -7106,6 +7807,8 @@ static void initialise_voodoo()
 
 	v = new voodoo_state(num_additional_threads);
 
+	init_specialised_rasterizers();
+
 #ifdef C_ENABLE_VOODOO_OPENGL
 	v->ogl = (emulation_type == VOODOO_EMU_TYPE_ACCELERATED);
 #endif
@@ -7347,6 +8050,8 @@ static void Voodoo_VerticalTimer(uint32_t /*val*/)
 #endif
 
 		// draw all lines at once
+		triangle_worker_sync(v->tworker);
+
 		auto* viewbuf = (uint16_t*)(v->fbi.ram +
 		                            v->fbi.rgboffs[v->fbi.frontbuf]);
 		for(Bitu i = 0; i < v->fbi.height; i++) {
@@ -7844,8 +8549,12 @@ static void voodoo_shutdown()
 #endif
 
 	v->active = false;
+	triangle_worker_sync(v->tworker);
 	triangle_worker_shutdown(v->tworker);
 
+	log_rasterizer_stats(v);
+	log_deferred_stats(v->tworker);
+
 	delete v;
 	v = nullptr;
 
@@ -7864,6 +8573,9 @@ static void Voodoo_Startup() {
 
 	v->tworker.disable_bilinear_filter = (voodoo_bilinear_filtering == false);
 
+	// Deferred rendering needs worker threads to do the drawing
+	v->tworker.deferred = voodoo_deferred_rendering && v->tworker.num_threads > 0;
+
 	// Switch the pagehandler now that v has been allocated and is in use
 	voodoo_pagehandler = &voodoo_real_pagehandler;
 	PAGING_InitTLB();
@@ -7886,6 +8598,7 @@ void VOODOO_Init()
 	vtype = (memsize_pref == "4" ? VOODOO_1 : VOODOO_1_DTMU);
 
 	voodoo_bilinear_filtering = section->GetBool("voodoo_bilinear_filtering");
+	voodoo_deferred_rendering = section->GetBool("voodoo_deferred_rendering");
 
 	// Check 64 KB alignment of LFB base
 	static_assert((PciVoodooLfbBase & 0xffff) == 0);
@@ -7898,11 +8611,13 @@ void VOODOO_Init()
 	// Log the startup
 	const auto num_threads = get_num_total_threads();
 
-	LOG_MSG("VOODOO: Initialized with %s MB of RAM, %d %s, and %sbilinear filtering",
+	LOG_MSG("VOODOO: Initialized with %s MB of RAM, %d %s, %sbilinear filtering, "
+	        "and %s rendering",
 	        memsize_pref.c_str(),
 	        num_threads,
 	        num_threads == 1 ? "thread" : "threads",
-	        (voodoo_bilinear_filtering ? "" : "no "));
+	        (voodoo_bilinear_filtering ? "" : "no "),
+	        (voodoo_deferred_rendering && num_threads > 1 ? "deferred" : "immediate"));
 }
 
 void VOODOO_Destroy()
@@ -7959,6 +8674,14 @@ static void init_voodoo_config_settings(SectionProp& section)
 	        "Use bilinear filtering to emulate the 3dfx Voodoo's texture smoothing effect\n"
 	        "('on' by default). Bilinear filtering can impact frame rates on slower systems;\n"
 	        "try turning it off if you're not getting adequate performance.");
+
+	bool_prop = section.AddBool("voodoo_deferred_rendering", OnlyAtStart, false);
+	bool_prop->SetHelp(
+	        "Draw 3dfx Voodoo triangles in the background while the emulation carries on\n"
+	        "('off' by default). Triangles are queued up and drawn by the worker threads\n"
+	        "in batches; the emulation only waits for them when the game accesses the frame\n"
+	        "buffer or textures, swaps or clears buffers, or when a frame is shown.\n"
+	        "This requires 'voodoo_threads' to be 2 or more.");
 }
 
 void VOODOO_AddConfigSection(const ConfigPtr& conf)
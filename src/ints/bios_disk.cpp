@@ -14,6 +14,9 @@
 #include "dos/drives.h"
 #include "gui/mapper.h"
 #include "hardware/memory.h"
+#include "misc/cross.h"
+#include "private/disk_sector_cache.h"
+#include "utils/mapped_file.h"
 #include "utils/string_utils.h"
 
 static const std::vector<DiskGeometry> disk_geometry_list = {
@@ -50,12 +53,33 @@ static bool swapping_requested;
 
 void BIOS_SetEquipment(uint16_t equipment);
 
+// All open disk images, including the ones only used by FAT drives, so their
+// cached sectors can be written back on disk resets and at shutdown
+static std::vector<imageDisk*> open_disk_images = {};
+
 /* 2 floppys and 2 harddrives, max */
 std::array<std::shared_ptr<imageDisk>, MAX_DISK_IMAGES> imageDiskList = {};
 std::array<std::shared_ptr<imageDisk>, MAX_SWAPPABLE_DISKS> diskSwap  = {};
 
 unsigned int swapPosition;
 
+constexpr auto DefaultDiskCacheSizeMb = 8;
+
+static int disk_cache_size_mb = DefaultDiskCacheSizeMb;
+
+void BIOS_SetDiskCacheSize(const int size_mb)
+{
+	assert(size_mb >= 0);
+	disk_cache_size_mb = size_mb;
+}
+
+void BIOS_FlushDiskImages()
+{
+	for (const auto disk : open_disk_images) {
+		disk->Flush();
+	}
+}
+
 void updateDPT(void)
 {
 	uint32_t tmpheads, tmpcyl, tmpsect, tmpsize;
@@ -176,6 +200,40 @@ uint8_t imageDisk::Read_Sector(uint32_t head, uint32_t cylinder,
 
 uint8_t imageDisk::Read_AbsoluteSector(uint32_t sectnum, void* data)
 {
+	if (mapping) {
+		const auto image   = mapping->GetData();
+		const auto bytenum = static_cast<size_t>(sectnum) * sector_size;
+
+		// Sectors past the end of the mapping take the regular path
+		if (bytenum + sector_size <= image.size()) {
+			memcpy(data, image.data() + bytenum, sector_size);
+
+			// Only perform delay if we booted from a disk image
+			// Otherwise this would result in delay duplication in the int21 handler
+			if (DOS_IsGuestOsBooted()) {
+				DiskType type = hardDrive ? DiskType::HardDisk
+				                          : DiskType::Floppy;
+				DOS_PerformDiskIoDelay(sector_size, type);
+			}
+			return 0x00;
+		}
+	} else if (cache) {
+		if (!cache->ReadSector(sectnum, data)) {
+			LOG_ERR("BIOSDISK: Could not seek to sector %u in file '%s': %s",
+			        sectnum,
+			        diskname,
+			        strerror(errno));
+			return 0xff;
+		}
+		// Only perform delay if we booted from a disk image
+		// Otherwise this would result in delay duplication in the int21 handler
+		if (DOS_IsGuestOsBooted()) {
+			DiskType type = hardDrive ? DiskType::HardDisk : DiskType::Floppy;
+			DOS_PerformDiskIoDelay(sector_size, type);
+		}
+		return 0x00;
+	}
+
 	const auto bytenum = check_cast<cross_off_t>(sectnum) * sector_size;
 
 	if (last_action == WRITE || bytenum != current_fpos) {
@@ -214,6 +272,40 @@ uint8_t imageDisk::Write_Sector(uint32_t head, uint32_t cylinder,
 
 uint8_t imageDisk::Write_AbsoluteSector(uint32_t sectnum, void* data)
 {
+	// Neither the mapping nor the sector cache can report writes to
+	// read-only images, as they only reach the file later
+	if (!is_writable) {
+		return 0x05;
+	}
+
+	if (mapping && mapping->IsWritable()) {
+		const auto image   = mapping->GetWritableData();
+		const auto bytenum = static_cast<size_t>(sectnum) * sector_size;
+
+		// Writes past the end of the mapping grow the file through the
+		// regular path
+		if (bytenum + sector_size <= image.size()) {
+			// Only perform delay if we booted from a disk image
+			// Otherwise this would result in delay duplication in the int21 handler
+			if (DOS_IsGuestOsBooted()) {
+				DiskType type = hardDrive ? DiskType::HardDisk
+				                          : DiskType::Floppy;
+				DOS_PerformDiskIoDelay(sector_size, type);
+			}
+			memcpy(image.data() + bytenum, data, sector_size);
+			return 0x00;
+		}
+	} else if (cache) {
+		// Only perform delay if we booted from a disk image
+		// Otherwise this would result in delay duplication in the int21 handler
+		if (DOS_IsGuestOsBooted()) {
+			DiskType type = hardDrive ? DiskType::HardDisk : DiskType::Floppy;
+			DOS_PerformDiskIoDelay(sector_size, type);
+		}
+		// Writing back the sectors of evicted blocks can fail
+		return cache->WriteSector(sectnum, data) ? 0x00 : 0x05;
+	}
+
 	const auto bytenum = check_cast<cross_off_t>(sectnum) * sector_size;
 
 	// LOG_MSG("Writing sectors to %ld at bytenum %d", sectnum, bytenum);
@@ -253,11 +345,19 @@ imageDisk::imageDisk(FILE* img_file, const char* img_name, uint32_t img_size_k,
           cylinders(0),
           sectors(0),
           current_fpos(0),
-          last_action(NONE)
+          last_action(NONE),
+          mapping(nullptr),
+          cache(nullptr)
 {
 	fseek(diskimg, 0, SEEK_SET);
 	memset(diskname, 0, 512);
 	safe_strcpy(diskname, img_name);
+	if (diskimg != nullptr) {
+		is_writable = is_file_writable(diskimg);
+		mapping     = MappedFile::Map(diskimg);
+	}
+	ResetCache();
+	open_disk_images.push_back(this);
 	if (!is_hdd) {
 		bool founddisk = false;
 		for (uint8_t i = 0; i < disk_geometry_list.size(); ++i) {
@@ -283,14 +383,67 @@ imageDisk::imageDisk(FILE* img_file, const char* img_name, uint32_t img_size_k,
 	}
 }
 
+imageDisk::~imageDisk()
+{
+	std::erase(open_disk_images, this);
+
+	if (cache) {
+		const auto& stats = cache->GetStats();
+		LOG_DEBUG("BIOSDISK: '%s' sector cache: %llu reads, %.1f%% hits, "
+		          "%llu sectors read ahead; %llu writes, %llu file writes",
+		          diskname,
+		          static_cast<unsigned long long>(stats.sector_reads),
+		          static_cast<double>(cache->GetHitRatePercent()),
+		          static_cast<unsigned long long>(stats.sectors_read_ahead),
+		          static_cast<unsigned long long>(stats.sector_writes),
+		          static_cast<unsigned long long>(stats.file_writes));
+
+		// Write back the cached sectors before closing the file
+		cache = {};
+	}
+	mapping = {};
+	if (diskimg != nullptr) {
+		fclose(diskimg);
+	}
+}
+
+void imageDisk::ResetCache()
+{
+	cache = {};
+
+	// Mapped images don't need the cache
+	if (!mapping && diskimg != nullptr && disk_cache_size_mb > 0) {
+		constexpr size_t BytesPerMb = 1024 * 1024;
+
+		cache = std::make_unique<DiskSectorCache>(
+		        diskimg,
+		        sector_size,
+		        static_cast<size_t>(disk_cache_size_mb) * BytesPerMb);
+	}
+}
+
+void imageDisk::Flush()
+{
+	if (mapping) {
+		mapping->Flush();
+	}
+	if (cache) {
+		cache->Flush();
+	}
+}
+
 void imageDisk::Set_Geometry(uint32_t setHeads, uint32_t setCyl,
                              uint32_t setSect, uint32_t setSectSize)
 {
-	heads       = setHeads;
-	cylinders   = setCyl;
-	sectors     = setSect;
-	sector_size = setSectSize;
-	active      = true;
+	heads     = setHeads;
+	cylinders = setCyl;
+	sectors   = setSect;
+	active    = true;
+
+	if (setSectSize != sector_size) {
+		sector_size = setSectSize;
+		ResetCache();
+	}
 }
 
 void imageDisk::Get_Geometry(uint32_t* getHeads, uint32_t* getCyl,
@@ -403,6 +556,9 @@ static Bitu INT13_DiskHandler(void)
 			}
 			return CBRET_NONE;
 		}
+		if (any_images) {
+			imageDiskList[drivenum]->Flush();
+		}
 		if (!is_machine_pcjr() && reg_dl < 0x80) {
 			reg_ip++;
 		}
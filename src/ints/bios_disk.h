@@ -29,6 +29,9 @@ struct DiskGeometry {
 
 const std::vector<DiskGeometry>& BIOS_GetDiskGeometryList();
 
+class DiskSectorCache;
+class MappedFile;
+
 class imageDisk  {
 public:
 	uint8_t Read_Sector(uint32_t head,uint32_t cylinder,uint32_t sector,void * data);
@@ -45,11 +48,11 @@ public:
 	imageDisk(const imageDisk&) = delete; // prevent copy
 	imageDisk& operator=(const imageDisk&) = delete; // prevent assignment
 
-	~imageDisk()
-	{
-		if (diskimg != nullptr)
-			fclose(diskimg);
-	}
+	~imageDisk();
+
+	// Writes the sectors held in the sector cache, or modified through the
+	// mapping of the image file, back to the image file
+	void Flush();
 
 	bool hardDrive;
 	bool active;
@@ -60,10 +63,27 @@ public:
 	uint32_t sector_size;
 	uint32_t heads,cylinders,sectors;
 private:
+	void ResetCache();
+
 	cross_off_t current_fpos;
 	enum { NONE,READ,WRITE } last_action;
+
+	// Whether the image file was opened for writing
+	bool is_writable = false;
+
+	// Images that can be memory-mapped are read and written through the
+	// mapping; the others through the sector cache, if enabled
+	std::unique_ptr<MappedFile> mapping;
+	std::unique_ptr<DiskSectorCache> cache;
 };
 
+// Sets the size of the sector cache of the disk images mounted afterwards; 0
+// disables the cache
+void BIOS_SetDiskCacheSize(int size_mb);
+
+// Writes the cached sectors of all open disk images back to their files
+void BIOS_FlushDiskImages();
+
 void updateDPT(void);
 void incrementFDD(void);
 
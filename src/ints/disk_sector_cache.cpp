@@ -0,0 +1,284 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "private/disk_sector_cache.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include "misc/cross.h"
+#include "misc/logging.h"
+#include "utils/checks.h"
+
+CHECK_NARROWING();
+
+DiskSectorCache::DiskSectorCache(FILE* image_file, const uint32_t _sector_size,
+                                 const size_t cache_size_bytes)
+        : file(image_file),
+          sector_size(_sector_size),
+          block_size(static_cast<size_t>(_sector_size) * SectorsPerBlock)
+{
+	assert(file);
+	assert(sector_size > 0);
+
+	// Leave room for a full read-ahead without evicting the blocks it
+	// has just read
+	max_blocks = std::max(cache_size_bytes / block_size,
+	                      static_cast<size_t>(MaxReadAheadBlocks * 2));
+
+	blocks.reserve(max_blocks);
+}
+
+DiskSectorCache::~DiskSectorCache()
+{
+	Flush();
+}
+
+float DiskSectorCache::GetHitRatePercent() const
+{
+	if (stats.sector_reads == 0) {
+		return 0.0f;
+	}
+	return static_cast<float>(stats.sector_read_hits * 100) /
+	       static_cast<float>(stats.sector_reads);
+}
+
+DiskSectorCache::Block* DiskSectorCache::FindBlock(const uint32_t index)
+{
+	const auto it = blocks.find(index);
+	if (it == blocks.end()) {
+		return nullptr;
+	}
+
+	// Move to the front of the LRU list
+	lru.splice(lru.begin(), lru, it->second);
+	return &*it->second;
+}
+
+DiskSectorCache::Block& DiskSectorCache::InsertBlock(const uint32_t index)
+{
+	assert(!blocks.contains(index));
+
+	if (blocks.size() >= max_blocks) {
+		auto& victim = lru.back();
+		if (victim.dirty_mask != 0) {
+			WriteBackFrom(victim.index);
+		}
+		blocks.erase(victim.index);
+
+		// Recycle the victim's buffer
+		victim.index      = index;
+		victim.valid_mask = 0;
+		victim.dirty_mask = 0;
+		lru.splice(lru.begin(), lru, std::prev(lru.end()));
+	} else {
+		lru.push_front(Block{index, 0, 0, std::vector<uint8_t>(block_size)});
+	}
+
+	blocks.emplace(index, lru.begin());
+	return lru.front();
+}
+
+bool DiskSectorCache::FillBlocks(const uint32_t first_index, const uint32_t num_blocks)
+{
+	const auto num_bytes = block_size * num_blocks;
+	if (io_buffer.size() < num_bytes) {
+		io_buffer.resize(num_bytes);
+	}
+
+	const auto offset = static_cast<cross_off_t>(first_index) *
+	                    static_cast<cross_off_t>(block_size);
+
+	if (cross_fseeko(file, offset, SEEK_SET) != 0) {
+		return false;
+	}
+
+	const auto bytes_read = fread(io_buffer.data(), 1, num_bytes, file);
+	++stats.file_reads;
+
+	// Sectors past the end of the image read as zeros
+	std::fill(io_buffer.begin() + static_cast<ptrdiff_t>(bytes_read),
+	          io_buffer.begin() + static_cast<ptrdiff_t>(num_bytes),
+	          uint8_t{0});
+
+	for (uint32_t i = 0; i < num_blocks; ++i) {
+		const auto index = first_index + i;
+
+		auto block = FindBlock(index);
+		if (!block) {
+			block = &InsertBlock(index);
+		}
+
+		const auto src = io_buffer.data() + block_size * i;
+
+		// Don't overwrite sectors that are already cached, as they may
+		// have been modified
+		for (uint32_t s = 0; s < SectorsPerBlock; ++s) {
+			const auto bit = static_cast<uint8_t>(1 << s);
+			if ((block->valid_mask & bit) == 0) {
+				std::memcpy(block->data.data() + s * sector_size,
+				            src + s * sector_size,
+				            sector_size);
+			}
+		}
+		block->valid_mask = 0xff;
+	}
+	return true;
+}
+
+bool DiskSectorCache::ReadSector(const uint32_t sectnum, void* data)
+{
+	assert(data);
+	++stats.sector_reads;
+
+	const auto index  = sectnum / SectorsPerBlock;
+	const auto sector = sectnum % SectorsPerBlock;
+	const auto bit    = static_cast<uint8_t>(1 << sector);
+
+	auto block = FindBlock(index);
+
+	if (block && (block->valid_mask & bit)) {
+		++stats.sector_read_hits;
+	} else {
+		// Grow the read-ahead while the misses are sequential
+		if (index == read_ahead_end) {
+			read_ahead_blocks = std::min(read_ahead_blocks * 2,
+			                             MaxReadAheadBlocks);
+		} else {
+			read_ahead_blocks = 1;
+		}
+
+		if (!FillBlocks(index, read_ahead_blocks)) {
+			return false;
+		}
+		stats.sectors_read_ahead += (read_ahead_blocks - 1) * SectorsPerBlock;
+		read_ahead_end = index + read_ahead_blocks;
+
+		// The block is at the front of the LRU list after the fill
+		block = FindBlock(index);
+		assert(block);
+	}
+
+	std::memcpy(data, block->data.data() + sector * sector_size, sector_size);
+	return true;
+}
+
+bool DiskSectorCache::WriteSector(const uint32_t sectnum, const void* data)
+{
+	assert(data);
+	++stats.sector_writes;
+
+	const auto index  = sectnum / SectorsPerBlock;
+	const auto sector = sectnum % SectorsPerBlock;
+	const auto bit    = static_cast<uint8_t>(1 << sector);
+
+	auto block = FindBlock(index);
+	if (!block) {
+		block = &InsertBlock(index);
+	}
+
+	std::memcpy(block->data.data() + sector * sector_size, data, sector_size);
+
+	block->valid_mask |= bit;
+	block->dirty_mask |= bit;
+
+	return !std::exchange(has_write_error, false);
+}
+
+bool DiskSectorCache::WriteRun(const uint32_t first_sector, const size_t num_bytes)
+{
+	const auto offset = static_cast<cross_off_t>(first_sector) *
+	                    static_cast<cross_off_t>(sector_size);
+
+	++stats.file_writes;
+
+	if (cross_fseeko(file, offset, SEEK_SET) != 0 ||
+	    fwrite(write_buffer.data(), 1, num_bytes, file) != num_bytes) {
+		LOG_ERR("BIOSDISK: Could not write back %zu bytes at sector %u: %s",
+		        num_bytes,
+		        first_sector,
+		        strerror(errno));
+		has_write_error = true;
+		return false;
+	}
+	return true;
+}
+
+// Writes back the modified sectors of the block and of the directly
+// following modified blocks, merging consecutive sectors into single writes
+bool DiskSectorCache::WriteBackFrom(const uint32_t first_index)
+{
+	auto ok = true;
+
+	uint32_t run_start = 0;
+	size_t run_bytes   = 0;
+
+	auto write_run = [&] {
+		if (run_bytes > 0) {
+			ok &= WriteRun(run_start, run_bytes);
+			run_bytes = 0;
+		}
+	};
+
+	for (auto index = first_index;; ++index) {
+		const auto it = blocks.find(index);
+		if (it == blocks.end() || it->second->dirty_mask == 0) {
+			break;
+		}
+		auto& block = *it->second;
+
+		for (uint32_t s = 0; s < SectorsPerBlock; ++s) {
+			const auto bit = static_cast<uint8_t>(1 << s);
+			if ((block.dirty_mask & bit) == 0) {
+				write_run();
+				continue;
+			}
+			if (run_bytes == 0) {
+				run_start = index * SectorsPerBlock + s;
+			}
+			if (write_buffer.size() < run_bytes + sector_size) {
+				write_buffer.resize(run_bytes + sector_size);
+			}
+			std::memcpy(write_buffer.data() + run_bytes,
+			            block.data.data() + s * sector_size,
+			            sector_size);
+			run_bytes += sector_size;
+		}
+		block.dirty_mask = 0;
+	}
+	write_run();
+
+	return ok;
+}
+
+bool DiskSectorCache::Flush()
+{
+	std::vector<uint32_t> dirty_indices = {};
+	for (const auto& block : lru) {
+		if (block.dirty_mask != 0) {
+			dirty_indices.push_back(block.index);
+		}
+	}
+	// Report write-back failures of evicted blocks as well
+	auto ok = !std::exchange(has_write_error, false);
+
+	if (dirty_indices.empty()) {
+		return ok;
+	}
+
+	std::sort(dirty_indices.begin(), dirty_indices.end());
+
+	for (const auto index : dirty_indices) {
+		// Already written as part of an earlier run
+		if (blocks.at(index)->dirty_mask == 0) {
+			continue;
+		}
+		ok &= WriteBackFrom(index);
+	}
+	has_write_error = false;
+
+	return (fflush(file) == 0) && ok;
+}
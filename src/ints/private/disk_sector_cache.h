@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef DOSBOX_DISK_SECTOR_CACHE_H
+#define DOSBOX_DISK_SECTOR_CACHE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+// Write-back LRU cache of the sectors of a disk image file.
+//
+// The sectors are cached in blocks of consecutive sectors, which is the most
+// common cluster size of FAT hard disk images. Reads that miss the cache
+// load whole blocks; when the misses are sequential, the number of blocks
+// read ahead with a single file read doubles up to `MaxReadAheadBlocks`.
+//
+// Writes only go to the cache. The modified sectors are written back to the
+// file when their block gets evicted, when `Flush()` is called, and when the
+// cache is destroyed; consecutive modified sectors, including ones in
+// neighbouring blocks, are written with a single file write.
+class DiskSectorCache {
+public:
+	static constexpr uint32_t SectorsPerBlock    = 8;
+	static constexpr uint32_t MaxReadAheadBlocks = 16;
+
+	struct Stats {
+		uint64_t sector_reads       = 0;
+		uint64_t sector_read_hits   = 0;
+		uint64_t sectors_read_ahead = 0;
+		uint64_t sector_writes      = 0;
+		uint64_t file_reads         = 0;
+		uint64_t file_writes        = 0;
+	};
+
+	// The file isn't owned by the cache and has to outlive it
+	DiskSectorCache(FILE* image_file, uint32_t sector_size, size_t cache_size_bytes);
+	~DiskSectorCache();
+
+	DiskSectorCache(const DiskSectorCache&)            = delete;
+	DiskSectorCache& operator=(const DiskSectorCache&) = delete;
+
+	// Returns false if the sector could not be read from the file. Sectors
+	// past the end of the file read as zeros.
+	bool ReadSector(uint32_t sectnum, void* data);
+
+	// Returns false if writing modified sectors back to the file has failed
+	// since the last write or flush, which happens when their blocks get
+	// evicted to make room
+	bool WriteSector(uint32_t sectnum, const void* data);
+
+	// Writes all modified sectors back to the file; returns false if any
+	// of the file writes failed
+	bool Flush();
+
+	const Stats& GetStats() const
+	{
+		return stats;
+	}
+
+	float GetHitRatePercent() const;
+
+private:
+	struct Block {
+		uint32_t index      = 0;
+		uint8_t valid_mask  = 0;
+		uint8_t dirty_mask  = 0;
+		std::vector<uint8_t> data = {};
+	};
+
+	using LruList = std::list<Block>;
+
+	Block* FindBlock(uint32_t index);
+	Block& InsertBlock(uint32_t index);
+	bool FillBlocks(uint32_t first_index, uint32_t num_blocks);
+	bool WriteBackFrom(uint32_t first_index);
+	bool WriteRun(uint32_t first_sector, size_t num_bytes);
+
+	FILE* file            = nullptr;
+	uint32_t sector_size  = 0;
+	size_t block_size     = 0;
+	size_t max_blocks     = 0;
+
+	// Most recently used blocks at the front
+	LruList lru = {};
+	std::unordered_map<uint32_t, LruList::iterator> blocks = {};
+
+	// The block after the last range read from the file, and the number of
+	// blocks to read ahead if the next miss is for that block
+	uint32_t read_ahead_end    = 0;
+	uint32_t read_ahead_blocks = 1;
+
+	// Set when writing back modified sectors fails, until reported by the
+	// next write or flush
+	bool has_write_error = false;
+
+	// Separate buffers, as filling blocks can evict modified ones
+	std::vector<uint8_t> io_buffer    = {};
+	std::vector<uint8_t> write_buffer = {};
+
+	Stats stats = {};
+};
+
+#endif // DOSBOX_DISK_SECTOR_CACHE_H
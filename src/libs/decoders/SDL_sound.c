@@ -440,8 +440,9 @@ static int init_sample(const Sound_DecoderFunctions *funcs,
 } /* init_sample */
 
 
-Sound_Sample *Sound_NewSample(SDL_IOStream *rw, const char *ext,
-                              Sound_AudioInfo *desired)
+static Sound_Sample *new_sample(SDL_IOStream *rw, const char *ext,
+                                Sound_AudioInfo *desired,
+                                const char *filename)
 {
     Sound_Sample *retval;
     decoder_element *decoder;
@@ -454,6 +455,9 @@ Sound_Sample *Sound_NewSample(SDL_IOStream *rw, const char *ext,
     if (!retval)
         return(NULL);  /* alloc_sample() sets error message... */
 
+        /* let the decoders find files that belong to the sound file. */
+    ((Sound_SampleInternal *) retval->opaque)->filename = filename;
+
     if (ext != NULL)
     {
         for (decoder = &decoders[0]; decoder->funcs != NULL; decoder++)
@@ -466,7 +470,7 @@ Sound_Sample *Sound_NewSample(SDL_IOStream *rw, const char *ext,
                     if (__Sound_strcasecmp(*decoderExt, ext) == 0)
                     {
                         if (init_sample(decoder->funcs, retval, ext, desired))
-                            return(retval);
+                            goto opened;
                         break;  /* done with this decoder either way. */
                     } /* if */
                     decoderExt++;
@@ -497,7 +501,7 @@ Sound_Sample *Sound_NewSample(SDL_IOStream *rw, const char *ext,
             if (should_try)
             {
                 if (init_sample(decoder->funcs, retval, ext, desired))
-                    return(retval);
+                    goto opened;
             } /* if */
         } /* if */
     } /* for */
@@ -508,6 +512,18 @@ Sound_Sample *Sound_NewSample(SDL_IOStream *rw, const char *ext,
     SDL_CloseIO(rw);
     __Sound_SetError(ERR_UNSUPPORTED_FORMAT);
     return(NULL);
+
+opened:
+        /* the filename isn't owned by the sample. */
+    ((Sound_SampleInternal *) retval->opaque)->filename = NULL;
+    return(retval);
+} /* new_sample */
+
+
+Sound_Sample *Sound_NewSample(SDL_IOStream *rw, const char *ext,
+                              Sound_AudioInfo *desired)
+{
+    return(new_sample(rw, ext, desired, NULL));
 } /* Sound_NewSample */
 
 
@@ -532,7 +548,7 @@ Sound_Sample *Sound_NewSampleFromFile(const char *filename,
     if (ext != NULL)
         ext++;
 
-    return(Sound_NewSample(rw, ext, desired));
+    return(new_sample(rw, ext, desired, filename));
 } /* Sound_NewSampleFromFile */
 
 void Sound_FreeSample(Sound_Sample *sample)
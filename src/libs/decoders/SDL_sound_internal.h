@@ -214,6 +214,7 @@ typedef struct __SOUND_SAMPLEINTERNAL__
     Sint32 total_time;
     Uint32 mix_position;
     MixFunc mix;
+    const char *filename;  /* only set while the decoder opens a file */
 } Sound_SampleInternal;
 
 
@@ -4,7 +4,12 @@
 
 #include "mp3_seek_table.h"
 
+#include <atomic>
+#include <fstream>
+#include <system_error>
+
 // Local headers
+#include "misc/std_filesystem.h"
 #include "utils/math_utils.h"
 
 // How many compressed MP3 frames should we skip between each recorded
@@ -13,8 +18,7 @@
 //   - a smaller numbers (below 10) results in fast seeks on slow hardware.
 constexpr uint32_t FRAMES_PER_SEEK_POINT = 7;
 
-// This function generates a new seek-table for a given mp3 stream and writes
-// the data to the fast-seek file.
+// This function generates a new seek-table for a given mp3 stream.
 //
 static uint64_t generate_new_seek_points(drmp3* const p_dr,
                                          std::vector<drmp3_seek_point>& seek_points_vector) {
@@ -65,15 +69,169 @@ static uint64_t generate_new_seek_points(drmp3* const p_dr,
     return pcm_frame_count;
 }
 
-uint64_t populate_seek_points(mp3_t* p_mp3, bool &result)
+// Generating the seek points requires scanning the whole stream, which can
+// take a while for long tracks, so they can be stored in a seek table file
+// next to the MP3 file (for example, "track02.mp3.seek") and reused the next
+// time the file is opened. Existing seek table files are always used, but
+// writing them is opt-in, as the MP3 files are usually in the user's game
+// directories.
+//
+// The seek table file holds a header followed by the seek points, in the
+// host's byte order. It's regenerated if the MP3 file's size or modification
+// time changed, or if it was written by a host with a different byte order
+// or with a different number of frames per seek point.
+constexpr char SEEK_TABLE_EXTENSION[] = ".seek";
+constexpr char SEEK_TABLE_MAGIC[8]    = {'D', 'B', 'M', 'P', '3', 'S', 'K', '1'};
+constexpr uint32_t BYTE_ORDER_MARK    = 0x01020304;
+
+static std::atomic<bool> is_saving_enabled = false;
+
+void set_seek_table_saving(const bool enabled)
+{
+    is_saving_enabled = enabled;
+}
+
+struct seek_table_header_t {
+    char magic[8]               = {};
+    uint32_t byte_order_mark    = 0;
+    uint32_t frames_per_point   = 0;
+    uint64_t mp3_file_size      = 0;
+    int64_t mp3_file_time       = 0;
+    uint64_t pcm_frame_count    = 0;
+    uint64_t num_seek_points    = 0;
+};
+
+static bool get_mp3_file_info(const std_fs::path& mp3_path,
+                              seek_table_header_t& header)
+{
+    std::error_code ec = {};
+    const auto file_size = std_fs::file_size(mp3_path, ec);
+    if (ec) {
+        return false;
+    }
+    const auto file_time = std_fs::last_write_time(mp3_path, ec);
+    if (ec) {
+        return false;
+    }
+    std::copy(std::begin(SEEK_TABLE_MAGIC), std::end(SEEK_TABLE_MAGIC), header.magic);
+    header.byte_order_mark  = BYTE_ORDER_MARK;
+    header.frames_per_point = FRAMES_PER_SEEK_POINT;
+    header.mp3_file_size    = file_size;
+    header.mp3_file_time    = static_cast<int64_t>(file_time.time_since_epoch().count());
+    return true;
+}
+
+// Returns the number of PCM frames, or 0 if the seek table file is missing,
+// out of date, or invalid.
+static uint64_t load_seek_points(const std_fs::path& table_path,
+                                 const seek_table_header_t& expected,
+                                 std::vector<drmp3_seek_point>& seek_points_vector)
+{
+    std::ifstream table_file(table_path, std::ios::binary);
+    if (!table_file) {
+        return 0;
+    }
+
+    seek_table_header_t header = {};
+    if (!table_file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return 0;
+    }
+    if (!std::equal(std::begin(header.magic), std::end(header.magic),
+                    std::begin(expected.magic))
+        || header.byte_order_mark != expected.byte_order_mark
+        || header.frames_per_point != expected.frames_per_point
+        || header.mp3_file_size != expected.mp3_file_size
+        || header.mp3_file_time != expected.mp3_file_time
+        || header.pcm_frame_count == 0
+        || header.num_seek_points == 0) {
+        return 0;
+    }
+
+    // The seek points have to fit in the seek table file
+    std::error_code ec = {};
+    const auto table_file_size = std_fs::file_size(table_path, ec);
+    if (ec || header.num_seek_points
+                      > (table_file_size - sizeof(header)) / sizeof(drmp3_seek_point)) {
+        return 0;
+    }
+
+    seek_points_vector.resize(static_cast<size_t>(header.num_seek_points));
+    const auto num_bytes = static_cast<std::streamsize>(
+        seek_points_vector.size() * sizeof(drmp3_seek_point));
+    if (!table_file.read(reinterpret_cast<char*>(seek_points_vector.data()), num_bytes)) {
+        seek_points_vector.clear();
+        return 0;
+    }
+
+    // The seek points have to be in order and inside the stream
+    uint64_t prev_pcm_frame = 0;
+    for (const auto& point : seek_points_vector) {
+        if (point.seekPosInBytes >= header.mp3_file_size
+            || point.pcmFrameIndex < prev_pcm_frame
+            || point.pcmFrameIndex > header.pcm_frame_count) {
+            seek_points_vector.clear();
+            return 0;
+        }
+        prev_pcm_frame = point.pcmFrameIndex;
+    }
+    return header.pcm_frame_count;
+}
+
+// Writing the seek table file is best effort, as the MP3 file might be on
+// read-only media; the failure isn't reported, as the seek points only have
+// to be generated again next time.
+static void save_seek_points(const std_fs::path& table_path,
+                             const seek_table_header_t& header,
+                             const std::vector<drmp3_seek_point>& seek_points_vector)
+{
+    std::ofstream table_file(table_path, std::ios::binary | std::ios::trunc);
+    if (!table_file) {
+        return;
+    }
+    table_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    table_file.write(reinterpret_cast<const char*>(seek_points_vector.data()),
+                     static_cast<std::streamsize>(seek_points_vector.size()
+                                                  * sizeof(drmp3_seek_point)));
+    table_file.close();
+
+    // Don't leave a truncated seek table file behind
+    if (table_file.fail()) {
+        std::error_code ec = {};
+        std_fs::remove(table_path, ec);
+    }
+}
+
+uint64_t populate_seek_points(mp3_t* p_mp3, const char* filename, bool &result)
 {
     // assume failure until proven otherwise
     result = false;
 
-    const auto pcm_frame_count = generate_new_seek_points(p_mp3->p_dr,
-                                                          p_mp3->seek_points_vector);
+    seek_table_header_t header = {};
+    std_fs::path table_path    = {};
+
+    const bool has_file_info = filename
+        && get_mp3_file_info(std_fs::path(filename), header);
+    if (has_file_info) {
+        table_path = std_fs::path(filename);
+        table_path += SEEK_TABLE_EXTENSION;
+    }
+
+    uint64_t pcm_frame_count = 0;
+    if (has_file_info) {
+        pcm_frame_count = load_seek_points(table_path, header,
+                                           p_mp3->seek_points_vector);
+    }
     if (pcm_frame_count == 0) {
-        return 0;
+        pcm_frame_count = generate_new_seek_points(p_mp3->p_dr,
+                                                   p_mp3->seek_points_vector);
+        if (pcm_frame_count == 0) {
+            return 0;
+        }
+        if (has_file_info && is_saving_enabled) {
+            header.pcm_frame_count = pcm_frame_count;
+            header.num_seek_points = p_mp3->seek_points_vector.size();
+            save_seek_points(table_path, header, p_mp3->seek_points_vector);
+        }
     }
 
     // We bind our seek points to the dr_mp3 object which will be used for fast seeking.
@@ -33,6 +33,14 @@ struct mp3_t {
     std::vector<drmp3_seek_point> seek_points_vector = {};
 };
 
-uint64_t populate_seek_points(mp3_t* p_mp3, bool &result);
+// Populates the seek points from the seek table file next to the MP3 file
+// if it's up to date, otherwise generates them by scanning the stream and,
+// if enabled, writes them to the seek table file. The filename can be
+// nullptr for streams that aren't files, which skips the seek table file.
+uint64_t populate_seek_points(mp3_t* p_mp3, const char* filename, bool &result);
+
+// Enables writing the generated seek points to seek table files (disabled by
+// default)
+void set_seek_table_saving(bool enabled);
 
 #endif
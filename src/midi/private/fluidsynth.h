@@ -17,6 +17,7 @@
 #include "dos/programs/more_output.h"
 #include "misc/std_filesystem.h"
 #include "utils/rwqueue.h"
+#include "utils/spsc_queue.h"
 
 struct ChorusParameters {
 	int voice_count = {};
@@ -136,7 +137,7 @@ private:
 	FluidSynthPtr synth{nullptr, &delete_fluid_synth};
 
 	MixerChannelPtr mixer_channel = nullptr;
-	RWQueue<AudioFrame> audio_frame_fifo{1};
+	SpscQueue<AudioFrame> audio_frame_fifo{1};
 	RWQueue<MidiWork> work_fifo{1};
 	std::thread renderer = {};
 
@@ -24,6 +24,7 @@
 #include "midi/midi.h"
 #include "misc/std_filesystem.h"
 #include "utils/rwqueue.h"
+#include "utils/spsc_queue.h"
 
 // forward declaration
 class LASynthModel;
@@ -73,7 +74,7 @@ private:
 
 	// Managed objects
 	MixerChannelPtr channel = nullptr;
-	RWQueue<AudioFrame> audio_frame_fifo{1};
+	SpscQueue<AudioFrame> audio_frame_fifo{1};
 	RWQueue<MidiWork> work_fifo{1};
 
 	std::mutex service_mutex                  = {};
@@ -16,6 +16,7 @@
 #include "audio/mixer.h"
 #include "dos/programs/more_output.h"
 #include "utils/rwqueue.h"
+#include "utils/spsc_queue.h"
 
 namespace SoundCanvas {
 
@@ -92,7 +93,7 @@ private:
 
 	// Managed objects
 	MixerChannelPtr mixer_channel        = nullptr;
-	RWQueue<AudioFrame> audio_frame_fifo = {1};
+	SpscQueue<AudioFrame> audio_frame_fifo = {1};
 	RWQueue<MidiWork> work_fifo          = {1};
 
 	struct {
@@ -8,7 +8,7 @@
 #include <mutex>
 
 #include "audio/audio_frame.h"
-#include "utils/rwqueue.h"
+#include "utils/spsc_queue.h"
 
 // Parks an internal MIDI synth's renderer thread (FluidSynth, MT-32,
 // SoundCanvas) at a DOSBox pause edge so the synth's internal clock stops
@@ -57,7 +57,7 @@ public:
 	// On shutdown the synth destructors call `Resume()` after stopping
 	// their work fifo (the stopped fifo is what makes the render loop
 	// itself exit), so a parked renderer never hangs teardown.
-	bool ParkIfPaused(RWQueue<AudioFrame>& audio_frame_fifo)
+	bool ParkIfPaused(SpscQueue<AudioFrame>& audio_frame_fifo)
 	{
 		std::unique_lock lock(mutex);
 
@@ -634,9 +634,13 @@ void MidiDeviceSoundCanvas::RenderAudioFramesToFifo(const int num_audio_frames)
 	clap.plugin->Process(audio_out, num_audio_frames, clap.event_list);
 	clap.event_list.Clear();
 
+	static std::vector<AudioFrame> audio_frames = {};
+
+	audio_frames.clear();
 	for (auto i = 0; i < num_audio_frames; ++i) {
-		audio_frame_fifo.Enqueue({left[i], right[i]});
+		audio_frames.emplace_back(left[i], right[i]);
 	}
+	audio_frame_fifo.BulkEnqueue(audio_frames);
 }
 
 // The next MIDI work task is processed, which includes rendering audio frames
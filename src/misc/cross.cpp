@@ -19,6 +19,7 @@
 #endif
 
 #ifdef WIN32
+#	include <io.h>
 #	include <winnls.h>
 
 #	ifndef _WIN32_IE
@@ -26,6 +27,7 @@
 #	endif
 #	include <shlobj.h>
 #else // other than Windows
+#	include <fcntl.h>
 #	if defined(HAVE_LIBGEN_H)
 #		include <libgen.h>
 #	endif
@@ -372,6 +374,31 @@ FILE *fopen_wrap_ro_fallback(const std::string &filename, bool &is_readonly)
 	return fp;
 }
 
+bool is_file_writable(FILE* file)
+{
+	assert(file);
+#if defined(WIN32)
+	// The access mode of the stream isn't exposed, but a handle can't be
+	// duplicated with more access rights than the original one has
+	const auto handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file)));
+	if (handle == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	const auto process = GetCurrentProcess();
+
+	HANDLE writable_handle = nullptr;
+	if (!DuplicateHandle(process, handle, process, &writable_handle,
+	                     FILE_WRITE_DATA, FALSE, 0)) {
+		return false;
+	}
+	CloseHandle(writable_handle);
+	return true;
+#else
+	const auto flags = fcntl(fileno(file), F_GETFL);
+	return flags >= 0 && (flags & O_ACCMODE) != O_RDONLY;
+#endif
+}
+
 bool wild_match(const char *haystack, const char *needle)
 {
 	assert(haystack);
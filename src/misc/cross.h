@@ -130,6 +130,9 @@ void close_directory(DirInformation* dirp);
 
 FILE *fopen_wrap_ro_fallback(const std::string &filename, bool &is_readonly);
 
+// Returns true if the file was opened for writing
+bool is_file_writable(FILE* file);
+
 bool wild_match(const char *haystack, const char *needle);
 bool wild_file_cmp(const char* file, const char* wild, bool long_compare = false);
 
@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "utils/dir_watcher.h"
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include "misc/logging.h"
+
+DirWatcher::DirWatcher(const int _fd) : fd(_fd) {}
+
+DirWatcher::~DirWatcher()
+{
+	// Closing the inotify instance removes all its watches
+	close(fd);
+}
+
+std::unique_ptr<DirWatcher> DirWatcher::Create()
+{
+	const auto fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (fd < 0) {
+		LOG_WARNING("FS: Failed to watch host directories for changes");
+		return {};
+	}
+	return std::unique_ptr<DirWatcher>(new DirWatcher(fd));
+}
+
+bool DirWatcher::Watch(const std::string& dir_path)
+{
+	constexpr uint32_t Mask = IN_CREATE | IN_DELETE | IN_MOVED_FROM |
+	                          IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF |
+	                          IN_ONLYDIR;
+
+	const auto wd = inotify_add_watch(fd, dir_path.c_str(), Mask);
+	if (wd < 0) {
+		// Most likely the host limit on the number of watches has been
+		// reached; the directory can still be re-scanned manually
+		LOG_DEBUG("FS: Failed to watch '%s' for changes", dir_path.c_str());
+		return false;
+	}
+
+	// Watching the same directory again returns its existing watch, which
+	// also updates the path if the directory has been moved since
+	auto& path = watched_dirs[wd];
+	path       = dir_path;
+	if (path.back() != '/') {
+		path += '/';
+	}
+	return true;
+}
+
+std::vector<DirWatcher::Change> DirWatcher::ReadChanges()
+{
+	std::vector<Change> changes = {};
+
+	alignas(inotify_event) char buffer[16 * 1024];
+
+	while (true) {
+		const auto num_bytes = read(fd, buffer, sizeof(buffer));
+		if (num_bytes <= 0) {
+			// Nothing more to read
+			break;
+		}
+
+		for (auto pos = buffer; pos < buffer + num_bytes;) {
+			const auto event = reinterpret_cast<const inotify_event*>(pos);
+			pos += sizeof(inotify_event) + event->len;
+
+			if (event->mask & IN_Q_OVERFLOW) {
+				changes.push_back({ChangeType::Overflow});
+				continue;
+			}
+
+			// The directory itself is gone; changes to its contents
+			// are reported by the watch of its parent directory, if
+			// there is one
+			if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+				if (watched_dirs.erase(event->wd)) {
+					inotify_rm_watch(fd, event->wd);
+				}
+				continue;
+			}
+
+			const auto dir = watched_dirs.find(event->wd);
+			if (dir == watched_dirs.end() || event->len == 0) {
+				continue;
+			}
+
+			const auto is_added = (event->mask & (IN_CREATE | IN_MOVED_TO));
+
+			changes.push_back({is_added ? ChangeType::Added : ChangeType::Removed,
+			                   dir->second + event->name,
+			                   (event->mask & IN_ISDIR) != 0});
+		}
+	}
+	return changes;
+}
@@ -0,0 +1,26 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "utils/dir_watcher.h"
+
+// Watching host directories for changes is only implemented on Linux;
+// elsewhere, the directory caches are re-read with RESCAN
+
+DirWatcher::DirWatcher(const int _fd) : fd(_fd) {}
+
+DirWatcher::~DirWatcher() = default;
+
+std::unique_ptr<DirWatcher> DirWatcher::Create()
+{
+	return {};
+}
+
+bool DirWatcher::Watch(const std::string&)
+{
+	return false;
+}
+
+std::vector<DirWatcher::Change> DirWatcher::ReadChanges()
+{
+	return {};
+}
@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "utils/mapped_file.h"
+
+#include <cassert>
+#include <fcntl.h>
+#include <limits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(uint8_t* _data, const size_t _size, const bool _is_writable)
+        : data(_data),
+          size(_size),
+          is_writable(_is_writable)
+{}
+
+MappedFile::~MappedFile()
+{
+	munmap(data, size);
+}
+
+// Returns nullptr if the file can't be mapped
+static uint8_t* map_fd(const int fd, const bool writable, size_t& size)
+{
+	struct stat st = {};
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) {
+		return nullptr;
+	}
+	if (static_cast<uintmax_t>(st.st_size) > std::numeric_limits<size_t>::max()) {
+		return nullptr;
+	}
+	size = static_cast<size_t>(st.st_size);
+
+	const auto prot = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+
+	const auto addr = mmap(nullptr, size, prot, MAP_SHARED, fd, 0);
+	if (addr == MAP_FAILED) {
+		return nullptr;
+	}
+	return static_cast<uint8_t*>(addr);
+}
+
+std::unique_ptr<MappedFile> MappedFile::Map(const std_fs::path& path)
+{
+	const auto fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return {};
+	}
+
+	size_t size     = 0;
+	const auto data = map_fd(fd, false, size);
+
+	// The mapping keeps a reference to the file
+	close(fd);
+
+	if (!data) {
+		return {};
+	}
+	return std::unique_ptr<MappedFile>(new MappedFile(data, size, false));
+}
+
+std::unique_ptr<MappedFile> MappedFile::Map(FILE* file)
+{
+	assert(file);
+
+	// Make sure the file has everything written through the stream so far
+	if (fflush(file) != 0) {
+		return {};
+	}
+
+	const auto fd = fileno(file);
+	if (fd < 0) {
+		return {};
+	}
+	const auto flags = fcntl(fd, F_GETFL);
+	if (flags < 0) {
+		return {};
+	}
+	const auto writable = (flags & O_ACCMODE) == O_RDWR;
+
+	size_t size     = 0;
+	const auto data = map_fd(fd, writable, size);
+
+	if (!data) {
+		return {};
+	}
+	return std::unique_ptr<MappedFile>(new MappedFile(data, size, writable));
+}
+
+void MappedFile::Flush()
+{
+	if (is_writable) {
+		msync(data, size, MS_ASYNC);
+	}
+}
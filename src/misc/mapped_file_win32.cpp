@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "utils/mapped_file.h"
+
+#include <cassert>
+#include <io.h>
+#include <limits>
+#include <windows.h>
+
+MappedFile::MappedFile(uint8_t* _data, const size_t _size, const bool _is_writable)
+        : data(_data),
+          size(_size),
+          is_writable(_is_writable)
+{}
+
+MappedFile::~MappedFile()
+{
+	UnmapViewOfFile(data);
+}
+
+// Returns nullptr if the file can't be mapped
+static uint8_t* map_handle(const HANDLE handle, const bool writable, size_t& size)
+{
+	LARGE_INTEGER file_size = {};
+	if (!GetFileSizeEx(handle, &file_size) || file_size.QuadPart <= 0) {
+		return nullptr;
+	}
+	if (static_cast<uint64_t>(file_size.QuadPart) >
+	    std::numeric_limits<size_t>::max()) {
+		return nullptr;
+	}
+	size = static_cast<size_t>(file_size.QuadPart);
+
+	const auto mapping = CreateFileMappingW(handle,
+	                                        nullptr,
+	                                        writable ? PAGE_READWRITE
+	                                                 : PAGE_READONLY,
+	                                        0,
+	                                        0,
+	                                        nullptr);
+	if (!mapping) {
+		return nullptr;
+	}
+
+	const auto view = MapViewOfFile(mapping,
+	                                writable ? FILE_MAP_WRITE : FILE_MAP_READ,
+	                                0,
+	                                0,
+	                                0);
+
+	// The view keeps a reference to the mapping
+	CloseHandle(mapping);
+
+	return static_cast<uint8_t*>(view);
+}
+
+std::unique_ptr<MappedFile> MappedFile::Map(const std_fs::path& path)
+{
+	const auto handle = CreateFileW(path.c_str(),
+	                                GENERIC_READ,
+	                                FILE_SHARE_READ | FILE_SHARE_WRITE,
+	                                nullptr,
+	                                OPEN_EXISTING,
+	                                FILE_ATTRIBUTE_NORMAL,
+	                                nullptr);
+	if (handle == INVALID_HANDLE_VALUE) {
+		return {};
+	}
+
+	size_t size     = 0;
+	const auto data = map_handle(handle, false, size);
+
+	CloseHandle(handle);
+
+	if (!data) {
+		return {};
+	}
+	return std::unique_ptr<MappedFile>(new MappedFile(data, size, false));
+}
+
+std::unique_ptr<MappedFile> MappedFile::Map(FILE* file)
+{
+	assert(file);
+
+	// Make sure the file has everything written through the stream so far
+	if (fflush(file) != 0) {
+		return {};
+	}
+
+	const auto handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file)));
+	if (handle == INVALID_HANDLE_VALUE) {
+		return {};
+	}
+
+	// The access mode of the stream isn't exposed, so try a writable
+	// mapping first
+	size_t size = 0;
+	if (const auto data = map_handle(handle, true, size); data) {
+		return std::unique_ptr<MappedFile>(new MappedFile(data, size, true));
+	}
+	if (const auto data = map_handle(handle, false, size); data) {
+		return std::unique_ptr<MappedFile>(new MappedFile(data, size, false));
+	}
+	return {};
+}
+
+void MappedFile::Flush()
+{
+	if (is_writable) {
+		FlushViewOfFile(data, 0);
+	}
+}
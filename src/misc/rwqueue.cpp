@@ -324,6 +324,10 @@ template class RWQueue<MidiWork>;
 #include "gui/render/render.h"
 template class RWQueue<SaveImageTask>;
 
+// Video capture
+#include "capture/video/zmbv_encoder.h"
+template class RWQueue<ZmbvEncodeTask>;
+
 //PC Speaker
 template class RWQueue<float>;
 
@@ -0,0 +1,362 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "utils/spsc_queue.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+// Memory ordering
+// ~~~~~~~~~~~~~~~
+// The producer moves items into the ring before publishing the new write
+// index, and the consumer moves them out before publishing the new read index;
+// the (sequentially consistent) stores release these moves to the other side.
+//
+// The sleep/wake-up handshake is a Dekker-style pattern: the waiting side
+// raises its flag and then re-checks the other side's index, while the other
+// side publishes its index and then checks the flag. With sequentially
+// consistent operations at least one of them sees the other's write, so a
+// wake-up can't get lost. The signal counters are bumped before notifying, so
+// a wake-up arriving between the re-check and the wait makes the wait return
+// immediately.
+
+template <typename T>
+SpscQueue<T>::SpscQueue(size_t queue_capacity)
+{
+	Resize(queue_capacity);
+}
+
+template <typename T>
+void SpscQueue<T>::Resize(size_t queue_capacity)
+{
+	assert(queue_capacity > 0);
+
+	slots      = std::vector<T>(std::bit_ceil(queue_capacity));
+	index_mask = slots.size() - 1;
+
+	capacity = queue_capacity;
+
+	read_index  = 0;
+	write_index = 0;
+}
+
+template <typename T>
+size_t SpscQueue<T>::GetNumQueued() const
+{
+	// Loading the read index first guarantees the write index is never
+	// behind it
+	const auto r = read_index.load();
+	const auto w = write_index.load();
+	return std::min(w - r, capacity.load(std::memory_order_relaxed));
+}
+
+template <typename T>
+size_t SpscQueue<T>::GetFreeCapacity() const
+{
+	return capacity.load(std::memory_order_relaxed) - GetNumQueued();
+}
+
+template <typename T>
+void SpscQueue<T>::WaitForRoom(const size_t num_items)
+{
+	while (is_running && GetFreeCapacity() < num_items) {
+		const auto signal = room_signal.load(std::memory_order_acquire);
+
+		producer_is_waiting = true;
+		if (is_running && GetFreeCapacity() < num_items) {
+			room_signal.wait(signal, std::memory_order_acquire);
+		}
+		producer_is_waiting.store(false, std::memory_order_relaxed);
+	}
+}
+
+template <typename T>
+void SpscQueue<T>::WaitForItems()
+{
+	while (is_running && GetNumQueued() == 0) {
+		const auto signal = items_signal.load(std::memory_order_acquire);
+
+		consumer_is_waiting = true;
+		if (is_running && GetNumQueued() == 0) {
+			items_signal.wait(signal, std::memory_order_acquire);
+		}
+		consumer_is_waiting.store(false, std::memory_order_relaxed);
+	}
+}
+
+template <typename T>
+void SpscQueue<T>::PublishWrite(const size_t new_write_index)
+{
+	write_index = new_write_index;
+
+	if (consumer_is_waiting) {
+		items_signal.fetch_add(1, std::memory_order_release);
+		items_signal.notify_one();
+	}
+}
+
+template <typename T>
+void SpscQueue<T>::PublishRead(const size_t new_read_index)
+{
+	read_index = new_read_index;
+
+	if (producer_is_waiting) {
+		room_signal.fetch_add(1, std::memory_order_release);
+		room_signal.notify_one();
+	}
+}
+
+template <typename T>
+size_t SpscQueue<T>::Size()
+{
+	return GetNumQueued();
+}
+
+template <typename T>
+void SpscQueue<T>::Start()
+{
+	is_running = true;
+}
+
+template <typename T>
+void SpscQueue<T>::Stop()
+{
+	if (!is_running.exchange(false)) {
+		return;
+	}
+
+	// Wake up both sides so they can see the queue has stopped
+	room_signal.fetch_add(1, std::memory_order_release);
+	room_signal.notify_all();
+
+	items_signal.fetch_add(1, std::memory_order_release);
+	items_signal.notify_all();
+}
+
+template <typename T>
+void SpscQueue<T>::Clear()
+{
+	const auto r = read_index.load(std::memory_order_relaxed);
+	const auto w = write_index.load();
+
+	// Release the items' resources now, like the RWQueue does
+	for (auto i = r; i != w; ++i) {
+		slots[i & index_mask] = T{};
+	}
+	PublishRead(w);
+}
+
+template <typename T>
+size_t SpscQueue<T>::MaxCapacity()
+{
+	return capacity;
+}
+
+template <typename T>
+float SpscQueue<T>::GetPercentFull()
+{
+	const auto cur_level = static_cast<float>(Size());
+	const auto max_level = static_cast<float>(MaxCapacity());
+	return (100.0f * cur_level) / max_level;
+}
+
+template <typename T>
+bool SpscQueue<T>::IsEmpty()
+{
+	return GetNumQueued() == 0;
+}
+
+template <typename T>
+bool SpscQueue<T>::IsFull()
+{
+	return GetFreeCapacity() == 0;
+}
+
+template <typename T>
+bool SpscQueue<T>::IsRunning()
+{
+	return is_running;
+}
+
+template <typename T>
+bool SpscQueue<T>::Enqueue(T&& item)
+{
+	WaitForRoom(1);
+
+	// If we stopped while enqueing, then anything that was enqueued prior
+	// to being stopped is safely in the queue.
+	if (!is_running) {
+		return false;
+	}
+
+	const auto w = write_index.load(std::memory_order_relaxed);
+	slots[w & index_mask] = std::move(item);
+
+	PublishWrite(w + 1);
+	return true;
+}
+
+template <typename T>
+bool SpscQueue<T>::NonblockingEnqueue(T&& item)
+{
+	if (!is_running || GetFreeCapacity() == 0) {
+		return false;
+	}
+
+	const auto w = write_index.load(std::memory_order_relaxed);
+	slots[w & index_mask] = std::move(item);
+
+	PublishWrite(w + 1);
+	return true;
+}
+
+template <typename T>
+size_t SpscQueue<T>::BulkEnqueue(std::vector<T>& from_source)
+{
+	return BulkEnqueue(from_source, from_source.size());
+}
+
+template <typename T>
+size_t SpscQueue<T>::BulkEnqueue(std::vector<T>& from_source,
+                                 const size_t num_requested)
+{
+	assert(num_requested >= 1);
+	assert(num_requested <= from_source.size());
+
+	auto source        = from_source.begin();
+	auto num_remaining = num_requested;
+
+	while (num_remaining > 0) {
+		WaitForRoom(1);
+
+		// If we stopped while bulk enqueing, then stop here. Anything
+		// that was enqueued prior to being stopped is safely in the
+		// queue.
+		if (!is_running) {
+			break;
+		}
+
+		const auto num_items = std::min(GetFreeCapacity(), num_remaining);
+
+		auto w = write_index.load(std::memory_order_relaxed);
+		for (size_t i = 0; i < num_items; ++i) {
+			slots[w++ & index_mask] = std::move(*source++);
+		}
+		PublishWrite(w);
+
+		num_remaining -= num_items;
+	}
+	from_source.clear();
+
+	return num_requested - num_remaining;
+}
+
+template <typename T>
+size_t SpscQueue<T>::NonblockingBulkEnqueue(std::vector<T>& from_source)
+{
+	return NonblockingBulkEnqueue(from_source, from_source.size());
+}
+
+template <typename T>
+size_t SpscQueue<T>::NonblockingBulkEnqueue(std::vector<T>& from_source,
+                                            const size_t num_requested)
+{
+	assert(num_requested > 0);
+	assert(num_requested <= from_source.size());
+
+	const auto free_capacity = GetFreeCapacity();
+	if (!is_running || free_capacity == 0) {
+		return 0;
+	}
+
+	const auto num_items = std::min(free_capacity, num_requested);
+
+	const auto source_start = from_source.begin();
+	const auto source_end = source_start + static_cast<difference_t>(num_items);
+
+	auto w = write_index.load(std::memory_order_relaxed);
+	for (auto it = source_start; it != source_end; ++it) {
+		slots[w++ & index_mask] = std::move(*it);
+	}
+	PublishWrite(w);
+
+	from_source.erase(source_start, source_end);
+	return num_items;
+}
+
+template <typename T>
+std::optional<T> SpscQueue<T>::Dequeue()
+{
+	WaitForItems();
+
+	// Even if the queue has stopped, we need to drain the (previously)
+	// queued items before we're done.
+	if (GetNumQueued() == 0) {
+		return {};
+	}
+
+	const auto r = read_index.load(std::memory_order_relaxed);
+	auto item    = std::optional<T>(std::move(slots[r & index_mask]));
+
+	PublishRead(r + 1);
+	return item;
+}
+
+template <typename T>
+size_t SpscQueue<T>::BulkDequeue(std::vector<T>& into_target,
+                                 const size_t num_requested)
+{
+	if (into_target.size() < num_requested) {
+		into_target.resize(num_requested);
+	}
+
+	const auto num_dequeued = BulkDequeue(into_target.data(), num_requested);
+
+	// cap off the target vector to match the dequeued quantity
+	into_target.resize(num_dequeued);
+
+	return num_dequeued;
+}
+
+template <typename T>
+size_t SpscQueue<T>::BulkDequeue(T* const into_target, const size_t num_requested)
+{
+	assert(into_target);
+
+	auto target       = into_target;
+	size_t num_dequeued = 0;
+
+	while (num_dequeued < num_requested) {
+		WaitForItems();
+
+		// Even if the queue has stopped, we need to drain the
+		// (previously) queued items before we're done.
+		const auto num_queued = GetNumQueued();
+		if (num_queued == 0) {
+			break;
+		}
+
+		const auto num_items = std::min(num_queued,
+		                                num_requested - num_dequeued);
+
+		auto r = read_index.load(std::memory_order_relaxed);
+		for (size_t i = 0; i < num_items; ++i) {
+			*target++ = std::move(slots[r++ & index_mask]);
+		}
+		PublishRead(r);
+
+		num_dequeued += num_items;
+	}
+	return num_dequeued;
+}
+
+// Explicit template instantiations
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Unit tests
+template class SpscQueue<int>;
+template class SpscQueue<std::vector<int16_t>>;
+
+// Mixer output, FluidSynth, MT-32, Sound Canvas
+#include "audio/audio_frame.h"
+template class SpscQueue<AudioFrame>;
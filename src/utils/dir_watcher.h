@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef DOSBOX_DIR_WATCHER_H
+#define DOSBOX_DIR_WATCHER_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Reports entries being added to or removed from host directories, so
+// caches of the directory contents can be updated without re-reading them.
+// Renaming an entry is reported as the removal of the old name and the
+// addition of the new one.
+//
+// Only the directories passed to `Watch()` are watched, not their
+// subdirectories. The changes are collected by the host OS and returned by
+// `ReadChanges()`, which never blocks.
+//
+// Watching is only supported on Linux; `Create()` returns nullptr on other
+// hosts, or if the host is out of resources for watching.
+class DirWatcher {
+public:
+	enum class ChangeType {
+		Added,
+		Removed,
+
+		// Changes were lost because the host couldn't keep up; the
+		// watched directories have to be re-read
+		Overflow,
+	};
+
+	struct Change {
+		ChangeType type = ChangeType::Added;
+
+		// Host path of the added or removed entry
+		std::string path  = {};
+		bool is_directory = false;
+	};
+
+	static std::unique_ptr<DirWatcher> Create();
+
+	~DirWatcher();
+
+	DirWatcher(const DirWatcher&)            = delete;
+	DirWatcher& operator=(const DirWatcher&) = delete;
+
+	// Starts watching a directory; watching it again is a no-op
+	bool Watch(const std::string& dir_path);
+
+	std::vector<Change> ReadChanges();
+
+private:
+	DirWatcher(int fd);
+
+	int fd = -1;
+
+	// Host paths of the watched directories, ending with a separator
+	std::unordered_map<int, std::string> watched_dirs = {};
+};
+
+#endif // DOSBOX_DIR_WATCHER_H
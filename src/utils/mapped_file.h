@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef DOSBOX_MAPPED_FILE_H
+#define DOSBOX_MAPPED_FILE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <span>
+
+#include "misc/std_filesystem.h"
+
+// Memory mapping of a whole file, so reading from or writing to it becomes a
+// memcpy to or from the mapping.
+//
+// Writable mappings are shared with the file (write-through): the host OS
+// writes the modified pages back to the file in the background, and other
+// readers of the file see the changes immediately.
+//
+// Mapping fails, and `Map()` returns nullptr, if the file is empty or too
+// large for the address space, or if the file system doesn't support it;
+// callers should fall back to regular file I/O in that case.
+class MappedFile {
+public:
+	// Maps the file read-only
+	static std::unique_ptr<MappedFile> Map(const std_fs::path& path);
+
+	// Maps an open file; the mapping is writable if the file was opened
+	// for writing. The mapping stays valid after the file is closed.
+	static std::unique_ptr<MappedFile> Map(FILE* file);
+
+	~MappedFile();
+
+	MappedFile(const MappedFile&)            = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	std::span<const uint8_t> GetData() const
+	{
+		return {data, size};
+	}
+
+	// Only valid for writable mappings
+	std::span<uint8_t> GetWritableData()
+	{
+		return {is_writable ? data : nullptr, is_writable ? size : 0};
+	}
+
+	bool IsWritable() const
+	{
+		return is_writable;
+	}
+
+	size_t GetSize() const
+	{
+		return size;
+	}
+
+	// Starts writing the modified pages back to the file
+	void Flush();
+
+private:
+	MappedFile(uint8_t* data, size_t size, bool is_writable);
+
+	uint8_t* data    = nullptr;
+	size_t size      = 0;
+	bool is_writable = false;
+};
+
+#endif // DOSBOX_MAPPED_FILE_H
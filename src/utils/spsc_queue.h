@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef DOSBOX_SPSC_QUEUE_H
+#define DOSBOX_SPSC_QUEUE_H
+
+#include "dosbox.h"
+
+/*  SPSC (Single-Producer/Single-Consumer) Queue
+ *  --------------------------------------------
+ *  A fixed-size lock-free ring buffer with the same interface as the RWQueue,
+ *  for the audio paths where exactly one thread produces items and exactly
+ *  one other thread consumes them (e.g., a synth's render thread feeding the
+ *  mixer thread).
+ *
+ *  Enqueueing and dequeueing never take a lock: the producer owns the write
+ *  index and the consumer owns the read index, and each side publishes its
+ *  progress with a single atomic store. Items are moved in and out of the
+ *  ring in bulk without any memory allocation.
+ *
+ *  The blocking calls only put the thread to sleep when the queue is full
+ *  (producer) or empty (consumer), by waiting on an atomic futex-style. The
+ *  other side only issues the wake-up call if a thread is actually waiting,
+ *  so the fast path never enters the kernel.
+ *
+ *  Compared to the RWQueue, there are a few restrictions:
+ *
+ *  - Only one thread may enqueue and only one thread may dequeue at a time.
+ *    `Start()`, `Stop()`, and the non-blocking queries may be called from
+ *    any thread.
+ *
+ *  - `Resize()` discards the queued items and must not be called while the
+ *    producer or the consumer are active.
+ *
+ *  - `Clear()` may only be called by the consumer, or while neither side is
+ *    active.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+template <typename T>
+class SpscQueue {
+private:
+	// Keeps the indices owned by different threads on different cache
+	// lines, so the producer and consumer don't invalidate each other's
+	// cached copies on every update
+	static constexpr size_t CacheLineSize = 64;
+
+	// The storage is rounded up to a power of two so the ring position
+	// of an index can be computed with a mask
+	std::vector<T> slots = {};
+	size_t index_mask    = 0;
+
+	std::atomic<size_t> capacity = 0;
+	std::atomic<bool> is_running = true;
+
+	// Free-running counters; the ring position is the index masked.
+	// `write_index - read_index` is the number of queued items.
+	alignas(CacheLineSize) std::atomic<size_t> write_index = 0;
+	std::atomic<bool> producer_is_waiting                  = false;
+	std::atomic<uint32_t> room_signal                      = 0;
+
+	alignas(CacheLineSize) std::atomic<size_t> read_index = 0;
+	std::atomic<bool> consumer_is_waiting                 = false;
+	std::atomic<uint32_t> items_signal                    = 0;
+
+	size_t GetFreeCapacity() const;
+	size_t GetNumQueued() const;
+
+	void WaitForRoom(size_t num_items);
+	void WaitForItems();
+	void PublishWrite(size_t new_write_index);
+	void PublishRead(size_t new_read_index);
+
+	using difference_t = typename std::vector<T>::difference_type;
+
+public:
+	SpscQueue()                                  = delete;
+	SpscQueue(const SpscQueue<T>& other)         = delete;
+	SpscQueue<T>& operator=(const SpscQueue<T>&) = delete;
+
+	SpscQueue(size_t queue_capacity);
+	void Resize(size_t queue_capacity);
+
+	// non-blocking call
+	bool IsEmpty();
+
+	// non-blocking call
+	bool IsFull();
+
+	// non-blocking call
+	bool IsRunning();
+
+	// non-blocking call
+	size_t Size();
+
+	// non-blocking call
+	void Start();
+
+	// non-blocking call
+	void Stop();
+
+	// non-blocking call (consumer only)
+	void Clear();
+
+	// non-blocking call
+	size_t MaxCapacity();
+
+	// non-blocking call
+	float GetPercentFull();
+
+	// The item will be empty (moved-out) after the call. Potentially blocks
+	// until the queue has room for the item.
+	//
+	// If queuing has stopped prior to or while enqueueing, this returns
+	// false and the item is not queued.
+	bool Enqueue(T&& item);
+
+	// Returns false and does nothing if the queue is at capacity or the
+	// queue is not running. Otherwise the item gets moved into the queue
+	// and it returns true.
+	bool NonblockingEnqueue(T&& item);
+
+	// Potentially blocks until there is at least a single item in the queue
+	// to dequeue.
+	//
+	// If queuing has stopped, this will continue to return item(s) until
+	// none remain in the queue, at which point it returns empty results.
+	std::optional<T> Dequeue();
+
+	// The bulk operations behave the same as the RWQueue's; see
+	// `utils/rwqueue.h` for the details.
+	size_t BulkEnqueue(std::vector<T>& from_source, const size_t num_requested);
+
+	size_t BulkEnqueue(std::vector<T>& from_source);
+
+	size_t NonblockingBulkEnqueue(std::vector<T>& from_source,
+	                              const size_t num_requested);
+
+	size_t NonblockingBulkEnqueue(std::vector<T>& from_source);
+
+	size_t BulkDequeue(std::vector<T>& into_target, const size_t num_requested);
+
+	size_t BulkDequeue(T* const into_target, const size_t num_requested);
+};
+
+#endif // DOSBOX_SPSC_QUEUE_H
@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Fills a host directory with files that have long names, caches it in with
+// the directory cache of mounted host directories, and reports how long it
+// takes to cache the directory in and to look up the names. Verifies that
+// every file gets a unique 8.3 name that maps back to the host name.
+//
+// Usage:
+//
+//   drive_cache_benchmark [num_files]
+//
+// The default is 10000 files. All files share the same first 6 characters,
+// which is the worst case for generating the numbered short names. Run it
+// from the top of the source tree so the code page mappings in `resources/`
+// are found.
+
+#include "dos/dos_system.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "misc/cross.h"
+#include "misc/std_filesystem.h"
+#include "utils/string_utils.h"
+
+using namespace std::chrono;
+
+static double elapsed_ms(const steady_clock::time_point start)
+{
+	const duration<double, std::milli> elapsed = steady_clock::now() - start;
+	return elapsed.count();
+}
+
+static void print_result(const char* operation, const size_t num_calls,
+                         const double total_ms)
+{
+	printf("%-28s %10.1f ms %10.2f us/call\n",
+	       operation,
+	       total_ms,
+	       total_ms * 1000.0 / static_cast<double>(num_calls));
+}
+
+int main(int argc, char* argv[])
+{
+	const auto num_files = (argc > 1) ? std::max(1, atoi(argv[1])) : 10000;
+
+	const auto dir = std_fs::temp_directory_path() / "dosbox_drive_cache_benchmark";
+
+	std::error_code ec = {};
+	std_fs::remove_all(dir, ec);
+	if (!std_fs::create_directory(dir, ec)) {
+		printf("Could not create %s\n", dir.string().c_str());
+		return 1;
+	}
+
+	std::vector<std::string> names = {};
+	for (auto i = 0; i < num_files; ++i) {
+		char name[64];
+		snprintf(name, sizeof(name), "Long File Name Number %05d.txt", i);
+		names.emplace_back(name);
+		std::ofstream(dir / name).put('x');
+	}
+
+	const auto base_dir = dir.string() + CROSS_FILESPLIT;
+
+	auto start = steady_clock::now();
+	DOS_Drive_Cache cache(base_dir.c_str());
+	print_result("Cache in directory", 1, elapsed_ms(start));
+
+	// Host name to 8.3 name, as when listing or opening a host file
+	std::vector<std::string> short_names = {};
+	short_names.reserve(names.size());
+
+	start = steady_clock::now();
+	for (const auto& name : names) {
+		char short_name[DOS_NAMELENGTH_ASCII] = {};
+		if (!cache.GetShortName((base_dir + name).c_str(), short_name)) {
+			printf("No short name for %s\n", name.c_str());
+			return 1;
+		}
+		short_names.emplace_back(short_name);
+	}
+	print_result("Host name to 8.3 name", names.size(), elapsed_ms(start));
+
+	if (std::set<std::string>(short_names.begin(), short_names.end()).size() !=
+	    short_names.size()) {
+		printf("The short names are not unique\n");
+		return 1;
+	}
+
+	// 8.3 name to host name, as when a DOS program opens a file
+	start = steady_clock::now();
+	for (size_t i = 0; i < short_names.size(); ++i) {
+		const auto expanded = cache.GetExpandNameAndNormaliseCase(
+		        (base_dir + short_names[i]).c_str());
+		if (base_dir + names[i] != expanded) {
+			printf("%s expands to %s\n", short_names[i].c_str(), expanded);
+			return 1;
+		}
+	}
+	print_result("8.3 name to host name", short_names.size(), elapsed_ms(start));
+
+	// Listing the directory, as DIR does
+	char search_path[CROSS_LEN];
+	safe_strcpy(search_path, base_dir.c_str());
+
+	start = steady_clock::now();
+	uint16_t id       = 0;
+	size_t num_listed = 0;
+	if (cache.FindFirst(search_path, id)) {
+		char* result = nullptr;
+		while (cache.FindNext(id, result)) {
+			if (result[0] != '.') {
+				++num_listed;
+			}
+		}
+	}
+	print_result("List directory", 1, elapsed_ms(start));
+
+	if (num_listed != names.size()) {
+		printf("Listed %zu of %zu files\n", num_listed, names.size());
+		return 1;
+	}
+
+	std_fs::remove_all(dir, ec);
+	return 0;
+}
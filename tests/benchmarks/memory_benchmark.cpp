@@ -0,0 +1,363 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Runs guest memory block transfers through a model of the paging TLB, once
+// with the original byte-at-a-time loops of MEM_BlockRead, MEM_BlockWrite and
+// mem_memcpy, and once with the page-span loops that copy whole spans of RAM
+// pages with memcpy. Verifies that both produce the same memory contents and
+// reports the throughput per transfer size.
+//
+// Usage:
+//
+//   memory_benchmark [megabytes_per_run]
+//
+// Transfers are made to and from conventional memory, which is plain RAM,
+// and to and from the VGA window at A0000h, which goes through a page
+// handler like memory-mapped I/O does.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+using PhysPt = uint32_t;
+using HostPt = uint8_t*;
+
+constexpr PhysPt PageSize    = 4096;
+constexpr PhysPt MemorySize  = 16 * 1024 * 1024;
+constexpr PhysPt NumPages    = MemorySize / PageSize;
+constexpr PhysPt VgaStart    = 0xa0000;
+constexpr PhysPt VgaEnd      = 0xc0000;
+constexpr PhysPt VgaLatchXor = 0x5a;
+
+// Plain RAM pages have host pointers in the TLB; the VGA window pages only
+// have handlers, which transform the data so the model can't accidentally
+// bypass them
+struct Tlb {
+	std::vector<uint8_t> ram = std::vector<uint8_t>(MemorySize);
+	std::vector<uint8_t> vga = std::vector<uint8_t>(VgaEnd - VgaStart);
+
+	HostPt read[NumPages]  = {};
+	HostPt write[NumPages] = {};
+
+	Tlb()
+	{
+		for (PhysPt page = 0; page < NumPages; ++page) {
+			const auto address = page * PageSize;
+			if (address >= VgaStart && address < VgaEnd) {
+				continue;
+			}
+			// Like in the real TLB, adding the address to the entry
+			// gives the host pointer
+			read[page]  = ram.data();
+			write[page] = ram.data();
+		}
+	}
+
+	uint8_t handler_readb(const PhysPt address) const
+	{
+		return vga[address - VgaStart] ^ VgaLatchXor;
+	}
+
+	void handler_writeb(const PhysPt address, const uint8_t val)
+	{
+		vga[address - VgaStart] = val ^ VgaLatchXor;
+	}
+} tlb;
+
+static inline HostPt get_tlb_read(const PhysPt address)
+{
+	return tlb.read[address / PageSize];
+}
+
+static inline HostPt get_tlb_write(const PhysPt address)
+{
+	return tlb.write[address / PageSize];
+}
+
+static inline uint8_t mem_readb_inline(const PhysPt address)
+{
+	const auto tlb_addr = get_tlb_read(address);
+	return tlb_addr ? tlb_addr[address] : tlb.handler_readb(address);
+}
+
+static inline void mem_writeb_inline(const PhysPt address, const uint8_t val)
+{
+	const auto tlb_addr = get_tlb_write(address);
+	if (tlb_addr) {
+		tlb_addr[address] = val;
+	} else {
+		tlb.handler_writeb(address, val);
+	}
+}
+
+// The loops before the page-span copies
+static void legacy_block_read(PhysPt pt, void* data, size_t size)
+{
+	auto write = static_cast<uint8_t*>(data);
+	while (size--) {
+		*write++ = mem_readb_inline(pt++);
+	}
+}
+
+static void legacy_block_write(PhysPt pt, const void* data, size_t size)
+{
+	auto read = static_cast<const uint8_t*>(data);
+	while (size--) {
+		mem_writeb_inline(pt++, *read++);
+	}
+}
+
+static void legacy_memcpy(PhysPt dest, PhysPt src, size_t size)
+{
+	while (size--) {
+		mem_writeb_inline(dest++, mem_readb_inline(src++));
+	}
+}
+
+// The page-span loops, as in src/hardware/memory.cpp
+static size_t get_page_span(const PhysPt address, const size_t size)
+{
+	const auto bytes_left_in_page = PageSize - (address & (PageSize - 1));
+	return std::min(size, static_cast<size_t>(bytes_left_in_page));
+}
+
+static void span_block_read(PhysPt pt, void* data, size_t size)
+{
+	auto write = static_cast<uint8_t*>(data);
+	while (size) {
+		const auto span     = get_page_span(pt, size);
+		const auto tlb_addr = get_tlb_read(pt);
+		if (!tlb_addr) {
+			for (size_t i = 0; i < span; ++i) {
+				*write++ = mem_readb_inline(pt++);
+			}
+			size -= span;
+			continue;
+		}
+		memcpy(write, tlb_addr + pt, span);
+
+		write += span;
+		pt += static_cast<PhysPt>(span);
+		size -= span;
+	}
+}
+
+static void span_block_write(PhysPt pt, const void* data, size_t size)
+{
+	auto read = static_cast<const uint8_t*>(data);
+	while (size) {
+		const auto span     = get_page_span(pt, size);
+		const auto tlb_addr = get_tlb_write(pt);
+		if (!tlb_addr) {
+			for (size_t i = 0; i < span; ++i) {
+				mem_writeb_inline(pt++, *read++);
+			}
+			size -= span;
+			continue;
+		}
+		memcpy(tlb_addr + pt, read, span);
+
+		read += span;
+		pt += static_cast<PhysPt>(span);
+		size -= span;
+	}
+}
+
+static void span_memcpy(PhysPt dest, PhysPt src, size_t size)
+{
+	while (size) {
+		auto span = std::min(get_page_span(src, size), get_page_span(dest, size));
+
+		const auto src_addr  = get_tlb_read(src);
+		const auto dest_addr = get_tlb_write(dest);
+		if (!src_addr || !dest_addr) {
+			for (size_t i = 0; i < span; ++i) {
+				mem_writeb_inline(dest++, mem_readb_inline(src++));
+			}
+			size -= span;
+			continue;
+		}
+		const auto host_src  = src_addr + src;
+		const auto host_dest = dest_addr + dest;
+		const auto distance  = reinterpret_cast<uintptr_t>(host_dest) -
+		                      reinterpret_cast<uintptr_t>(host_src);
+		if (distance > 0 && distance < span) {
+			span = distance;
+		}
+		memmove(host_dest, host_src, span);
+
+		src += static_cast<PhysPt>(span);
+		dest += static_cast<PhysPt>(span);
+		size -= span;
+	}
+}
+
+struct Transfer {
+	const char* name = nullptr;
+	PhysPt address   = 0;
+	size_t size      = 0;
+};
+
+// Typical transfers: a disk sector, an INT 21h read or write into a
+// conventional memory buffer (unaligned, so it straddles pages), and a
+// full EMS page frame
+static const Transfer transfers[] = {
+        {"512 B RAM", 0x10000, 512},
+        {"32 KB RAM", 0x20123, 32 * 1024},
+        {"64 KB RAM", 0x40000, 64 * 1024},
+        {"64 KB VGA", VgaStart, 64 * 1024},
+};
+
+static double measure_mb_per_s(const std::function<void()>& run_once,
+                               const size_t transfer_size, const size_t total_bytes)
+{
+	using clock = std::chrono::steady_clock;
+
+	const auto num_runs = std::max<size_t>(1, total_bytes / transfer_size);
+
+	const auto start = clock::now();
+	for (size_t i = 0; i < num_runs; ++i) {
+		run_once();
+	}
+	const std::chrono::duration<double> elapsed = clock::now() - start;
+
+	const auto megabytes = static_cast<double>(num_runs * transfer_size) /
+	                       (1024.0 * 1024.0);
+	return megabytes / elapsed.count();
+}
+
+static void print_result(const char* operation, const char* transfer,
+                         const double legacy_mb_per_s, const double span_mb_per_s)
+{
+	printf("%-16s %-10s %12.0f %12.0f %8.1fx\n",
+	       operation,
+	       transfer,
+	       legacy_mb_per_s,
+	       span_mb_per_s,
+	       span_mb_per_s / legacy_mb_per_s);
+}
+
+static void fill_memory(const uint32_t seed)
+{
+	auto value = seed;
+	for (auto& byte : tlb.ram) {
+		value = value * 1664525 + 1013904223;
+		byte  = static_cast<uint8_t>(value >> 24);
+	}
+	for (auto& byte : tlb.vga) {
+		value = value * 1664525 + 1013904223;
+		byte  = static_cast<uint8_t>(value >> 24);
+	}
+}
+
+static bool verify()
+{
+	std::vector<uint8_t> expected(64 * 1024 + 1);
+	std::vector<uint8_t> actual(expected.size());
+
+	for (const auto& t : transfers) {
+		fill_memory(1);
+		legacy_block_read(t.address, expected.data(), t.size);
+		span_block_read(t.address, actual.data(), t.size);
+		if (expected != actual) {
+			printf("MEM_BlockRead mismatch: %s\n", t.name);
+			return false;
+		}
+
+		fill_memory(2);
+		legacy_block_write(t.address, expected.data(), t.size);
+		const auto expected_ram = tlb.ram;
+		const auto expected_vga = tlb.vga;
+		fill_memory(2);
+		span_block_write(t.address, expected.data(), t.size);
+		if (tlb.ram != expected_ram || tlb.vga != expected_vga) {
+			printf("MEM_BlockWrite mismatch: %s\n", t.name);
+			return false;
+		}
+	}
+
+	// Copies between RAM and VGA, and overlapping copies in both directions
+	const Transfer copies[] = {
+	        {"RAM to VGA", 0x30000, VgaStart + 0x10},
+	        {"VGA to RAM", VgaStart, 0x30011},
+	        {"overlap up", 0x50000, 0x50003},
+	        {"overlap down", 0x60003, 0x60000},
+	};
+	for (const auto& c : copies) {
+		const auto dest = static_cast<PhysPt>(c.size);
+
+		fill_memory(3);
+		legacy_memcpy(dest, c.address, 20000);
+		const auto expected_ram = tlb.ram;
+		const auto expected_vga = tlb.vga;
+		fill_memory(3);
+		span_memcpy(dest, c.address, 20000);
+		if (tlb.ram != expected_ram || tlb.vga != expected_vga) {
+			printf("mem_memcpy mismatch: %s\n", c.name);
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	const auto megabytes_per_run = (argc > 1) ? std::max(1, atoi(argv[1])) : 256;
+	const auto total_bytes = static_cast<size_t>(megabytes_per_run) * 1024 * 1024;
+
+	if (!verify()) {
+		return 1;
+	}
+	printf("Page-span copies produce the same memory contents\n\n");
+
+	std::vector<uint8_t> buffer(64 * 1024);
+	fill_memory(4);
+
+	printf("%-16s %-10s %12s %12s %9s\n",
+	       "operation",
+	       "transfer",
+	       "legacy MB/s",
+	       "span MB/s",
+	       "speedup");
+
+	for (const auto& t : transfers) {
+		const auto legacy_read = measure_mb_per_s(
+		        [&] { legacy_block_read(t.address, buffer.data(), t.size); },
+		        t.size,
+		        total_bytes);
+		const auto span_read = measure_mb_per_s(
+		        [&] { span_block_read(t.address, buffer.data(), t.size); },
+		        t.size,
+		        total_bytes);
+		print_result("MEM_BlockRead", t.name, legacy_read, span_read);
+
+		const auto legacy_write = measure_mb_per_s(
+		        [&] { legacy_block_write(t.address, buffer.data(), t.size); },
+		        t.size,
+		        total_bytes);
+		const auto span_write = measure_mb_per_s(
+		        [&] { span_block_write(t.address, buffer.data(), t.size); },
+		        t.size,
+		        total_bytes);
+		print_result("MEM_BlockWrite", t.name, legacy_write, span_write);
+	}
+
+	// An XMS move from extended to conventional memory
+	constexpr size_t XmsMoveSize = 64 * 1024;
+	const auto legacy_copy = measure_mb_per_s(
+	        [&] { legacy_memcpy(0x20000, 0x200000, XmsMoveSize); },
+	        XmsMoveSize,
+	        total_bytes);
+	const auto span_copy = measure_mb_per_s(
+	        [&] { span_memcpy(0x20000, 0x200000, XmsMoveSize); },
+	        XmsMoveSize,
+	        total_bytes);
+	print_result("mem_memcpy", "64 KB RAM", legacy_copy, span_copy);
+
+	return 0;
+}
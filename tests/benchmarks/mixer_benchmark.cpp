@@ -0,0 +1,269 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Runs blocks of synthetic samples through a model of the mixer channels'
+// sample conversion stage (decoding, channel mapping, gain, output line
+// mapping, and crossfeed), once with the original frame-at-a-time code and
+// once with the block-based kernels. Verifies that both produce the same
+// output and reports the throughput per channel configuration.
+//
+// Usage:
+//
+//   mixer_benchmark [seconds_of_audio]
+//
+// Every configuration is run at 48 and 96 kHz with the mixer's default block
+// size; the "realtime" column shows how many channels of that kind a single
+// core could render in real-time.
+
+#include "audio/private/sample_ops.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+constexpr auto BlockSize = 512;
+
+static float u8_to_float(const uint8_t u_val)
+{
+	const auto s_val = u_val - 128;
+	if (s_val > 0) {
+		constexpr auto Scalar = INT16_MAX / 127.0;
+		return static_cast<float>(std::round(s_val * Scalar));
+	}
+	return static_cast<float>(s_val * 256);
+}
+
+struct ChannelState {
+	AudioFrame next_frame = {};
+
+	size_t channel_map_left  = 1;
+	size_t channel_map_right = 0;
+
+	size_t output_map_left  = 0;
+	size_t output_map_right = 1;
+
+	AudioFrame gain = {0.8f, 0.7f};
+
+	bool do_crossfeed = true;
+	float pan_left    = 0.3f;
+	float pan_right   = 0.7f;
+
+	std::vector<AudioFrame> out    = {};
+	std::vector<float> mono_buffer = {};
+};
+
+template <class Type>
+static float decode_sample(const Type sample)
+{
+	if constexpr (std::is_same_v<Type, uint8_t>) {
+		return u8_to_float(sample);
+	} else {
+		return static_cast<float>(sample);
+	}
+}
+
+// The conversion loop before vectorisation
+template <class Type, bool stereo>
+static void legacy_convert(ChannelState& s, const Type* data, const int num_frames)
+{
+	s.out.clear();
+
+	for (auto pos = 0; pos < num_frames; ++pos) {
+		const auto prev_frame = s.next_frame;
+
+		if (stereo) {
+			s.next_frame = {decode_sample(data[pos * 2]),
+			                decode_sample(data[pos * 2 + 1])};
+		} else {
+			s.next_frame = {decode_sample(data[pos]), 0.0f};
+		}
+
+		AudioFrame frame_with_gain = {};
+		if (stereo) {
+			frame_with_gain = {prev_frame[s.channel_map_left],
+			                   prev_frame[s.channel_map_right]};
+		} else {
+			frame_with_gain = {prev_frame[s.channel_map_left]};
+		}
+		frame_with_gain *= s.gain;
+
+		AudioFrame out_frame = {};
+		out_frame[s.output_map_left] += frame_with_gain.left;
+		out_frame[s.output_map_right] += frame_with_gain.right;
+
+		s.out.push_back(out_frame);
+	}
+
+	if (s.do_crossfeed) {
+		for (auto& frame : s.out) {
+			frame = {(1.0f - s.pan_left) * frame.left +
+			                 (1.0f - s.pan_right) * frame.right,
+			         s.pan_left * frame.left + s.pan_right * frame.right};
+		}
+	}
+}
+
+// The conversion as implemented in `MixerChannel::AddSamples()`
+template <class Type, bool stereo>
+static void block_convert(ChannelState& s, const Type* data, const int num_frames)
+{
+	const auto n = static_cast<size_t>(num_frames);
+
+	s.out.resize(n + 1);
+	s.out.front() = s.next_frame;
+
+	auto dest = &s.out[1];
+
+	const auto num_samples = stereo ? n * 2 : n;
+	auto samples           = reinterpret_cast<float*>(dest);
+	if (!stereo) {
+		s.mono_buffer.resize(n);
+		samples = s.mono_buffer.data();
+	}
+
+	if constexpr (std::is_same_v<Type, uint8_t>) {
+		convert_u8_to_float(data, samples, num_samples);
+	} else if constexpr (std::is_same_v<Type, int16_t>) {
+		convert_s16_to_float(data, samples, num_samples);
+	} else {
+		std::memcpy(samples, data, num_samples * sizeof(float));
+	}
+	if (!stereo) {
+		interleave_mono(samples, dest, n, 0.0f);
+	}
+
+	s.next_frame = s.out.back();
+	s.out.pop_back();
+
+	apply_channel_map_and_gain(s.out,
+	                           s.channel_map_left,
+	                           stereo ? s.channel_map_right : s.channel_map_left,
+	                           s.gain);
+
+	apply_lineout_map(s.out, s.output_map_left, s.output_map_right);
+
+	if (s.do_crossfeed) {
+		apply_crossfeed(s.out, s.pan_left, s.pan_right);
+	}
+}
+
+struct Result {
+	std::vector<AudioFrame> output = {};
+	double seconds                 = 0.0;
+};
+
+template <class Type, bool stereo, class Convert>
+static Result run(const std::vector<Type>& samples, const int num_frames,
+                  Convert convert)
+{
+	ChannelState state = {};
+	Result result      = {};
+	result.output.reserve(static_cast<size_t>(num_frames));
+
+	constexpr auto SamplesPerFrame = stereo ? 2 : 1;
+
+	const auto start = std::chrono::steady_clock::now();
+
+	for (auto pos = 0; pos < num_frames; pos += BlockSize) {
+		convert(state, &samples[static_cast<size_t>(pos * SamplesPerFrame)], BlockSize);
+		result.output.insert(result.output.end(), state.out.begin(), state.out.end());
+	}
+
+	const auto end = std::chrono::steady_clock::now();
+	result.seconds = std::chrono::duration<double>(end - start).count();
+	return result;
+}
+
+static bool outputs_match(const std::vector<AudioFrame>& a,
+                          const std::vector<AudioFrame>& b)
+{
+	if (a.size() != b.size()) {
+		return false;
+	}
+	// Allow for fused multiply-adds in the scalar crossfeed
+	for (size_t i = 0; i < a.size(); ++i) {
+		if (std::abs(a[i].left - b[i].left) > 0.01f ||
+		    std::abs(a[i].right - b[i].right) > 0.01f) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static void report(const char* name, const int num_frames,
+                   const int sample_rate_hz, const Result& result)
+{
+	const auto frames_per_second = num_frames / result.seconds;
+
+	printf("    %-8s %10.1f Mframes/s %10.0fx realtime\n",
+	       name,
+	       frames_per_second / 1e6,
+	       frames_per_second / sample_rate_hz);
+}
+
+template <class Type, bool stereo>
+static bool benchmark(const char* name, const double seconds_of_audio)
+{
+	auto ok = true;
+
+	for (const auto sample_rate_hz : {48000, 96000}) {
+		const auto num_blocks = static_cast<int>(seconds_of_audio *
+		                                         sample_rate_hz / BlockSize) +
+		                        1;
+		const auto num_frames = num_blocks * BlockSize;
+
+		std::vector<Type> samples(static_cast<size_t>(num_frames) * (stereo ? 2 : 1));
+
+		uint32_t seed = 1;
+		for (auto& sample : samples) {
+			seed = seed * 1103515245 + 12345;
+			if constexpr (std::is_same_v<Type, float>) {
+				sample = static_cast<float>(static_cast<int16_t>(seed >> 16));
+			} else {
+				sample = static_cast<Type>(seed >> 16);
+			}
+		}
+
+		printf("  %s, %d Hz\n", name, sample_rate_hz);
+
+		const auto legacy = run<Type, stereo>(samples,
+		                                      num_frames,
+		                                      legacy_convert<Type, stereo>);
+		report("scalar", num_frames, sample_rate_hz, legacy);
+
+		const auto block = run<Type, stereo>(samples,
+		                                     num_frames,
+		                                     block_convert<Type, stereo>);
+		report("block", num_frames, sample_rate_hz, block);
+
+		if (!outputs_match(legacy.output, block.output)) {
+			fprintf(stderr, "ERROR: The outputs differ\n");
+			ok = false;
+		}
+	}
+	return ok;
+}
+
+int main(int argc, char* argv[])
+{
+	const auto seconds_of_audio = (argc >= 2) ? atof(argv[1]) : 60.0;
+	if (seconds_of_audio <= 0.0) {
+		fprintf(stderr, "Usage: %s [seconds_of_audio]\n", argv[0]);
+		return 1;
+	}
+
+	printf("Rendering %.0f seconds of audio per configuration\n", seconds_of_audio);
+
+	auto ok = true;
+	ok &= benchmark<uint8_t, false>("8-bit mono", seconds_of_audio);
+	ok &= benchmark<uint8_t, true>("8-bit stereo", seconds_of_audio);
+	ok &= benchmark<int16_t, false>("16-bit mono", seconds_of_audio);
+	ok &= benchmark<int16_t, true>("16-bit stereo", seconds_of_audio);
+	ok &= benchmark<float, true>("float stereo", seconds_of_audio);
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,180 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Compares the mutex-based RWQueue with the lock-free SpscQueue between one
+// producer and one consumer thread.
+//
+// Usage:
+//
+//   queue_benchmark [seconds_of_audio]
+//
+// The throughput test streams audio frames through the queue in the block
+// sizes the mixer and the MIDI synths use. The latency test bounces single
+// items between two threads through a pair of queues and reports the round
+// trip times, which are dominated by how quickly a waiting thread gets woken
+// up.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "audio/audio_frame.h"
+#include "utils/rwqueue.h"
+#include "utils/spsc_queue.h"
+
+using Clock = std::chrono::steady_clock;
+
+constexpr auto SampleRateHz = 48000;
+
+template <class Queue>
+static double measure_throughput(const size_t queue_capacity,
+                                 const size_t producer_block,
+                                 const size_t consumer_block,
+                                 const size_t num_frames)
+{
+	Queue queue(queue_capacity);
+
+	const auto start = Clock::now();
+
+	std::thread producer([&] {
+		std::vector<AudioFrame> frames = {};
+
+		for (size_t pos = 0; pos < num_frames; pos += producer_block) {
+			const auto n = std::min(producer_block, num_frames - pos);
+			frames.resize(n, AudioFrame{1.0f, -1.0f});
+			queue.BulkEnqueue(frames, n);
+		}
+	});
+
+	std::vector<AudioFrame> frames = {};
+
+	auto num_received = static_cast<size_t>(0);
+	while (num_received < num_frames) {
+		const auto n = std::min(consumer_block, num_frames - num_received);
+		num_received += queue.BulkDequeue(frames, n);
+	}
+
+	producer.join();
+
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+struct Latency {
+	double median_us = 0.0;
+	double p99_us    = 0.0;
+	double max_us    = 0.0;
+};
+
+template <class Queue>
+static Latency measure_latency(const int num_round_trips)
+{
+	Queue ping(16);
+	Queue pong(16);
+
+	std::thread responder([&] {
+		for (auto i = 0; i < num_round_trips; ++i) {
+			auto item = ping.Dequeue();
+			pong.Enqueue(std::move(*item));
+		}
+	});
+
+	std::vector<double> round_trips_us = {};
+	round_trips_us.reserve(static_cast<size_t>(num_round_trips));
+
+	for (auto i = 0; i < num_round_trips; ++i) {
+		const auto start = Clock::now();
+
+		auto item = i;
+		ping.Enqueue(std::move(item));
+		pong.Dequeue();
+
+		round_trips_us.push_back(
+		        std::chrono::duration<double, std::micro>(Clock::now() - start)
+		                .count());
+	}
+
+	responder.join();
+
+	std::sort(round_trips_us.begin(), round_trips_us.end());
+
+	const auto percentile = [&](const double p) {
+		const auto index = static_cast<size_t>(
+		        p * static_cast<double>(round_trips_us.size() - 1));
+		return round_trips_us[index];
+	};
+
+	return {percentile(0.5), percentile(0.99), round_trips_us.back()};
+}
+
+static void run_throughput(const char* name, const size_t queue_capacity,
+                           const size_t producer_block,
+                           const size_t consumer_block, const size_t num_frames)
+{
+	printf("  %s (capacity %zu, blocks of %zu in, %zu out)\n",
+	       name,
+	       queue_capacity,
+	       producer_block,
+	       consumer_block);
+
+	const auto report = [&](const char* queue_name, const double seconds) {
+		const auto frames_per_second = static_cast<double>(num_frames) / seconds;
+
+		printf("    %-8s %10.1f Mframes/s %10.0fx realtime\n",
+		       queue_name,
+		       frames_per_second / 1e6,
+		       frames_per_second / SampleRateHz);
+	};
+
+	report("rwqueue",
+	       measure_throughput<RWQueue<AudioFrame>>(
+	               queue_capacity, producer_block, consumer_block, num_frames));
+
+	report("spsc",
+	       measure_throughput<SpscQueue<AudioFrame>>(
+	               queue_capacity, producer_block, consumer_block, num_frames));
+}
+
+int main(int argc, char* argv[])
+{
+	const auto seconds_of_audio = (argc >= 2) ? atof(argv[1]) : 600.0;
+	if (seconds_of_audio <= 0.0) {
+		fprintf(stderr, "Usage: %s [seconds_of_audio]\n", argv[0]);
+		return 1;
+	}
+
+	const auto num_frames = static_cast<size_t>(seconds_of_audio * SampleRateHz);
+
+	printf("Streaming %.0f seconds of %d Hz audio per configuration\n",
+	       seconds_of_audio,
+	       SampleRateHz);
+
+	// Mixer to SDL: default blocksize plus 20 ms of prebuffer, drained in
+	// smaller chunks by the audio device callback
+	run_throughput("final output", 512 + 960, 512, 256, num_frames);
+
+	// Synth to mixer: 40 ms render-ahead, rendered in small bursts and
+	// pulled in mixer blocks
+	run_throughput("midi synth", 1920, 64, 512, num_frames);
+
+	// Per-item enqueueing, the worst case for both queues
+	run_throughput("per-item", 1920, 1, 512, num_frames / 10);
+
+	constexpr auto NumRoundTrips = 100000;
+	printf("\nRound trip latency over %d round trips\n", NumRoundTrips);
+
+	const auto report = [](const char* queue_name, const Latency& latency) {
+		printf("    %-8s median %7.2f us   p99 %7.2f us   max %8.2f us\n",
+		       queue_name,
+		       latency.median_us,
+		       latency.p99_us,
+		       latency.max_us);
+	};
+
+	report("rwqueue", measure_latency<RWQueue<int>>(NumRoundTrips));
+	report("spsc", measure_latency<SpscQueue<int>>(NumRoundTrips));
+
+	return 0;
+}
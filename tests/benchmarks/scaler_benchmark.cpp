@@ -0,0 +1,222 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Runs synthetic frame sequences through a model of the Scale1x line handler,
+// once with the original scalar 8-bytes-at-a-time diffing and per-pixel
+// conversion, and once with the vectorised scanline primitives. Verifies that
+// both produce identical output and reports the throughput.
+//
+// Usage:
+//
+//   scaler_benchmark [num_frames]
+//
+// Two sequences are rendered: 320x200 8-bit (palettised VGA) and 1024x768
+// 16-bit (RGB565 SVGA). Both have a static background with a few moving
+// sprites, which is the common case the line cache is optimised for.
+
+#include "gui/render/scaler/line_ops.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+struct Sequence {
+	const char* name    = nullptr;
+	int width           = 0;
+	int height          = 0;
+	int bytes_per_pixel = 0;
+
+	std::vector<std::vector<uint8_t>> frames = {};
+};
+
+static uint32_t palette_lut[256] = {};
+
+static Sequence make_sequence(const char* name, const int width,
+                              const int height, const int bytes_per_pixel,
+                              const int num_frames)
+{
+	Sequence seq = {name, width, height, bytes_per_pixel, {}};
+
+	const auto row_bytes = static_cast<size_t>(width) * bytes_per_pixel;
+
+	uint32_t seed = 1;
+	std::vector<uint8_t> background(row_bytes * height);
+	for (auto& byte : background) {
+		seed = seed * 1103515245 + 12345;
+		byte = static_cast<uint8_t>(seed >> 16);
+	}
+
+	for (auto f = 0; f < num_frames; ++f) {
+		auto frame = background;
+
+		for (auto s = 0; s < 6; ++s) {
+			const auto x0 = (s * 53 + f * 2) % (width - 16);
+			const auto y0 = (s * 31 + f) % (height - 16);
+			for (auto y = y0; y < y0 + 16; ++y) {
+				std::memset(&frame[y * row_bytes + x0 * bytes_per_pixel],
+				            0x40 + s,
+				            16 * static_cast<size_t>(bytes_per_pixel));
+			}
+		}
+		seq.frames.push_back(std::move(frame));
+	}
+	return seq;
+}
+
+static uint32_t legacy_convert(const uint8_t* src, const int bytes_per_pixel)
+{
+	if (bytes_per_pixel == 1) {
+		return palette_lut[*src];
+	}
+	uint16_t v = 0;
+	std::memcpy(&v, src, sizeof(v));
+	return ((v & (31 << 11)) << 8) | ((v & (63 << 5)) << 5) |
+	       ((v & 0xE01F) << 3) | ((v & (3 << 9)) >> 1) | ((v & (7 << 2)) >> 2);
+}
+
+// The line handler loop before vectorisation
+static void legacy_line(const uint8_t* src, uint8_t* cache, uint32_t* out,
+                        const int width, const int bytes_per_pixel)
+{
+	const auto pixels_per_step = static_cast<int>(sizeof(uint64_t)) /
+	                             bytes_per_pixel;
+
+	for (auto x = width; x > 0;) {
+		uint64_t src_val   = 0;
+		uint64_t cache_val = 0;
+		std::memcpy(&src_val, src, sizeof(src_val));
+		std::memcpy(&cache_val, cache, sizeof(cache_val));
+
+		if (src_val == cache_val) {
+			x -= pixels_per_step;
+			src += pixels_per_step * bytes_per_pixel;
+			cache += pixels_per_step * bytes_per_pixel;
+			out += pixels_per_step;
+		} else {
+			for (auto i = (x > 32) ? 32 : x; i > 0; --i, --x) {
+				std::memcpy(cache, src, static_cast<size_t>(bytes_per_pixel));
+				*out++ = legacy_convert(src, bytes_per_pixel);
+				src += bytes_per_pixel;
+				cache += bytes_per_pixel;
+			}
+		}
+	}
+}
+
+// The line handler loop as implemented in `scaler/simple.h`
+static void vectorised_line(const uint8_t* src, uint8_t* cache, uint32_t* out,
+                            const int width, const int bytes_per_pixel)
+{
+	for (auto x = width; x > 0;) {
+		const auto num_unchanged = static_cast<int>(
+		        find_first_changed_byte(src,
+		                                cache,
+		                                static_cast<size_t>(x * bytes_per_pixel)) /
+		        static_cast<size_t>(bytes_per_pixel));
+
+		if (num_unchanged > 0) {
+			x -= num_unchanged;
+			src += num_unchanged * bytes_per_pixel;
+			cache += num_unchanged * bytes_per_pixel;
+			out += num_unchanged;
+			continue;
+		}
+
+		const auto num_pixels = (x > 32) ? 32 : x;
+		std::memcpy(cache, src, static_cast<size_t>(num_pixels * bytes_per_pixel));
+
+		if (bytes_per_pixel == 1) {
+			convert_indexed_to_bgrx(src, palette_lut, out, num_pixels);
+		} else {
+			convert_rgb565_to_bgrx(reinterpret_cast<const uint16_t*>(src),
+			                       out,
+			                       num_pixels);
+		}
+		x -= num_pixels;
+		src += num_pixels * bytes_per_pixel;
+		cache += num_pixels * bytes_per_pixel;
+		out += num_pixels;
+	}
+}
+
+using LineHandler = void (*)(const uint8_t*, uint8_t*, uint32_t*, int, int);
+
+struct RenderResult {
+	std::vector<uint32_t> output = {};
+	double seconds               = 0.0;
+};
+
+static RenderResult render(const Sequence& seq, const LineHandler handler)
+{
+	const auto row_bytes = static_cast<size_t>(seq.width) * seq.bytes_per_pixel;
+
+	// The legacy handler reads up to 8 bytes past the end of the row
+	std::vector<uint8_t> cache(row_bytes * seq.height + 8, 0);
+
+	RenderResult result = {};
+	result.output.resize(static_cast<size_t>(seq.width) * seq.height);
+
+	const auto start = std::chrono::steady_clock::now();
+
+	for (const auto& frame : seq.frames) {
+		for (auto y = 0; y < seq.height; ++y) {
+			handler(&frame[y * row_bytes],
+			        &cache[y * row_bytes],
+			        &result.output[static_cast<size_t>(y) * seq.width],
+			        seq.width,
+			        seq.bytes_per_pixel);
+		}
+	}
+
+	const auto end = std::chrono::steady_clock::now();
+	result.seconds = std::chrono::duration<double>(end - start).count();
+	return result;
+}
+
+static void report(const char* name, const Sequence& seq, const RenderResult& result)
+{
+	const auto num_frames = static_cast<double>(seq.frames.size());
+	const auto mpixels = num_frames * seq.width * seq.height / 1e6;
+
+	printf("  %-12s %10.1f fps %10.1f Mpixel/s\n",
+	       name,
+	       num_frames / result.seconds,
+	       mpixels / result.seconds);
+}
+
+int main(int argc, char* argv[])
+{
+	const auto num_frames = (argc >= 2) ? atoi(argv[1]) : 500;
+	if (num_frames <= 0) {
+		fprintf(stderr, "Usage: %s [num_frames]\n", argv[0]);
+		return 1;
+	}
+
+	for (uint32_t i = 0; i < 256; ++i) {
+		palette_lut[i] = i * 0x010101;
+	}
+
+	const Sequence sequences[] = {
+	        make_sequence("320x200 8-bit", 320, 200, 1, num_frames),
+	        make_sequence("1024x768 16-bit", 1024, 768, 2, num_frames / 4 + 1),
+	};
+
+	auto ok = true;
+	for (const auto& seq : sequences) {
+		printf("%s, %zu frames\n", seq.name, seq.frames.size());
+
+		const auto legacy = render(seq, legacy_line);
+		report("scalar", seq, legacy);
+
+		const auto vectorised = render(seq, vectorised_line);
+		report("vectorised", seq, vectorised);
+
+		if (legacy.output != vectorised.output) {
+			fprintf(stderr, "ERROR: The outputs differ\n");
+			ok = false;
+		}
+	}
+	return ok ? 0 : 1;
+}
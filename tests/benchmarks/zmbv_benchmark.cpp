@@ -0,0 +1,227 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Replays raw video frames through the ZMBV encoder, once with the motion
+// search on a single thread and once with the tile-parallel search, verifies
+// that both produce byte-identical bitstreams, and reports the throughput.
+//
+// Usage:
+//
+//   zmbv_benchmark [<raw_file> <width> <height> <bpp> [num_threads]]
+//
+// `raw_file` holds consecutive frames of tightly packed pixels (`width *
+// height * bytes_per_pixel` bytes per frame); `bpp` is one of 8, 15, 16 or
+// 32. Without arguments, a synthetic 640x480 8-bit sequence with scrolling
+// and partially changing content is generated.
+
+#include "capture/video/zmbv.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct Sequence {
+	int width          = 0;
+	int height         = 0;
+	ZMBV_FORMAT format = ZMBV_FORMAT::NONE;
+
+	std::vector<std::vector<uint8_t>> frames = {};
+};
+
+static ZMBV_FORMAT to_format(const int bpp)
+{
+	switch (bpp) {
+	case 8: return ZMBV_FORMAT::BPP_8;
+	case 15: return ZMBV_FORMAT::BPP_15;
+	case 16: return ZMBV_FORMAT::BPP_16;
+	case 32: return ZMBV_FORMAT::BPP_32;
+	default: return ZMBV_FORMAT::NONE;
+	}
+}
+
+static Sequence load_sequence(const char* path, const int width,
+                              const int height, const ZMBV_FORMAT format)
+{
+	Sequence seq = {width, height, format, {}};
+
+	const auto frame_bytes = static_cast<size_t>(width) * height *
+	                         ZMBV_ToBytesPerPixel(format);
+
+	std::ifstream file(path, std::ios::binary);
+	std::vector<uint8_t> frame(frame_bytes);
+
+	while (file.read(reinterpret_cast<char*>(frame.data()),
+	                 static_cast<std::streamsize>(frame_bytes))) {
+		seq.frames.push_back(frame);
+	}
+	return seq;
+}
+
+static Sequence make_synthetic_sequence()
+{
+	constexpr auto Width     = 640;
+	constexpr auto Height    = 480;
+	constexpr auto NumFrames = 300;
+
+	Sequence seq = {Width, Height, ZMBV_FORMAT::BPP_8, {}};
+
+	uint32_t seed = 1;
+	auto next_random = [&seed] {
+		seed = seed * 1103515245 + 12345;
+		return (seed >> 16) & 0x7fff;
+	};
+
+	std::vector<uint8_t> background(Width * 2 * Height);
+	for (auto& pixel : background) {
+		pixel = static_cast<uint8_t>(next_random() & 0x3f);
+	}
+
+	for (auto f = 0; f < NumFrames; ++f) {
+		std::vector<uint8_t> frame(Width * Height);
+
+		// Horizontally scrolling background in the top half...
+		for (auto y = 0; y < Height / 2; ++y) {
+			std::memcpy(&frame[y * Width],
+			            &background[y * Width * 2 + (f % Width)],
+			            Width);
+		}
+		// ...a static bottom half with a few changing "sprites"
+		for (auto y = Height / 2; y < Height; ++y) {
+			std::memcpy(&frame[y * Width], &background[y * Width * 2], Width);
+		}
+		for (auto s = 0; s < 8; ++s) {
+			const auto x0 = (s * 73 + f * 3) % (Width - 32);
+			const auto y0 = Height / 2 + (s * 29) % (Height / 2 - 32);
+			for (auto y = y0; y < y0 + 32; ++y) {
+				std::memset(&frame[y * Width + x0], 0x40 + s, 32);
+			}
+		}
+		seq.frames.push_back(std::move(frame));
+	}
+	return seq;
+}
+
+struct EncodeResult {
+	std::vector<uint8_t> bitstream = {};
+	double seconds                 = 0.0;
+};
+
+static EncodeResult encode(const Sequence& seq, const int num_threads)
+{
+	EncodeResult result = {};
+
+	VideoCodec codec = {};
+	if (!codec.SetupCompress(seq.width, seq.height)) {
+		fprintf(stderr, "Failed to set up the ZMBV compressor\n");
+		exit(1);
+	}
+	codec.SetNumSearchThreads(num_threads);
+
+	std::vector<uint8_t> out(static_cast<size_t>(
+	        codec.NeededSize(seq.width, seq.height, seq.format)));
+
+	uint8_t palette[256 * 4] = {};
+	for (auto i = 0; i < 256; ++i) {
+		palette[i * 4 + 0] = static_cast<uint8_t>(i);
+		palette[i * 4 + 1] = static_cast<uint8_t>(255 - i);
+		palette[i * 4 + 2] = static_cast<uint8_t>(i * 7);
+	}
+
+	const auto row_bytes = static_cast<size_t>(seq.width) *
+	                       ZMBV_ToBytesPerPixel(seq.format);
+
+	const auto start = std::chrono::steady_clock::now();
+
+	auto frame_num = 0;
+	for (const auto& frame : seq.frames) {
+		const auto flags = (frame_num++ % 300 == 0) ? 1 : 0;
+
+		if (!codec.PrepareCompressFrame(flags,
+		                                seq.format,
+		                                palette,
+		                                out.data(),
+		                                static_cast<uint32_t>(out.size()))) {
+			fprintf(stderr, "Failed to prepare frame %d\n", frame_num);
+			exit(1);
+		}
+		for (auto y = 0; y < seq.height; ++y) {
+			const uint8_t* row = frame.data() + y * row_bytes;
+			codec.CompressLines(1, &row);
+		}
+		const auto written = codec.FinishCompressFrame();
+		result.bitstream.insert(result.bitstream.end(),
+		                        out.begin(),
+		                        out.begin() + written);
+	}
+	codec.FinishVideo();
+
+	const auto end = std::chrono::steady_clock::now();
+	result.seconds = std::chrono::duration<double>(end - start).count();
+	return result;
+}
+
+static void report(const char* name, const Sequence& seq, const EncodeResult& result)
+{
+	const auto num_frames = static_cast<double>(seq.frames.size());
+	const auto raw_mb = num_frames * seq.width * seq.height *
+	                    ZMBV_ToBytesPerPixel(seq.format) / (1024.0 * 1024.0);
+
+	printf("%-28s %8.1f fps %8.1f MB/s raw  (%zu bytes compressed)\n",
+	       name,
+	       num_frames / result.seconds,
+	       raw_mb / result.seconds,
+	       result.bitstream.size());
+}
+
+int main(int argc, char* argv[])
+{
+	Sequence seq = {};
+
+	if (argc >= 5) {
+		const auto format = to_format(atoi(argv[4]));
+		if (format == ZMBV_FORMAT::NONE) {
+			fprintf(stderr, "Unsupported bpp: %s\n", argv[4]);
+			return 1;
+		}
+		seq = load_sequence(argv[1], atoi(argv[2]), atoi(argv[3]), format);
+	} else if (argc == 1) {
+		seq = make_synthetic_sequence();
+	} else {
+		fprintf(stderr,
+		        "Usage: %s [<raw_file> <width> <height> <bpp> [num_threads]]\n",
+		        argv[0]);
+		return 1;
+	}
+
+	if (seq.frames.empty()) {
+		fprintf(stderr, "No frames to encode\n");
+		return 1;
+	}
+
+	const auto num_threads = (argc >= 6)
+	                               ? atoi(argv[5])
+	                               : static_cast<int>(std::thread::hardware_concurrency()) - 1;
+
+	printf("Encoding %zu frames of %dx%d\n", seq.frames.size(), seq.width, seq.height);
+
+	const auto serial = encode(seq, 0);
+	report("single-threaded search", seq, serial);
+
+	const auto parallel = encode(seq, num_threads > 0 ? num_threads : 1);
+	const auto name = "tile-parallel search (" +
+	                  std::to_string(num_threads > 0 ? num_threads : 1) +
+	                  "+1 threads)";
+	report(name.c_str(), seq, parallel);
+
+	if (serial.bitstream != parallel.bitstream) {
+		fprintf(stderr, "ERROR: The bitstreams differ\n");
+		return 1;
+	}
+	printf("Bitstreams are identical\n");
+	return 0;
+}
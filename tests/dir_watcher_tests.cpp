@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "utils/dir_watcher.h"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "misc/std_filesystem.h"
+
+namespace {
+
+class DirWatcherTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		dir = std_fs::temp_directory_path() / "dosbox_dir_watcher_tests";
+
+		std::error_code ec = {};
+		std_fs::remove_all(dir, ec);
+		ASSERT_TRUE(std_fs::create_directory(dir, ec));
+
+		watcher = DirWatcher::Create();
+		if (!watcher) {
+			GTEST_SKIP() << "Watching directories isn't supported";
+		}
+		ASSERT_TRUE(watcher->Watch(dir.string()));
+	}
+
+	void TearDown() override
+	{
+		std::error_code ec = {};
+		std_fs::remove_all(dir, ec);
+	}
+
+	std::string path_of(const std::string& name) const
+	{
+		return (dir / name).string();
+	}
+
+	std_fs::path dir                    = {};
+	std::unique_ptr<DirWatcher> watcher = {};
+};
+
+TEST_F(DirWatcherTest, ReportsAddedAndRemovedEntries)
+{
+	EXPECT_TRUE(watcher->ReadChanges().empty());
+
+	std::ofstream(dir / "file.txt").put('x');
+	std_fs::create_directory(dir / "subdir");
+	std_fs::rename(dir / "file.txt", dir / "renamed.txt");
+	std_fs::remove(dir / "subdir");
+
+	const auto changes = watcher->ReadChanges();
+	ASSERT_EQ(changes.size(), 5);
+
+	using enum DirWatcher::ChangeType;
+
+	EXPECT_EQ(changes[0].type, Added);
+	EXPECT_EQ(changes[0].path, path_of("file.txt"));
+	EXPECT_FALSE(changes[0].is_directory);
+
+	EXPECT_EQ(changes[1].type, Added);
+	EXPECT_EQ(changes[1].path, path_of("subdir"));
+	EXPECT_TRUE(changes[1].is_directory);
+
+	EXPECT_EQ(changes[2].type, Removed);
+	EXPECT_EQ(changes[2].path, path_of("file.txt"));
+
+	EXPECT_EQ(changes[3].type, Added);
+	EXPECT_EQ(changes[3].path, path_of("renamed.txt"));
+
+	EXPECT_EQ(changes[4].type, Removed);
+	EXPECT_EQ(changes[4].path, path_of("subdir"));
+	EXPECT_TRUE(changes[4].is_directory);
+
+	EXPECT_TRUE(watcher->ReadChanges().empty());
+}
+
+TEST_F(DirWatcherTest, SubdirectoriesAreWatchedSeparately)
+{
+	std_fs::create_directory(dir / "subdir");
+	std::ofstream(dir / "subdir" / "file.txt").put('x');
+
+	// Only the creation of the subdirectory is reported
+	EXPECT_EQ(watcher->ReadChanges().size(), 1);
+
+	ASSERT_TRUE(watcher->Watch((dir / "subdir").string()));
+	std::ofstream(dir / "subdir" / "file2.txt").put('x');
+
+	const auto changes = watcher->ReadChanges();
+	ASSERT_EQ(changes.size(), 1);
+	EXPECT_EQ(changes[0].path, path_of("subdir/file2.txt"));
+}
+
+} // namespace
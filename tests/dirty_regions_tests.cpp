@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gui/render/private/dirty_regions.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+void expect_region(const DirtyRegion& actual, const DirtyRegion& expected)
+{
+	EXPECT_EQ(actual.x, expected.x);
+	EXPECT_EQ(actual.y, expected.y);
+	EXPECT_EQ(actual.width, expected.width);
+	EXPECT_EQ(actual.height, expected.height);
+}
+
+TEST(DirtyRegions, StartsOutAsAll)
+{
+	DirtyRegions dirty = {};
+	EXPECT_TRUE(dirty.IsAll());
+	EXPECT_FALSE(dirty.IsEmpty());
+
+	// Adding regions doesn't narrow down "everything"
+	dirty.Add(DirtyRegion{0, 0, 10, 10});
+	EXPECT_TRUE(dirty.IsAll());
+}
+
+TEST(DirtyRegions, AddAndClear)
+{
+	DirtyRegions dirty = {};
+	dirty.Resize(640, 400);
+	dirty.Clear();
+	EXPECT_TRUE(dirty.IsEmpty());
+
+	const std::vector<DirtyRegion> regions = {{0, 10, 640, 20}, {100, 50, 16, 2}};
+	dirty.Add(regions);
+
+	ASSERT_EQ(dirty.GetRegions().size(), 2);
+	expect_region(dirty.GetRegions()[0], regions[0]);
+	expect_region(dirty.GetRegions()[1], regions[1]);
+
+	dirty.Clear();
+	EXPECT_TRUE(dirty.IsEmpty());
+	EXPECT_FALSE(dirty.IsAll());
+}
+
+TEST(DirtyRegions, ClipsToFramebuffer)
+{
+	DirtyRegions dirty = {};
+	dirty.Resize(320, 200);
+	dirty.Clear();
+
+	dirty.Add(DirtyRegion{-8, 190, 40, 20});
+	ASSERT_EQ(dirty.GetRegions().size(), 1);
+	expect_region(dirty.GetRegions()[0], {0, 190, 32, 10});
+
+	// Empty and fully off-screen regions are dropped
+	dirty.Add(DirtyRegion{10, 10, 0, 5});
+	dirty.Add(DirtyRegion{320, 0, 8, 8});
+	EXPECT_EQ(dirty.GetRegions().size(), 1);
+}
+
+TEST(DirtyRegions, MergesIntoBoundingBoxWhenFull)
+{
+	DirtyRegions dirty = {};
+	dirty.Resize(1024, 768);
+	dirty.Clear();
+
+	for (auto i = 0; i < 100; ++i) {
+		dirty.Add(DirtyRegion{i * 4, i * 2, 4, 2});
+	}
+
+	const auto regions = dirty.GetRegions();
+	ASSERT_FALSE(regions.empty());
+	EXPECT_LE(regions.size(), 32);
+
+	// Everything added must still be covered
+	auto min_x = 1024;
+	auto min_y = 768;
+	auto max_x = 0;
+	auto max_y = 0;
+	for (const auto& r : regions) {
+		min_x = std::min(min_x, r.x);
+		min_y = std::min(min_y, r.y);
+		max_x = std::max(max_x, r.x + r.width);
+		max_y = std::max(max_y, r.y + r.height);
+	}
+	EXPECT_EQ(min_x, 0);
+	EXPECT_EQ(min_y, 0);
+	EXPECT_EQ(max_x, 400);
+	EXPECT_EQ(max_y, 200);
+}
+
+TEST(DirtyRegions, AddAllFromOther)
+{
+	DirtyRegions frame = {};
+	frame.Resize(320, 200);
+
+	DirtyRegions upload = {};
+	upload.Resize(320, 200);
+	upload.Clear();
+
+	upload.Add(frame);
+	EXPECT_TRUE(upload.IsAll());
+
+	upload.Clear();
+	frame.Clear();
+	frame.Add(DirtyRegion{0, 0, 8, 8});
+	upload.Add(frame);
+	ASSERT_EQ(upload.GetRegions().size(), 1);
+}
+
+} // namespace
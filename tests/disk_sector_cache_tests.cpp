@@ -0,0 +1,192 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "ints/private/disk_sector_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <system_error>
+#include <vector>
+
+#include "misc/std_filesystem.h"
+
+namespace {
+
+constexpr uint32_t SectorSize = 512;
+constexpr uint32_t NumSectors = 1024;
+
+class DiskSectorCacheTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		file = tmpfile();
+		ASSERT_NE(file, nullptr);
+
+		for (uint32_t sectnum = 0; sectnum < NumSectors; ++sectnum) {
+			const auto sector = make_sector(sectnum, 0);
+			fwrite(sector.data(), 1, sector.size(), file);
+		}
+		fflush(file);
+	}
+
+	void TearDown() override
+	{
+		fclose(file);
+	}
+
+	static std::vector<uint8_t> make_sector(const uint32_t sectnum,
+	                                        const uint8_t generation)
+	{
+		std::vector<uint8_t> sector(SectorSize);
+		for (size_t i = 0; i < sector.size(); ++i) {
+			sector[i] = static_cast<uint8_t>(sectnum * 7 + i + generation);
+		}
+		return sector;
+	}
+
+	std::vector<uint8_t> read_from_file(const uint32_t sectnum)
+	{
+		std::vector<uint8_t> sector(SectorSize);
+		fseek(file, static_cast<long>(sectnum * SectorSize), SEEK_SET);
+		EXPECT_EQ(fread(sector.data(), 1, sector.size(), file), SectorSize);
+		return sector;
+	}
+
+	FILE* file = nullptr;
+};
+
+TEST_F(DiskSectorCacheTest, ReadsMatchTheFile)
+{
+	DiskSectorCache cache(file, SectorSize, 64 * 1024);
+
+	std::vector<uint8_t> sector(SectorSize);
+
+	// Random-ish access pattern that wraps around the cache
+	for (uint32_t i = 0; i < NumSectors * 2; ++i) {
+		const auto sectnum = (i * 389) % NumSectors;
+		ASSERT_TRUE(cache.ReadSector(sectnum, sector.data()));
+		ASSERT_EQ(sector, make_sector(sectnum, 0)) << "sector " << sectnum;
+	}
+}
+
+TEST_F(DiskSectorCacheTest, SequentialReadsAreReadAhead)
+{
+	DiskSectorCache cache(file, SectorSize, 1024 * 1024);
+
+	std::vector<uint8_t> sector(SectorSize);
+	for (uint32_t sectnum = 0; sectnum < NumSectors; ++sectnum) {
+		ASSERT_TRUE(cache.ReadSector(sectnum, sector.data()));
+		ASSERT_EQ(sector, make_sector(sectnum, 0));
+	}
+
+	const auto& stats = cache.GetStats();
+	EXPECT_EQ(stats.sector_reads, NumSectors);
+
+	// The read-ahead grows to 16 blocks of 8 sectors per file read
+	EXPECT_LT(stats.file_reads, 16);
+	EXPECT_GT(cache.GetHitRatePercent(), 95.0f);
+
+	// Sectors past the end of the file read as zeros
+	ASSERT_TRUE(cache.ReadSector(NumSectors + 100, sector.data()));
+	EXPECT_EQ(sector, std::vector<uint8_t>(SectorSize, 0));
+}
+
+TEST_F(DiskSectorCacheTest, WritesAreCoalescedOnFlush)
+{
+	DiskSectorCache cache(file, SectorSize, 1024 * 1024);
+
+	// Two runs of consecutive sectors across block boundaries
+	for (uint32_t sectnum = 5; sectnum < 40; ++sectnum) {
+		cache.WriteSector(sectnum, make_sector(sectnum, 1).data());
+	}
+	for (uint32_t sectnum = 100; sectnum < 103; ++sectnum) {
+		cache.WriteSector(sectnum, make_sector(sectnum, 1).data());
+	}
+
+	// Nothing has been written yet
+	EXPECT_EQ(read_from_file(5), make_sector(5, 0));
+
+	// Reading a written sector, and an unwritten sector of the same
+	// block, returns the right data
+	std::vector<uint8_t> sector(SectorSize);
+	ASSERT_TRUE(cache.ReadSector(5, sector.data()));
+	EXPECT_EQ(sector, make_sector(5, 1));
+	ASSERT_TRUE(cache.ReadSector(4, sector.data()));
+	EXPECT_EQ(sector, make_sector(4, 0));
+
+	ASSERT_TRUE(cache.Flush());
+	EXPECT_EQ(cache.GetStats().file_writes, 2);
+
+	for (uint32_t sectnum = 0; sectnum < 110; ++sectnum) {
+		const auto written = (sectnum >= 5 && sectnum < 40) ||
+		                     (sectnum >= 100 && sectnum < 103);
+		EXPECT_EQ(read_from_file(sectnum), make_sector(sectnum, written ? 1 : 0))
+		        << "sector " << sectnum;
+	}
+
+	// Flushing again has nothing to write
+	ASSERT_TRUE(cache.Flush());
+	EXPECT_EQ(cache.GetStats().file_writes, 2);
+}
+
+TEST_F(DiskSectorCacheTest, EvictionAndDestructionWriteBack)
+{
+	{
+		// The minimum size of 32 blocks
+		DiskSectorCache cache(file, SectorSize, 0);
+
+		for (uint32_t sectnum = 0; sectnum < NumSectors; sectnum += 3) {
+			cache.WriteSector(sectnum, make_sector(sectnum, 2).data());
+		}
+
+		// Re-reading evicted sectors returns the written data
+		std::vector<uint8_t> sector(SectorSize);
+		for (uint32_t sectnum = 0; sectnum < NumSectors; ++sectnum) {
+			ASSERT_TRUE(cache.ReadSector(sectnum, sector.data()));
+			ASSERT_EQ(sector, make_sector(sectnum, (sectnum % 3 == 0) ? 2 : 0));
+		}
+	}
+
+	for (uint32_t sectnum = 0; sectnum < NumSectors; ++sectnum) {
+		ASSERT_EQ(read_from_file(sectnum),
+		          make_sector(sectnum, (sectnum % 3 == 0) ? 2 : 0));
+	}
+}
+
+TEST_F(DiskSectorCacheTest, WriteBackFailuresAreReported)
+{
+	const auto path = std_fs::temp_directory_path() /
+	                  "dosbox_disk_sector_cache_tests.img";
+	{
+		std::vector<uint8_t> image(SectorSize * NumSectors);
+		const auto image_file = fopen(path.string().c_str(), "wb");
+		ASSERT_NE(image_file, nullptr);
+		fwrite(image.data(), 1, image.size(), image_file);
+		fclose(image_file);
+	}
+
+	// Writing back to a file opened for reading fails
+	const auto read_only_file = fopen(path.string().c_str(), "rb");
+	ASSERT_NE(read_only_file, nullptr);
+	{
+		DiskSectorCache cache(read_only_file, SectorSize, 0);
+
+		// Writing more sectors than the cache holds evicts modified
+		// blocks, and the failure is reported by the next write
+		auto has_failed = false;
+		for (uint32_t sectnum = 0; sectnum < NumSectors; ++sectnum) {
+			const auto sector = make_sector(sectnum, 1);
+			has_failed |= !cache.WriteSector(sectnum, sector.data());
+		}
+		EXPECT_TRUE(has_failed);
+
+		EXPECT_FALSE(cache.Flush());
+	}
+	fclose(read_only_file);
+
+	std::error_code ec = {};
+	std_fs::remove(path, ec);
+}
+
+} // namespace
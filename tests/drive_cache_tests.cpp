@@ -0,0 +1,182 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "dos/dos_system.h"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "misc/cross.h"
+#include "misc/std_filesystem.h"
+
+namespace {
+
+class DriveCacheTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		dir = std_fs::temp_directory_path() / "dosbox_drive_cache_tests";
+
+		std::error_code ec = {};
+		std_fs::remove_all(dir, ec);
+		ASSERT_TRUE(std_fs::create_directory(dir, ec));
+
+		base_dir = dir.string() + CROSS_FILESPLIT;
+	}
+
+	void TearDown() override
+	{
+		std::error_code ec = {};
+		std_fs::remove_all(dir, ec);
+	}
+
+	void create_file(const std::string& name)
+	{
+		std::ofstream(dir / name).put('x');
+	}
+
+	std::string get_short_name(DOS_Drive_Cache& cache, const std::string& name)
+	{
+		char short_name[DOS_NAMELENGTH_ASCII] = {};
+		EXPECT_TRUE(cache.GetShortName((base_dir + name).c_str(), short_name))
+		        << name;
+		return short_name;
+	}
+
+	std_fs::path dir     = {};
+	std::string base_dir = {};
+};
+
+TEST_F(DriveCacheTest, ShortNamesAreNumbered)
+{
+	create_file("LongFileName.txt");
+	create_file("LongFileName2.txt");
+	create_file("short.txt");
+
+	DOS_Drive_Cache cache(base_dir.c_str());
+
+	EXPECT_EQ(get_short_name(cache, "short.txt"), "SHORT.TXT");
+
+	const std::set<std::string> short_names = {
+	        get_short_name(cache, "LongFileName.txt"),
+	        get_short_name(cache, "LongFileName2.txt"),
+	};
+	EXPECT_EQ(short_names, (std::set<std::string>{"LONGFI~1.TXT", "LONGFI~2.TXT"}));
+}
+
+TEST_F(DriveCacheTest, ShortNamesAreUnique)
+{
+	// Host files named like generated short names take their numbers,
+	// and names sharing fewer characters compete for the short prefixes
+	// of the two-digit numbers
+	std::vector<std::string> names = {"LONGFI~3.TXT", "LONGF~12.TXT"};
+	for (auto i = 0; i < 150; ++i) {
+		names.push_back("Long File Name " + std::to_string(i) + ".txt");
+		names.push_back("LongF Other " + std::to_string(i) + ".txt");
+	}
+	for (const auto& name : names) {
+		create_file(name);
+	}
+
+	DOS_Drive_Cache cache(base_dir.c_str());
+
+	std::set<std::string> short_names = {};
+	for (const auto& name : names) {
+		const auto short_name = get_short_name(cache, name);
+		EXPECT_TRUE(short_names.insert(short_name).second) << short_name;
+
+		// The short name leads back to the host file
+		EXPECT_EQ(cache.GetExpandNameAndNormaliseCase(
+		                  (base_dir + short_name).c_str()),
+		          base_dir + name);
+	}
+}
+
+TEST_F(DriveCacheTest, AddedEntriesAreFound)
+{
+	create_file("LongFileName.txt");
+
+	DOS_Drive_Cache cache(base_dir.c_str());
+	EXPECT_EQ(get_short_name(cache, "LongFileName.txt"), "LONGFI~1.TXT");
+
+	create_file("LongFileName2.txt");
+	cache.AddEntry((base_dir + "LongFileName2.txt").c_str(), true);
+
+	EXPECT_EQ(get_short_name(cache, "LongFileName2.txt"), "LONGFI~2.TXT");
+	EXPECT_EQ(cache.GetExpandNameAndNormaliseCase(
+	                  (base_dir + "LONGFI~2.TXT").c_str()),
+	          base_dir + "LongFileName2.txt");
+
+	// Adding an existing entry again is a no-op
+	cache.AddEntry((base_dir + "LongFileName2.txt").c_str(), true);
+	EXPECT_EQ(get_short_name(cache, "LongFileName2.txt"), "LONGFI~2.TXT");
+}
+
+TEST_F(DriveCacheTest, HostChangesAreApplied)
+{
+	create_file("LongFileName.txt");
+	std_fs::create_directory(dir / "Sub Directory");
+	create_file("Sub Directory/Inner Long Name.txt");
+
+	DOS_Drive_Cache cache(base_dir.c_str());
+	EXPECT_EQ(get_short_name(cache, "LongFileName.txt"), "LONGFI~1.TXT");
+
+	create_file("LongFileName2.txt");
+	cache.AddHostEntry((base_dir + "LongFileName2.txt").c_str(), false);
+	EXPECT_EQ(get_short_name(cache, "LongFileName2.txt"), "LONGFI~2.TXT");
+
+	// Renaming is a removal and an addition
+	std_fs::rename(dir / "LongFileName.txt", dir / "Renamed File.txt");
+	cache.RemoveHostEntry((base_dir + "LongFileName.txt").c_str());
+	cache.AddHostEntry((base_dir + "Renamed File.txt").c_str(), false);
+
+	char short_name[DOS_NAMELENGTH_ASCII] = {};
+	EXPECT_FALSE(cache.GetShortName((base_dir + "LongFileName.txt").c_str(),
+	                                short_name));
+	EXPECT_EQ(get_short_name(cache, "Renamed File.txt"), "RENAME~1.TXT");
+	EXPECT_EQ(cache.GetExpandNameAndNormaliseCase(
+	                  (base_dir + "RENAME~1.TXT").c_str()),
+	          base_dir + "Renamed File.txt");
+
+	// Removing a directory removes the entries below it, which were read
+	// when looking up the directory
+	const auto sub_dir = cache.GetExpandNameAndNormaliseCase(
+	        (base_dir + "SUBDIR~1").c_str());
+	EXPECT_EQ(sub_dir, base_dir + "Sub Directory");
+
+	cache.RemoveHostEntry((base_dir + "Sub Directory").c_str());
+	EXPECT_FALSE(cache.GetShortName((base_dir + "Sub Directory").c_str(),
+	                                short_name));
+}
+
+TEST_F(DriveCacheTest, ReAddedEntriesKeepTheirShortNames)
+{
+	create_file("LongFileName.txt");
+	create_file("LongFileName2.txt");
+
+	DOS_Drive_Cache cache(base_dir.c_str());
+	const auto short_name = get_short_name(cache, "LongFileName.txt");
+	const auto other_name = get_short_name(cache, "LongFileName2.txt");
+
+	// Removing an entry frees its number for the next name with the same
+	// prefix, which is usually the same entry being re-created
+	std_fs::remove(dir / "LongFileName.txt");
+	cache.RemoveHostEntry((base_dir + "LongFileName.txt").c_str());
+
+	create_file("LongFileName.txt");
+	cache.AddHostEntry((base_dir + "LongFileName.txt").c_str(), false);
+
+	EXPECT_EQ(get_short_name(cache, "LongFileName.txt"), short_name);
+	EXPECT_EQ(get_short_name(cache, "LongFileName2.txt"), other_name);
+
+	// Once the freed number is taken again, new names get new numbers
+	create_file("LongFileName3.txt");
+	cache.AddHostEntry((base_dir + "LongFileName3.txt").c_str(), false);
+	EXPECT_EQ(get_short_name(cache, "LongFileName3.txt"), "LONGFI~3.TXT");
+}
+
+} // namespace
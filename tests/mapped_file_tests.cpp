@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "utils/mapped_file.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+std::vector<uint8_t> make_contents(const size_t size)
+{
+	std::vector<uint8_t> contents(size);
+	for (size_t i = 0; i < contents.size(); ++i) {
+		contents[i] = static_cast<uint8_t>(i * 13);
+	}
+	return contents;
+}
+
+TEST(MappedFile, MapsTheFileContents)
+{
+	const auto contents = make_contents(10000);
+
+	auto file = tmpfile();
+	ASSERT_NE(file, nullptr);
+	fwrite(contents.data(), 1, contents.size(), file);
+
+	// Unflushed writes are part of the mapping
+	const auto mapping = MappedFile::Map(file);
+	ASSERT_NE(mapping, nullptr);
+
+	const auto data = mapping->GetData();
+	EXPECT_EQ(std::vector<uint8_t>(data.begin(), data.end()), contents);
+
+	fclose(file);
+
+	// The mapping stays valid after closing the file
+	EXPECT_EQ(mapping->GetData()[9999], contents[9999]);
+}
+
+TEST(MappedFile, WritesGoThroughToTheFile)
+{
+	const auto contents = make_contents(4096);
+
+	auto file = tmpfile();
+	ASSERT_NE(file, nullptr);
+	fwrite(contents.data(), 1, contents.size(), file);
+
+	const auto mapping = MappedFile::Map(file);
+	ASSERT_NE(mapping, nullptr);
+	ASSERT_TRUE(mapping->IsWritable());
+
+	mapping->GetWritableData()[100] = 0xab;
+	mapping->Flush();
+
+	uint8_t byte = 0;
+	fseek(file, 100, SEEK_SET);
+	ASSERT_EQ(fread(&byte, 1, 1, file), 1u);
+	EXPECT_EQ(byte, 0xab);
+
+	fclose(file);
+}
+
+TEST(MappedFile, EmptyFilesAreNotMapped)
+{
+	auto file = tmpfile();
+	ASSERT_NE(file, nullptr);
+
+	EXPECT_EQ(MappedFile::Map(file), nullptr);
+
+	fclose(file);
+
+	EXPECT_EQ(MappedFile::Map(std_fs::path("non-existent-file.img")), nullptr);
+}
+
+} // namespace
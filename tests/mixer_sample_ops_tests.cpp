@@ -0,0 +1,151 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "audio/private/sample_ops.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+// The formula used to populate the mixer's 8-bit to 16-bit lookup table
+float reference_u8_to_float(const int u_val)
+{
+	const auto s_val = u_val - 128;
+	if (s_val > 0) {
+		constexpr auto Scalar = INT16_MAX / 127.0;
+		return static_cast<float>(std::round(s_val * Scalar));
+	}
+	return static_cast<float>(s_val * 256);
+}
+
+// Odd sizes exercise the scalar tails
+std::vector<AudioFrame> make_frames(const size_t num_frames)
+{
+	std::vector<AudioFrame> frames(num_frames);
+	for (size_t i = 0; i < num_frames; ++i) {
+		frames[i] = {static_cast<float>(i) * 3.0f - 100.0f,
+		             static_cast<float>(i) * -7.0f + 50.0f};
+	}
+	return frames;
+}
+
+TEST(MixerSampleOps, U8MatchesReference)
+{
+	std::vector<uint8_t> src(256 + 7);
+	for (size_t i = 0; i < src.size(); ++i) {
+		src[i] = static_cast<uint8_t>(i);
+	}
+	std::vector<float> dest(src.size());
+
+	convert_u8_to_float(src.data(), dest.data(), src.size());
+
+	for (size_t i = 0; i < src.size(); ++i) {
+		ASSERT_EQ(dest[i], reference_u8_to_float(src[i])) << "sample " << i;
+	}
+	EXPECT_EQ(dest[0], -32768.0f);
+	EXPECT_EQ(dest[255], 32767.0f);
+}
+
+TEST(MixerSampleOps, S16MatchesReference)
+{
+	std::vector<int16_t> src = {INT16_MIN, -1, 0, 1, INT16_MAX, 1234, -4321,
+	                            256, -256, 42, 7};
+	std::vector<float> dest(src.size());
+
+	convert_s16_to_float(src.data(), dest.data(), src.size());
+	for (size_t i = 0; i < src.size(); ++i) {
+		EXPECT_EQ(dest[i], static_cast<float>(src[i]));
+	}
+
+	std::vector<int16_t> swapped(src.size());
+	for (size_t i = 0; i < src.size(); ++i) {
+		const auto v = static_cast<uint16_t>(src[i]);
+		swapped[i]   = static_cast<int16_t>((v << 8) | (v >> 8));
+	}
+
+	convert_s16_byteswapped_to_float(swapped.data(), dest.data(), swapped.size());
+	for (size_t i = 0; i < src.size(); ++i) {
+		EXPECT_EQ(dest[i], static_cast<float>(src[i]));
+	}
+}
+
+TEST(MixerSampleOps, InterleaveMono)
+{
+	const std::vector<float> src = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f};
+	std::vector<AudioFrame> dest(src.size());
+
+	interleave_mono(src.data(), dest.data(), src.size(), 0.5f);
+
+	for (size_t i = 0; i < src.size(); ++i) {
+		EXPECT_EQ(dest[i], AudioFrame(src[i], 0.5f));
+	}
+}
+
+TEST(MixerSampleOps, ChannelMapAndGain)
+{
+	const auto src            = make_frames(9);
+	constexpr AudioFrame Gain = {0.5f, 2.0f};
+
+	for (size_t left_source = 0; left_source < 2; ++left_source) {
+		for (size_t right_source = 0; right_source < 2; ++right_source) {
+			auto frames = src;
+			apply_channel_map_and_gain(frames, left_source, right_source, Gain);
+
+			for (size_t i = 0; i < src.size(); ++i) {
+				const AudioFrame expected = {src[i][left_source] * Gain.left,
+				                             src[i][right_source] * Gain.right};
+				EXPECT_EQ(frames[i], expected);
+			}
+		}
+	}
+}
+
+TEST(MixerSampleOps, LineoutMap)
+{
+	const auto src = make_frames(9);
+
+	for (size_t left_dest = 0; left_dest < 2; ++left_dest) {
+		for (size_t right_dest = 0; right_dest < 2; ++right_dest) {
+			auto frames = src;
+			apply_lineout_map(frames, left_dest, right_dest);
+
+			for (size_t i = 0; i < src.size(); ++i) {
+				AudioFrame expected = {};
+				expected[left_dest] += src[i].left;
+				expected[right_dest] += src[i].right;
+				EXPECT_EQ(frames[i], expected);
+			}
+		}
+	}
+}
+
+TEST(MixerSampleOps, GainAndCrossfeed)
+{
+	const auto src = make_frames(11);
+
+	auto frames = src;
+	apply_gain(frames, {0.25f, 3.0f});
+	for (size_t i = 0; i < src.size(); ++i) {
+		EXPECT_EQ(frames[i], src[i] * AudioFrame(0.25f, 3.0f));
+	}
+
+	constexpr auto PanLeft  = 0.3f;
+	constexpr auto PanRight = 0.7f;
+
+	frames = src;
+	apply_crossfeed(frames, PanLeft, PanRight);
+	for (size_t i = 0; i < src.size(); ++i) {
+		// The compiler is free to fuse the multiply-adds in the scalar
+		// reference
+		EXPECT_FLOAT_EQ(frames[i].left,
+		                (1.0f - PanLeft) * src[i].left +
+		                        (1.0f - PanRight) * src[i].right);
+		EXPECT_FLOAT_EQ(frames[i].right,
+		                PanLeft * src[i].left + PanRight * src[i].right);
+	}
+}
+
+} // namespace
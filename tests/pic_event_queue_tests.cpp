@@ -0,0 +1,240 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "hardware/pic_event_queue.h"
+
+#include <gtest/gtest.h>
+
+#include <list>
+#include <random>
+#include <vector>
+
+namespace {
+
+void handler_a(uint32_t) {}
+void handler_b(uint32_t) {}
+void handler_c(uint32_t) {}
+
+constexpr PIC_EventHandler Handlers[] = {handler_a, handler_b, handler_c};
+
+// Model of the sorted singly-linked list the PIC used to keep its events in:
+// new events go after all the events with the same or an earlier index.
+class ReferenceQueue {
+public:
+	explicit ReferenceQueue(const size_t capacity) : capacity(capacity) {}
+
+	bool Add(const PIC_EventHandler handler, const double index,
+	         const uint32_t value)
+	{
+		if (events.size() >= capacity) {
+			return false;
+		}
+		auto it = events.begin();
+		while (it != events.end() && it->index <= index) {
+			++it;
+		}
+		events.insert(it, {index, handler, value});
+		return true;
+	}
+
+	PicEventQueue::Event Pop()
+	{
+		const auto event = events.front();
+		events.pop_front();
+		return event;
+	}
+
+	void RemoveEvents(const PIC_EventHandler handler)
+	{
+		events.remove_if([&](const auto& e) { return e.handler == handler; });
+	}
+
+	void RemoveSpecificEvents(const PIC_EventHandler handler, const uint32_t value)
+	{
+		events.remove_if([&](const auto& e) {
+			return e.handler == handler && e.value == value;
+		});
+	}
+
+	void ShiftIndices(const double amount)
+	{
+		for (auto& e : events) {
+			e.index -= amount;
+		}
+	}
+
+	size_t Size() const
+	{
+		return events.size();
+	}
+
+private:
+	size_t capacity = 0;
+	std::list<PicEventQueue::Event> events = {};
+};
+
+void expect_same_event(const PicEventQueue::Event& actual,
+                       const PicEventQueue::Event& expected)
+{
+	EXPECT_EQ(actual.index, expected.index);
+	EXPECT_EQ(actual.handler, expected.handler);
+	EXPECT_EQ(actual.value, expected.value);
+}
+
+TEST(PicEventQueue, PopsInIndexOrder)
+{
+	PicEventQueue queue(16);
+
+	EXPECT_TRUE(queue.Add(handler_a, 3.0, 3));
+	EXPECT_TRUE(queue.Add(handler_a, 1.0, 1));
+	EXPECT_TRUE(queue.Add(handler_b, 2.0, 2));
+	EXPECT_TRUE(queue.Add(handler_c, 0.5, 0));
+
+	EXPECT_EQ(queue.Size(), 4);
+
+	for (uint32_t expected = 0; expected < 4; ++expected) {
+		ASSERT_FALSE(queue.IsEmpty());
+		EXPECT_EQ(queue.Pop().value, expected);
+	}
+	EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(PicEventQueue, EqualIndicesAreFifo)
+{
+	PicEventQueue queue(16);
+
+	for (uint32_t i = 0; i < 10; ++i) {
+		EXPECT_TRUE(queue.Add(Handlers[i % 3], 1.0, i));
+	}
+	EXPECT_TRUE(queue.Add(handler_a, 0.5, 100));
+
+	EXPECT_EQ(queue.Pop().value, 100);
+	for (uint32_t i = 0; i < 10; ++i) {
+		EXPECT_EQ(queue.Pop().value, i);
+	}
+}
+
+TEST(PicEventQueue, FullQueueRejectsEvents)
+{
+	PicEventQueue queue(4);
+
+	for (auto i = 0; i < 4; ++i) {
+		EXPECT_TRUE(queue.Add(handler_a, i, 0));
+	}
+	EXPECT_FALSE(queue.Add(handler_a, 0.0, 0));
+	EXPECT_EQ(queue.GetStats().num_dropped, 1);
+
+	queue.Pop();
+	EXPECT_TRUE(queue.Add(handler_a, 0.0, 0));
+	EXPECT_EQ(queue.GetStats().max_depth, 4);
+}
+
+TEST(PicEventQueue, RemoveEvents)
+{
+	PicEventQueue queue(16);
+
+	queue.Add(handler_a, 1.0, 1);
+	queue.Add(handler_b, 2.0, 2);
+	queue.Add(handler_a, 3.0, 3);
+	queue.Add(handler_c, 4.0, 4);
+	queue.Add(handler_a, 5.0, 5);
+
+	queue.RemoveEvents(handler_a);
+	EXPECT_EQ(queue.Size(), 2);
+	EXPECT_EQ(queue.Pop().value, 2);
+	EXPECT_EQ(queue.Pop().value, 4);
+
+	// Removing a handler without events is a no-op
+	queue.RemoveEvents(handler_b);
+	EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(PicEventQueue, RemoveSpecificEvents)
+{
+	PicEventQueue queue(16);
+
+	queue.Add(handler_a, 1.0, 7);
+	queue.Add(handler_a, 2.0, 8);
+	queue.Add(handler_b, 3.0, 7);
+	queue.Add(handler_a, 4.0, 7);
+
+	queue.RemoveSpecificEvents(handler_a, 7);
+	ASSERT_EQ(queue.Size(), 2);
+
+	auto event = queue.Pop();
+	EXPECT_EQ(event.handler, handler_a);
+	EXPECT_EQ(event.value, 8);
+
+	event = queue.Pop();
+	EXPECT_EQ(event.handler, handler_b);
+	EXPECT_EQ(event.value, 7);
+}
+
+TEST(PicEventQueue, ShiftIndices)
+{
+	PicEventQueue queue(16);
+
+	queue.Add(handler_a, 1.5, 1);
+	queue.Add(handler_b, 0.25, 0);
+	queue.ShiftIndices(1.0);
+
+	EXPECT_EQ(queue.Top().index, -0.75);
+	EXPECT_EQ(queue.Pop().value, 0);
+	EXPECT_EQ(queue.Top().index, 0.5);
+}
+
+// Runs a long random mix of operations against both the queue and the model
+// of the old linked list, and checks that they always agree.
+TEST(PicEventQueue, MatchesLinkedListOrdering)
+{
+	constexpr size_t Capacity = 64;
+
+	PicEventQueue queue(Capacity);
+	ReferenceQueue reference(Capacity);
+
+	std::mt19937 rng(12345);
+	std::uniform_int_distribution<int> operation(0, 99);
+	std::uniform_int_distribution<int> handler(0, 2);
+	std::uniform_int_distribution<uint32_t> value(0, 3);
+
+	// Coarse indices so that plenty of events share the same index
+	std::uniform_int_distribution<int> index_eighths(0, 24);
+
+	for (auto step = 0; step < 20000; ++step) {
+		const auto op = operation(rng);
+
+		if (op < 55) {
+			const auto h     = Handlers[handler(rng)];
+			const auto index = index_eighths(rng) / 8.0;
+			const auto v     = value(rng);
+			ASSERT_EQ(queue.Add(h, index, v), reference.Add(h, index, v));
+
+		} else if (op < 85) {
+			if (reference.Size() > 0) {
+				expect_same_event(queue.Pop(), reference.Pop());
+			}
+		} else if (op < 90) {
+			const auto h = Handlers[handler(rng)];
+			queue.RemoveEvents(h);
+			reference.RemoveEvents(h);
+
+		} else if (op < 97) {
+			const auto h = Handlers[handler(rng)];
+			const auto v = value(rng);
+			queue.RemoveSpecificEvents(h, v);
+			reference.RemoveSpecificEvents(h, v);
+
+		} else {
+			queue.ShiftIndices(1.0);
+			reference.ShiftIndices(1.0);
+		}
+		ASSERT_EQ(queue.Size(), reference.Size());
+	}
+
+	while (reference.Size() > 0) {
+		expect_same_event(queue.Pop(), reference.Pop());
+	}
+	EXPECT_TRUE(queue.IsEmpty());
+}
+
+} // namespace
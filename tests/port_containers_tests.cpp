@@ -122,6 +122,40 @@ TEST(port_containers, empty_writes)
 	write_byte_to_port(unregistered, 0);
 }
 
+TEST(port_containers, fast_ports_follow_registration)
+{
+	// Ports below 0x400 are dispatched through the flat table, which has to
+	// track lambdas as well as plain functions across re-registration and
+	// removal
+	constexpr io_port_t port = 0x3da;
+
+	IO_RegisterReadHandler(port, read_byte_new, io_width_t::byte);
+	byte_val_new = 0x42;
+	EXPECT_EQ(read_byte_from_port(port), 0x42);
+
+	auto num_calls = 0;
+	IO_RegisterReadHandler(
+	        port,
+	        [&](io_port_t, io_width_t) {
+		        ++num_calls;
+		        return io_val_t{0x5a5a};
+	        },
+	        io_width_t::word);
+
+	EXPECT_EQ(read_word_from_port(port), 0x5a5a);
+	EXPECT_EQ(read_byte_from_port(port), 0x5a);
+	EXPECT_EQ(num_calls, 2);
+
+	IO_FreeReadHandler(port, io_width_t::word);
+	EXPECT_EQ(read_byte_from_port(port), 0xff);
+	EXPECT_EQ(num_calls, 2);
+
+	IO_RegisterWriteHandler(port, write_word_new, io_width_t::word);
+	write_word_to_port(port, 0x1234);
+	EXPECT_EQ(word_val_new, 0x1234);
+	IO_FreeWriteHandler(port, io_width_t::word);
+}
+
 // The following tests are temporarily disabled as they
 // are currently failing on all platforms.
 // Investigations have revealed the test cases rely on 
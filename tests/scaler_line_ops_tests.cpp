@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gui/render/scaler/line_ops.h"
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <vector>
+
+namespace {
+
+// The PMAKE macros the scalers used before the conversions were vectorised
+uint32_t reference_rgb555(const uint32_t v)
+{
+	return ((v & (31 << 10)) << 9) | ((v & (31 << 5)) << 6) |
+	       ((v & 31) << 3) | ((v & (7 << 12)) << 4) |
+	       ((v & (7 << 7)) << 1) | ((v & (7 << 2)) >> 2);
+}
+
+uint32_t reference_rgb565(const uint32_t v)
+{
+	return ((v & (31 << 11)) << 8) | ((v & (63 << 5)) << 5) |
+	       ((v & 0xE01F) << 3) | ((v & (3 << 9)) >> 1) | ((v & (7 << 2)) >> 2);
+}
+
+std::vector<uint16_t> all_16bit_values()
+{
+	std::vector<uint16_t> values(65536);
+	std::iota(values.begin(), values.end(), uint16_t{0});
+	return values;
+}
+
+TEST(ScalerLineOps, FindFirstChangedByte)
+{
+	constexpr size_t Size = 200;
+
+	const std::vector<uint8_t> a(Size, 0x55);
+
+	EXPECT_EQ(find_first_changed_byte(a.data(), a.data(), Size), Size);
+	EXPECT_EQ(find_first_changed_byte(a.data(), a.data(), 0), 0);
+
+	for (size_t pos = 0; pos < Size; ++pos) {
+		auto b = a;
+		b[pos] = 0xaa;
+
+		// Also change a later byte to make sure we get the first one
+		if (pos + 7 < Size) {
+			b[pos + 7] = 0xaa;
+		}
+		EXPECT_EQ(find_first_changed_byte(a.data(), b.data(), Size), pos);
+
+		// Differences past the end don't count
+		EXPECT_EQ(find_first_changed_byte(a.data(), b.data(), pos), pos);
+	}
+}
+
+TEST(ScalerLineOps, Rgb555MatchesReference)
+{
+	const auto src = all_16bit_values();
+	std::vector<uint32_t> dest(src.size());
+
+	convert_rgb555_to_bgrx(src.data(), dest.data(), static_cast<int>(src.size()));
+
+	for (size_t i = 0; i < src.size(); ++i) {
+		ASSERT_EQ(dest[i], reference_rgb555(src[i])) << "pixel " << i;
+	}
+}
+
+TEST(ScalerLineOps, Rgb565MatchesReference)
+{
+	const auto src = all_16bit_values();
+	std::vector<uint32_t> dest(src.size());
+
+	convert_rgb565_to_bgrx(src.data(), dest.data(), static_cast<int>(src.size()));
+
+	for (size_t i = 0; i < src.size(); ++i) {
+		ASSERT_EQ(dest[i], reference_rgb565(src[i])) << "pixel " << i;
+	}
+}
+
+TEST(ScalerLineOps, Bgr24MatchesReference)
+{
+	// Odd lengths exercise the scalar tail
+	for (const auto num_pixels : {1, 5, 6, 7, 32, 37}) {
+		std::vector<uint8_t> src(num_pixels * 3);
+		for (size_t i = 0; i < src.size(); ++i) {
+			src[i] = static_cast<uint8_t>(i * 37 + 11);
+		}
+
+		// The canary catches writes past the end
+		std::vector<uint32_t> dest(num_pixels + 1, 0xdeadbeef);
+		convert_bgr24_to_bgrx(src.data(), dest.data(), num_pixels);
+
+		for (auto i = 0; i < num_pixels; ++i) {
+			const auto expected = static_cast<uint32_t>(
+			        src[i * 3] | (src[i * 3 + 1] << 8) |
+			        (src[i * 3 + 2] << 16));
+			EXPECT_EQ(dest[i], expected);
+		}
+		EXPECT_EQ(dest[num_pixels], 0xdeadbeef);
+	}
+}
+
+TEST(ScalerLineOps, IndexedUsesPalette)
+{
+	uint32_t lut[256] = {};
+	for (uint32_t i = 0; i < 256; ++i) {
+		lut[i] = i * 0x010203;
+	}
+
+	std::vector<uint8_t> src(320);
+	for (size_t i = 0; i < src.size(); ++i) {
+		src[i] = static_cast<uint8_t>(i * 7);
+	}
+	std::vector<uint32_t> dest(src.size());
+
+	convert_indexed_to_bgrx(src.data(), lut, dest.data(), static_cast<int>(src.size()));
+
+	for (size_t i = 0; i < src.size(); ++i) {
+		EXPECT_EQ(dest[i], lut[src[i]]);
+	}
+}
+
+} // namespace
@@ -0,0 +1,257 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "utils/spsc_queue.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+constexpr auto iterations = 10000;
+
+TEST(SpscQueue, TrivialSerial)
+{
+	// The capacity isn't a power of two, so the ring has unused slots
+	SpscQueue<int> q(65);
+	for (int iteration = 0; iteration != 128; ++iteration) {
+		EXPECT_EQ(q.MaxCapacity(), 65);
+		EXPECT_EQ(q.Size(), 0);
+		EXPECT_TRUE(q.IsEmpty());
+
+		for (int i = 0; i != 65; ++i) {
+			EXPECT_TRUE(q.NonblockingEnqueue(std::move(i)));
+		}
+		EXPECT_EQ(q.Size(), 65);
+		EXPECT_TRUE(q.IsFull());
+		EXPECT_FLOAT_EQ(q.GetPercentFull(), 100.0f);
+
+		auto extra = 65;
+		EXPECT_FALSE(q.NonblockingEnqueue(std::move(extra)));
+
+		for (int i = 0; i != 65; ++i) {
+			EXPECT_EQ(*q.Dequeue(), i);
+		}
+		EXPECT_TRUE(q.IsEmpty());
+	}
+}
+
+TEST(SpscQueue, TrivialZeroCapacity)
+{
+	EXPECT_DEBUG_DEATH({ SpscQueue<int> q(0); }, "");
+}
+
+TEST(SpscQueue, NonblockingBulkEnqueue)
+{
+	SpscQueue<int> q(5);
+
+	std::vector<int> items = {0, 1, 2, 3, 4, 5, 6, 7};
+	EXPECT_EQ(q.NonblockingBulkEnqueue(items), 5);
+
+	// The items that didn't fit stay in the source
+	EXPECT_EQ(items, std::vector<int>({5, 6, 7}));
+	EXPECT_EQ(q.NonblockingBulkEnqueue(items), 0);
+
+	std::vector<int> out = {};
+	EXPECT_EQ(q.BulkDequeue(out, 3), 3);
+	EXPECT_EQ(out, std::vector<int>({0, 1, 2}));
+
+	// Wraps around the end of the ring
+	EXPECT_EQ(q.NonblockingBulkEnqueue(items), 3);
+	EXPECT_TRUE(items.empty());
+
+	EXPECT_EQ(q.BulkDequeue(out, 5), 5);
+	EXPECT_EQ(out, std::vector<int>({3, 4, 5, 6, 7}));
+}
+
+TEST(SpscQueue, StopDrainsAndUnblocks)
+{
+	SpscQueue<int> q(4);
+
+	std::vector<int> items = {1, 2, 3};
+	q.BulkEnqueue(items);
+	q.Stop();
+
+	EXPECT_FALSE(q.IsRunning());
+
+	auto item = 4;
+	EXPECT_FALSE(q.Enqueue(std::move(item)));
+
+	// The queued items can still be dequeued after stopping
+	std::vector<int> out = {};
+	EXPECT_EQ(q.BulkDequeue(out, 10), 3);
+	EXPECT_EQ(out, std::vector<int>({1, 2, 3}));
+	EXPECT_FALSE(q.Dequeue().has_value());
+
+	q.Start();
+	EXPECT_TRUE(q.Enqueue(std::move(item)));
+	EXPECT_EQ(*q.Dequeue(), 4);
+}
+
+TEST(SpscQueue, StopWakesBlockedConsumer)
+{
+	SpscQueue<int> q(4);
+
+	std::thread reader([&q] {
+		std::vector<int> out = {};
+		EXPECT_EQ(q.BulkDequeue(out, 4), 0);
+	});
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	q.Stop();
+	reader.join();
+}
+
+TEST(SpscQueue, StopWakesBlockedProducer)
+{
+	SpscQueue<int> q(2);
+
+	std::thread writer([&q] {
+		std::vector<int> items = {1, 2, 3, 4};
+		EXPECT_EQ(q.BulkEnqueue(items), 2);
+	});
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	q.Stop();
+	writer.join();
+}
+
+TEST(SpscQueue, Clear)
+{
+	SpscQueue<int> q(4);
+
+	std::vector<int> items = {1, 2, 3};
+	q.BulkEnqueue(items);
+	q.Clear();
+	EXPECT_TRUE(q.IsEmpty());
+
+	items = {4, 5, 6, 7};
+	EXPECT_EQ(q.NonblockingBulkEnqueue(items), 4);
+	EXPECT_EQ(*q.Dequeue(), 4);
+}
+
+using container_t = std::vector<int16_t>;
+
+TEST(SpscQueue, ContainerMoveAsync)
+{
+	const size_t max_depth = 8;
+	SpscQueue<container_t> q(max_depth);
+
+	std::thread writer([&q] {
+		for (int i = 0; i != iterations; ++i) {
+			container_t v(static_cast<size_t>(i % 100) + 1);
+			v.back() = static_cast<int16_t>(i);
+			q.Enqueue(std::move(v));
+			EXPECT_TRUE(v.empty()); // check move
+		}
+	});
+
+	std::thread reader([&q, max_depth] {
+		for (int i = 0; i != iterations; ++i) {
+			EXPECT_LE(q.Size(), max_depth);
+			const auto v = q.Dequeue().value();
+			EXPECT_EQ(v.size(), static_cast<size_t>(i % 100) + 1);
+			EXPECT_EQ(v.back(), static_cast<int16_t>(i));
+		}
+	});
+
+	writer.join();
+	reader.join();
+
+	EXPECT_EQ(q.Size(), 0);
+}
+
+void bulk_enqueue(SpscQueue<int>& q, const size_t total_to_enqueue,
+                  const size_t num_per_bulk_enqueue)
+{
+	// Make the index and values match, for easy testing
+	auto i               = 0;
+	auto remaining_items = total_to_enqueue;
+
+	std::vector<int> items = {};
+
+	while (remaining_items > 0) {
+		const auto num_to_enqueue = std::min(remaining_items,
+		                                     num_per_bulk_enqueue);
+		for (size_t n = 0; n < num_to_enqueue; ++n) {
+			items.push_back(i++);
+		}
+		EXPECT_EQ(q.BulkEnqueue(items, num_to_enqueue), num_to_enqueue);
+		EXPECT_TRUE(items.empty());
+
+		remaining_items -= num_to_enqueue;
+	}
+}
+
+void bulk_dequeue(SpscQueue<int>& q, const size_t total_to_dequeue,
+                  const size_t num_per_bulk_dequeue)
+{
+	auto expected_val    = 0;
+	auto remaining_items = total_to_dequeue;
+
+	std::vector<int> items = {};
+
+	while (remaining_items > 0) {
+		const auto num_to_dequeue = std::min(remaining_items,
+		                                     num_per_bulk_dequeue);
+
+		EXPECT_EQ(q.BulkDequeue(items, num_to_dequeue), num_to_dequeue);
+		for (const auto item : items) {
+			EXPECT_EQ(item, expected_val++);
+		}
+		remaining_items -= num_to_dequeue;
+	}
+}
+
+using bulk_params_t = typename std::tuple<size_t, size_t, size_t, size_t>;
+
+TEST(SpscQueue, AsyncBulkIO)
+{
+	for (const auto& [queue_capacity,
+	                  num_per_bulk_enqueue,
+	                  num_per_bulk_dequeue,
+	                  total_to_queue] : {
+
+	             // singles
+	             bulk_params_t{1, 1, 1, 50},
+	             bulk_params_t{50, 1, 1, 242},
+
+	             // equal sizes
+	             bulk_params_t{10, 10, 10, 50},
+
+	             // dequeue larger than enqueue, and vice versa
+	             bulk_params_t{10, 3, 10, 50},
+	             bulk_params_t{10, 10, 3, 50},
+
+	             // requests larger than the queue
+	             bulk_params_t{3, 100, 3, 340},
+	             bulk_params_t{4, 10, 30, 97},
+
+	             // typical audio block sizes
+	             bulk_params_t{1500, 512, 256, 100000},
+
+	     }) {
+		SpscQueue<int> q(queue_capacity);
+
+		std::thread writer(bulk_enqueue,
+		                   std::ref(q),
+		                   total_to_queue,
+		                   num_per_bulk_enqueue);
+
+		std::thread reader(bulk_dequeue,
+		                   std::ref(q),
+		                   total_to_queue,
+		                   num_per_bulk_dequeue);
+
+		writer.join();
+		reader.join();
+
+		EXPECT_EQ(q.Size(), 0);
+	}
+}
+
+} // namespace
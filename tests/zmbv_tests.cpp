@@ -0,0 +1,354 @@
+// SPDX-FileCopyrightText:  2026-2026 The DOSBox Staging Team
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "capture/video/zmbv.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr int BlockSize = 16;
+constexpr int MaxVector = 16;
+
+struct EncodedVideo {
+	// The uncompressed input frames
+	std::vector<std::vector<uint8_t>> frames = {};
+
+	// The compressed frames as written by the encoder
+	std::vector<std::vector<uint8_t>> packets = {};
+};
+
+// Encodes a sequence of synthetic frames with partially scrolling and
+// partially changing content
+EncodedVideo encode_frames(const int width, const int height,
+                           const ZMBV_FORMAT format, const int num_threads)
+{
+	VideoCodec codec = {};
+	EXPECT_TRUE(codec.SetupCompress(width, height));
+	codec.SetNumSearchThreads(num_threads);
+
+	std::vector<uint8_t> out(
+	        static_cast<size_t>(codec.NeededSize(width, height, format)));
+
+	const auto bytes_per_pixel = ZMBV_ToBytesPerPixel(format);
+	const auto row_bytes = static_cast<size_t>(width) * bytes_per_pixel;
+
+	std::vector<uint8_t> background(row_bytes * 2 * height);
+	uint32_t seed = 1;
+	for (auto& byte : background) {
+		seed = seed * 1103515245 + 12345;
+		byte = static_cast<uint8_t>((seed >> 16) & 0x3f);
+	}
+
+	uint8_t palette[256 * 4] = {};
+
+	EncodedVideo video = {};
+	std::vector<uint8_t> frame(row_bytes * height);
+
+	for (auto f = 0; f < 8; ++f) {
+		for (auto y = 0; y < height; ++y) {
+			const auto scroll = (y < height / 2) ? f * 3 * bytes_per_pixel : 0;
+			std::memcpy(&frame[y * row_bytes],
+			            &background[y * row_bytes * 2 + scroll],
+			            row_bytes);
+		}
+		for (auto y = 10; y < 30; ++y) {
+			std::memset(&frame[y * row_bytes + f * 5 * bytes_per_pixel],
+			            0x41,
+			            20 * bytes_per_pixel);
+		}
+
+		const auto flags = (f == 0) ? 1 : 0;
+		EXPECT_TRUE(codec.PrepareCompressFrame(
+		        flags, format, palette, out.data(), static_cast<uint32_t>(out.size())));
+
+		for (auto y = 0; y < height; ++y) {
+			const uint8_t* row = &frame[y * row_bytes];
+			codec.CompressLines(1, &row);
+		}
+
+		const auto written = codec.FinishCompressFrame();
+		EXPECT_GT(written, 0);
+
+		video.frames.push_back(frame);
+		video.packets.emplace_back(out.begin(), out.begin() + written);
+	}
+	codec.FinishVideo();
+	return video;
+}
+
+// Inflates the payload of every compressed frame; the deflate stream is
+// restarted at each keyframe and flushed at the end of every frame
+std::vector<std::vector<uint8_t>> inflate_packets(const EncodedVideo& video,
+                                                  const size_t max_payload_size)
+{
+	constexpr uint8_t KeyframeHeaderSize = 6;
+
+	z_stream zstream = {};
+	EXPECT_EQ(inflateInit(&zstream), Z_OK);
+
+	std::vector<std::vector<uint8_t>> payloads = {};
+
+	for (const auto& packet : video.packets) {
+		const auto is_keyframe = (packet[0] & 0x01) != 0;
+		const auto header_size = is_keyframe ? 1 + KeyframeHeaderSize : 1;
+		if (is_keyframe) {
+			inflateReset(&zstream);
+		}
+
+		std::vector<uint8_t> payload(max_payload_size);
+
+		zstream.next_in   = const_cast<uint8_t*>(packet.data()) + header_size;
+		zstream.avail_in  = static_cast<uint32_t>(packet.size() - header_size);
+		zstream.next_out  = payload.data();
+		zstream.avail_out = static_cast<uint32_t>(payload.size());
+
+		const auto result = inflate(&zstream, Z_SYNC_FLUSH);
+		EXPECT_TRUE(result == Z_OK || result == Z_STREAM_END);
+		EXPECT_EQ(zstream.avail_in, 0u);
+
+		payload.resize(static_cast<size_t>(zstream.next_out - payload.data()));
+		payloads.push_back(std::move(payload));
+	}
+	inflateEnd(&zstream);
+	return payloads;
+}
+
+// Straightforward scalar implementation of the motion search and XOR block
+// encoding of the original single-threaded encoder, to check the optimised
+// encoder against
+template <class P>
+class ReferenceEncoder {
+public:
+	ReferenceEncoder(const int _width, const int _height)
+	        : width(_width),
+	          height(_height),
+	          pitch(_width + 2 * MaxVector),
+	          old_frame(static_cast<size_t>((_height + 2 * MaxVector) * pitch)),
+	          new_frame(old_frame.size())
+	{
+		vectors.push_back({0, 0});
+		for (auto s = 1; s <= 10; ++s) {
+			for (auto y = -s; y <= s; ++y) {
+				for (auto x = -s; x <= s; ++x) {
+					if (std::abs(x) == s || std::abs(y) == s) {
+						vectors.push_back({x, y});
+					}
+				}
+			}
+		}
+	}
+
+	// Returns the uncompressed delta frame payload without the padding
+	// between the block vectors and the XOR data
+	std::vector<uint8_t> EncodeDelta(const std::vector<uint8_t>& prev_frame,
+	                                 const std::vector<uint8_t>& frame)
+	{
+		CopyIn(prev_frame, old_frame);
+		CopyIn(frame, new_frame);
+
+		std::vector<uint8_t> block_vectors = {};
+		std::vector<uint8_t> xor_data      = {};
+
+		for (auto by = 0; by < height; by += BlockSize) {
+			for (auto bx = 0; bx < width; bx += BlockSize) {
+				const Block block = {(by + MaxVector) * pitch + bx + MaxVector,
+				                     std::min(BlockSize, width - bx),
+				                     std::min(BlockSize, height - by)};
+
+				auto best_vx     = 0;
+				auto best_vy     = 0;
+				auto best_change = CompareBlock(0, 0, block);
+				auto possibles   = 64;
+
+				for (size_t v = 0; v < vectors.size() && possibles; ++v) {
+					if (best_change < 4) {
+						break;
+					}
+					const auto [vx, vy] = vectors[v];
+					if (PossibleBlock(vx, vy, block) < 4) {
+						--possibles;
+						const auto change = CompareBlock(vx, vy, block);
+						if (change < best_change) {
+							best_change = change;
+							best_vx     = vx;
+							best_vy     = vy;
+						}
+					}
+				}
+
+				block_vectors.push_back(static_cast<uint8_t>(
+				        (best_vx * 2) | (best_change ? 1 : 0)));
+				block_vectors.push_back(static_cast<uint8_t>(best_vy * 2));
+
+				if (best_change) {
+					AddXorBlock(best_vx, best_vy, block, xor_data);
+				}
+			}
+		}
+
+		block_vectors.insert(block_vectors.end(), xor_data.begin(), xor_data.end());
+		return block_vectors;
+	}
+
+	size_t NumBlocks() const
+	{
+		return static_cast<size_t>(((width + BlockSize - 1) / BlockSize) *
+		                           ((height + BlockSize - 1) / BlockSize));
+	}
+
+private:
+	struct Block {
+		int start = 0;
+		int dx    = 0;
+		int dy    = 0;
+	};
+
+	void CopyIn(const std::vector<uint8_t>& frame, std::vector<P>& padded)
+	{
+		const auto row_bytes = static_cast<size_t>(width) * sizeof(P);
+		for (auto y = 0; y < height; ++y) {
+			std::memcpy(&padded[(y + MaxVector) * pitch + MaxVector],
+			            &frame[y * row_bytes],
+			            row_bytes);
+		}
+	}
+
+	int PossibleBlock(const int vx, const int vy, const Block& block) const
+	{
+		int ret = 0;
+		auto pold = &old_frame[block.start + (vy * pitch) + vx];
+		auto pnew = &new_frame[block.start];
+		for (auto y = 0; y < block.dy; y += 4) {
+			for (auto x = 0; x < block.dx; x += 4) {
+				const auto test = 0 - ((pold[x] - pnew[x]) & 0x00ffffff);
+				ret -= static_cast<int>(test >> 31);
+			}
+			pold += pitch * 4;
+			pnew += pitch * 4;
+		}
+		return ret;
+	}
+
+	int CompareBlock(const int vx, const int vy, const Block& block) const
+	{
+		int ret = 0;
+		auto pold = &old_frame[block.start + (vy * pitch) + vx];
+		auto pnew = &new_frame[block.start];
+		for (auto y = 0; y < block.dy; ++y) {
+			for (auto x = 0; x < block.dx; ++x) {
+				ret += ((pold[x] ^ pnew[x]) & 0x00ffffff) != 0;
+			}
+			pold += pitch;
+			pnew += pitch;
+		}
+		return ret;
+	}
+
+	void AddXorBlock(const int vx, const int vy, const Block& block,
+	                 std::vector<uint8_t>& out) const
+	{
+		auto pold = &old_frame[block.start + (vy * pitch) + vx];
+		auto pnew = &new_frame[block.start];
+		for (auto y = 0; y < block.dy; ++y) {
+			for (auto x = 0; x < block.dx; ++x) {
+				const P value = pnew[x] ^ pold[x];
+				const auto bytes = reinterpret_cast<const uint8_t*>(&value);
+				out.insert(out.end(), bytes, bytes + sizeof(P));
+			}
+			pold += pitch;
+			pnew += pitch;
+		}
+	}
+
+	int width  = 0;
+	int height = 0;
+	int pitch  = 0;
+
+	std::vector<P> old_frame = {};
+	std::vector<P> new_frame = {};
+
+	std::vector<std::pair<int, int>> vectors = {};
+};
+
+template <class P>
+void check_against_reference(const int width, const int height,
+                             const ZMBV_FORMAT format, const int num_threads)
+{
+	const auto video = encode_frames(width, height, format, num_threads);
+
+	const auto max_payload_size = static_cast<size_t>(
+	        VideoCodec().NeededSize(width, height, format));
+	const auto payloads = inflate_packets(video, max_payload_size);
+
+	ReferenceEncoder<P> reference(width, height);
+
+	const auto num_vector_bytes = reference.NumBlocks() * 2;
+	const auto xor_data_offset  = (num_vector_bytes + 3) & ~size_t(3);
+
+	for (size_t f = 1; f < video.frames.size(); ++f) {
+		const auto expected = reference.EncodeDelta(video.frames[f - 1],
+		                                            video.frames[f]);
+		const auto& payload = payloads[f];
+
+		ASSERT_EQ(payload.size(),
+		          expected.size() + (xor_data_offset - num_vector_bytes))
+		        << "frame " << f;
+
+		// The block vectors
+		EXPECT_TRUE(std::equal(expected.begin(),
+		                       expected.begin() + num_vector_bytes,
+		                       payload.begin()))
+		        << "frame " << f;
+
+		// The XOR data of the changed blocks
+		EXPECT_TRUE(std::equal(expected.begin() + num_vector_bytes,
+		                       expected.end(),
+		                       payload.begin() + xor_data_offset))
+		        << "frame " << f;
+	}
+}
+
+TEST(ZmbvEncoder, MatchesReferenceEncoder_8bpp)
+{
+	check_against_reference<uint8_t>(203, 117, ZMBV_FORMAT::BPP_8, 0);
+	check_against_reference<uint8_t>(203, 117, ZMBV_FORMAT::BPP_8, 3);
+}
+
+TEST(ZmbvEncoder, MatchesReferenceEncoder_16bpp)
+{
+	check_against_reference<uint16_t>(203, 117, ZMBV_FORMAT::BPP_16, 0);
+	check_against_reference<uint16_t>(203, 117, ZMBV_FORMAT::BPP_16, 3);
+}
+
+TEST(ZmbvEncoder, MatchesReferenceEncoder_32bpp)
+{
+	check_against_reference<uint32_t>(203, 117, ZMBV_FORMAT::BPP_32, 0);
+	check_against_reference<uint32_t>(203, 117, ZMBV_FORMAT::BPP_32, 3);
+}
+
+TEST(ZmbvEncoder, ParallelSearchIsByteIdentical_8bpp)
+{
+	EXPECT_EQ(encode_frames(203, 117, ZMBV_FORMAT::BPP_8, 0).packets,
+	          encode_frames(203, 117, ZMBV_FORMAT::BPP_8, 3).packets);
+}
+
+TEST(ZmbvEncoder, ParallelSearchIsByteIdentical_16bpp)
+{
+	EXPECT_EQ(encode_frames(203, 117, ZMBV_FORMAT::BPP_16, 0).packets,
+	          encode_frames(203, 117, ZMBV_FORMAT::BPP_16, 3).packets);
+}
+
+TEST(ZmbvEncoder, ParallelSearchIsByteIdentical_32bpp)
+{
+	EXPECT_EQ(encode_frames(203, 117, ZMBV_FORMAT::BPP_32, 0).packets,
+	          encode_frames(203, 117, ZMBV_FORMAT::BPP_32, 3).packets);
+}
+
+} // namespace